@@ -0,0 +1,293 @@
+#!/usr/bin/env python3
+#
+#	otawa-bench -- benchmark harness for OTAWA analyses
+#
+#	This file is part of OTAWA
+#	Copyright (c) 2026, IRIT UPS.
+#
+#	OTAWA is free software; you can redistribute it and/or modify
+#	it under the terms of the GNU General Public License as published by
+#	the Free Software Foundation; either version 2 of the License, or
+#	(at your option) any later version.
+#
+#	OTAWA is distributed in the hope that it will be useful,
+#	but WITHOUT ANY WARRANTY; without even the implied warranty of
+#	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#	GNU General Public License for more details.
+#
+#	You should have received a copy of the GNU General Public License
+#	along with OTAWA; if not, write to the Free Software
+#	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+"""Run a matrix of analysis pipelines (described in a JSON file) over
+a set of binaries and hardware configurations with operform, record for
+each run the wall time, the maximum resident memory and, for each code
+processor, the time, memory and fix-point iterations (as saved by
+--stats in proc-stats.json) and compare them against a baseline.
+
+The matrix file has the form:
+{
+	"binaries": [ "PATH", ... ],
+	"configs": { "NAME": { "IDENTIFIER": "VALUE", ... }, ... },
+	"pipelines": {
+		"NAME": { "steps": [ "require:FEATURE" | "process:PROCESSOR", ... ],
+			"binaries": [ "PATH", ... ], "configs": [ "NAME", ... ] },
+		...
+	},
+	"tolerance": { "time": RATIO, "memory": RATIO, "iterations": RATIO }
+}
+
+Paths are relative to the matrix file. "binaries" and "configs" of
+a pipeline are optional and restrict the matrix for this pipeline.
+
+When a baseline is given, it must exist unless --save-baseline is used
+to create it. The per-processor memory figures are only measured if
+OTAWA is built with OTAWA_MEM_STATS (they are -1 otherwise) and are not
+compared in this case.
+"""
+
+import argparse
+import json
+import os
+import os.path
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+VERSION = 1
+TIME_FLOOR = 1000		# time variations under 1ms are ignored
+
+def error(msg):
+	sys.stderr.write("ERROR: %s\n" % msg)
+
+def fatal(msg):
+	error(msg)
+	exit(1)
+
+def warning(msg):
+	sys.stderr.write("WARNING: %s\n" % msg)
+
+def info(msg):
+	sys.stderr.write("%s\n" % msg)
+
+
+class Run:
+	"""Result of one pipeline on one binary with one configuration."""
+
+	def __init__(self, binary, config, pipeline):
+		self.binary = binary
+		self.config = config
+		self.pipeline = pipeline
+		self.status = "ok"
+		self.wall = None
+		self.max_rss = None
+		self.phases = []
+
+	def key(self):
+		return "%s/%s/%s" % (self.binary, self.config, self.pipeline)
+
+	def to_json(self):
+		return {
+			"binary": self.binary,
+			"config": self.config,
+			"pipeline": self.pipeline,
+			"status": self.status,
+			"wall": self.wall,
+			"max_rss": self.max_rss,
+			"phases": self.phases
+		}
+
+
+def find_stats(dir):
+	"""Look for proc-stats.json in the work directory."""
+	for root, dirs, files in os.walk(dir):
+		if "proc-stats.json" in files:
+			return os.path.join(root, "proc-stats.json")
+	return None
+
+
+def run_once(args, binary, props, steps, log):
+	"""Run operform once and return (status, wall time in us, max RSS
+	in bytes, phases)."""
+	work = tempfile.mkdtemp(prefix = "otawa-bench-")
+	try:
+		cmd = [args.operform, binary, "--stats", "--work-dir", work]
+		for id, val in props.items():
+			cmd += ["--add-prop", "%s=%s" % (id, val)]
+		cmd += steps
+		if args.verbose:
+			info("running " + " ".join(cmd))
+		with open(log, "w") as out:
+			start = time.monotonic()
+			proc = subprocess.Popen(cmd, stdout = out, stderr = subprocess.STDOUT)
+			_, code, usage = os.wait4(proc.pid, 0)
+			wall = int((time.monotonic() - start) * 1000000)
+		ok = os.WIFEXITED(code) and os.WEXITSTATUS(code) == 0
+		proc.returncode = 0 if ok else 1
+		if not ok:
+			return ("failed", None, None, [])
+		path = find_stats(work)
+		phases = []
+		if path != None:
+			with open(path) as f:
+				phases = json.load(f)
+		return ("ok", wall, usage.ru_maxrss * 1024, phases)
+	finally:
+		shutil.rmtree(work, ignore_errors = True)
+
+
+def run_matrix(args, matrix, base):
+	"""Run all the pipelines of the matrix."""
+	runs = []
+	binaries = matrix.get("binaries", [])
+	configs = matrix.get("configs", { "default": { } })
+	for pname, pipe in sorted(matrix.get("pipelines", { }).items()):
+		if args.pipeline and pname not in args.pipeline:
+			continue
+		for binary in pipe.get("binaries", binaries):
+			for cname in pipe.get("configs", sorted(configs.keys())):
+				if cname not in configs:
+					fatal("unknown configuration %s in pipeline %s" % (cname, pname))
+				props = { id: os.path.join(base, val) if val.endswith(".xml") else val
+					for id, val in configs[cname].items() }
+				run = Run(os.path.basename(binary), cname, pname)
+				log = os.path.join(args.logs, "%s-%s-%s.log" % (run.binary, cname, pname))
+				for i in range(args.repeat):
+					status, wall, rss, phases = run_once(args, os.path.join(base, binary), props, pipe["steps"], log)
+					if status != "ok":
+						run.status = status
+						error("%s failed (see %s)" % (run.key(), log))
+						break
+					if run.wall == None or wall < run.wall:
+						run.wall = wall
+					run.max_rss = rss
+					if not run.phases:
+						run.phases = phases
+					else:
+						for p, q in zip(run.phases, phases):
+							p["time"] = min(p["time"], q["time"])
+				if run.status == "ok":
+					info("%s: %.1fms, %dKB" % (run.key(), run.wall / 1000., run.max_rss >> 10))
+				runs.append(run)
+	return runs
+
+
+def phase_keys(phases):
+	"""Build unique keys for the phases (a processor may run several times)."""
+	keys = { }
+	res = { }
+	for p in phases:
+		n = keys.get(p["name"], 0)
+		keys[p["name"]] = n + 1
+		res[p["name"] if n == 0 else "%s#%d" % (p["name"], n)] = p
+	return res
+
+
+def check(what, old, new, tol, floor, issues):
+	"""Check one measure against the baseline."""
+	if old == None or new == None or old < 0 or new < 0:
+		return
+	if new - old > floor and new > old * (1 + tol):
+		issues.append("%s: %s -> %s (+%.1f%%)" % (what, old, new, 100. * (new - old) / max(old, 1)))
+
+
+def compare(runs, baseline, tol):
+	"""Compare the runs with the baseline and return the list of regressions."""
+	old_runs = { "%s/%s/%s" % (r["binary"], r["config"], r["pipeline"]): r for r in baseline["runs"] }
+	issues = []
+	for run in runs:
+		old = old_runs.get(run.key())
+		if old == None:
+			info("%s: not in baseline" % run.key())
+			continue
+		if run.status != old["status"]:
+			issues.append("%s: status %s -> %s" % (run.key(), old["status"], run.status))
+			continue
+		check(run.key() + " wall time", old["wall"], run.wall, tol["time"], TIME_FLOOR, issues)
+		check(run.key() + " max RSS", old["max_rss"], run.max_rss, tol["memory"], 0, issues)
+		old_phases = phase_keys(old["phases"])
+		for k, p in phase_keys(run.phases).items():
+			q = old_phases.get(k)
+			if q == None:
+				continue
+			what = "%s %s" % (run.key(), k)
+			check(what + " time", q["time"], p["time"], tol["time"], TIME_FLOOR, issues)
+			check(what + " peak", q["peak"], p["peak"], tol["memory"], 0, issues)
+			check(what + " allocated", q["allocated"], p["allocated"], tol["memory"], 0, issues)
+			check(what + " iterations", q["iterations"], p["iterations"], tol["iterations"], 0, issues)
+	return issues
+
+
+parser = argparse.ArgumentParser(description = "Benchmark harness for OTAWA analyses")
+parser.add_argument('--matrix', '-c', default = "bench.json", help = "matrix of pipelines to run (default bench.json)")
+parser.add_argument('--output', '-o', help = "file to store the JSON results (default standard output)")
+parser.add_argument('--baseline', '-b', help = "JSON results to compare with")
+parser.add_argument('--save-baseline', action = "store_true", help = "store the results as the new baseline instead of comparing")
+parser.add_argument('--operform', default = "operform", help = "path to operform command")
+parser.add_argument('--pipeline', '-p', action = "append", help = "run only the given pipeline (may be repeated)")
+parser.add_argument('--repeat', '-r', type = int, default = 3, help = "repeat each run and keep the best times (default 3)")
+parser.add_argument('--tolerance-time', type = float, help = "accepted ratio of time increase")
+parser.add_argument('--tolerance-memory', type = float, help = "accepted ratio of memory increase")
+parser.add_argument('--tolerance-iterations', type = float, help = "accepted ratio of iteration increase")
+parser.add_argument('--logs', default = ".", help = "directory to store the operform logs")
+parser.add_argument('--verbose', '-v', action = "store_true", help = "display the launched commands")
+args = parser.parse_args()
+
+# load the matrix
+try:
+	with open(args.matrix) as f:
+		matrix = json.load(f)
+except (OSError, ValueError) as e:
+	fatal("cannot load %s: %s" % (args.matrix, e))
+base = os.path.dirname(os.path.abspath(args.matrix))
+if args.operform == "operform" and shutil.which("operform") == None:
+	fatal("cannot find operform: use --operform")
+if args.save_baseline and args.baseline == None:
+	fatal("--save-baseline requires --baseline")
+os.makedirs(args.logs, exist_ok = True)
+
+# check the baseline before running
+if args.baseline != None and not args.save_baseline and not os.path.exists(args.baseline):
+	fatal("no baseline %s: use --save-baseline to create it" % args.baseline)
+
+# run the pipelines
+runs = run_matrix(args, matrix, base)
+if any(p.get("peak", -1) < 0 or p.get("allocated", -1) < 0 for r in runs for p in r.phases):
+	warning("per-processor memory figures are unavailable (build OTAWA with OTAWA_MEM_STATS to measure them): only max RSS is checked")
+res = { "version": VERSION, "runs": [r.to_json() for r in runs] }
+if args.output:
+	with open(args.output, "w") as f:
+		json.dump(res, f, indent = 2)
+elif not args.save_baseline:
+	json.dump(res, sys.stdout, indent = 2)
+	sys.stdout.write("\n")
+
+# save or compare with the baseline
+if args.baseline == None:
+	exit(0)
+if args.save_baseline:
+	with open(args.baseline, "w") as f:
+		json.dump(res, f, indent = 2)
+	info("baseline saved to %s" % args.baseline)
+	exit(0)
+try:
+	with open(args.baseline) as f:
+		baseline = json.load(f)
+except (OSError, ValueError) as e:
+	fatal("cannot load baseline %s: %s" % (args.baseline, e))
+if baseline.get("version") != VERSION:
+	fatal("baseline %s has an unsupported version" % args.baseline)
+tol = { "time": 0.25, "memory": 0.10, "iterations": 0. }
+tol.update(matrix.get("tolerance", { }))
+for k in tol:
+	v = getattr(args, "tolerance_" + k)
+	if v != None:
+		tol[k] = v
+issues = compare(runs, baseline, tol)
+for i in issues:
+	error("regression: " + i)
+if issues:
+	exit(1)
+info("no regression against %s" % args.baseline)
@@ -22,8 +22,8 @@
 #define OTAWA_AI_BLOCKABSINT_H
 
 #include <elm/array.h>
-#include <elm/data/SortedList.h>
 #include <elm/util/BitVector.h>
+#include <otawa/ai/BucketQueue.h>
 #include <otawa/ai/DefaultBlockStore.h>
 #include <otawa/ai/features.h>
 #include <otawa/cfg/features.h>
@@ -69,18 +69,17 @@ protected:
 	void processWorkSpace(WorkSpace *ws) override {
 		const CFGCollection& cfgs = *otawa::COLLECTED_CFG_FEATURE.get(ws);
 		store.init(cfgs, d.bot());
-		todo.comparator().r = ai::CFG_RANKING_FEATURE.get(ws);
+		rank = ai::CFG_RANKING_FEATURE.get(ws);
 		intodo = BitVector(cfgs.countBlocks());
+		int updates = 0;
 		typename D::t x;
 
 		// prepare to-do list
 		Block *v = cfgs.entry()->entry();
 		store.set(v, d.init(ws));
 		OTAWA_AI_PRINT("initial = " << io::p(d.init(ws), d));
-		for(auto e: v->outEdges()) {
-			todo.add(e->sink());
-			intodo.set(e->sink()->id());
-		}
+		for(auto e: v->outEdges())
+			put(e->sink());
 
 		// repeat until fix-point
 		while(todo) {
@@ -100,6 +99,7 @@ protected:
 			// update for basic block
 			if(v->isBasic()) {
 				d.set(x, d.update(v, x));
+				updates++;
 				OTAWA_AI_PRINT("\tOUT = " << io::p(x, d));
 				if(!d.equals(x, store.get(v))) {
 					store.set(v, x);
@@ -137,6 +137,8 @@ protected:
 
 		}
 
+		if(logFor(LOG_FUN))
+			log << "\tblock updates: " << updates << io::endl;
 	}
 
 	///
@@ -147,28 +149,19 @@ private:
 
 	inline void put(Block *v) {
 		if(!intodo.bit(v->id())) {
-			todo.add(v);
+			todo.put(v, rank->rankOf(v));
 			intodo.set(v->id());
 		}
 	}
 
 	inline Block *get() {
-		Block *v = todo.first();
-		todo.removeFirst();
+		Block *v = todo.get();
 		intodo.clear(v->id());
 		return v;
 	}
 
-	class Comparator {
-	public:
-		typedef Block *t;
-		int doCompare(Block *v, Block *w) const {
-			return r->rankOf(v) - r->rankOf(w);
-		}
-		ai::CFGRanking *r;
-	};
-
-	SortedList<Block *, Comparator> todo;
+	BucketQueue<Block *> todo;
+	ai::CFGRanking *rank;
 	BitVector intodo;
 	S store;
 	D d;
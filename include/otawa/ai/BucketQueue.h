@@ -0,0 +1,72 @@
+/*
+ *	BucketQueue class interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ *	02110-1301  USA
+ */
+#ifndef OTAWA_AI_BUCKETQUEUE_H_
+#define OTAWA_AI_BUCKETQUEUE_H_
+
+#include <elm/data/Vector.h>
+
+namespace otawa { namespace ai {
+
+using namespace elm;
+
+template <class T>
+class BucketQueue {
+public:
+	inline BucketQueue(void): _min(0), _count(0) { }
+
+	inline bool isEmpty(void) const { return _count == 0; }
+	inline operator bool(void) const { return !isEmpty(); }
+	inline int count(void) const { return _count; }
+
+	void put(const T& x, int rank) {
+		ASSERT(rank >= 0);
+		while(rank >= buckets.length())
+			buckets.add(Vector<T>());
+		buckets[rank].push(x);
+		if(rank < _min)
+			_min = rank;
+		_count++;
+	}
+
+	T get(void) {
+		ASSERT(_count > 0);
+		while(!buckets[_min])
+			_min++;
+		_count--;
+		return buckets[_min].pop();
+	}
+
+	void clear(void) {
+		for(int i = 0; i < buckets.length(); i++)
+			buckets[i].clear();
+		_min = 0;
+		_count = 0;
+	}
+
+private:
+	Vector<Vector<T> > buckets;
+	int _min, _count;
+};
+
+} }		// otawa::ai
+
+#endif /* OTAWA_AI_BUCKETQUEUE_H_ */
@@ -22,6 +22,7 @@
 #define OTAWA_AI_CFGANALYZER_H_
 
 #include <elm/io/StructuredOutput.h>
+#include <elm/sys/Path.h>
 #include "Domain.h"
 
 namespace otawa { namespace ai {
@@ -39,9 +40,14 @@ typedef std::function<void(State *)> state_collector_t;
 
 class CFGAnalyzer: public AbstractInterpreter {
 public:
+	static p::id<sys::Path> STATE_CACHE;
+	static p::id<string> STATE_SIGN;
+
 	CFGAnalyzer(Monitor& monitor, Domain& domain, State *entry = nullptr);
 	~CFGAnalyzer();
 
+	void configure(const PropList& props);
+
 	void process();
 
 	inline State *before(Edge *e) { return states[e->source()->id()]; }
@@ -60,9 +66,16 @@ public:
 	}
 
 	void setTrace(io::StructuredOutput& t);
+	void setCache(const sys::Path& dir, const string& sign = "");
+	inline bool isCached() const { return cache_hit; }
 
 private:
 	
+	sys::Path cachePath();
+	bool loadCache(const sys::Path& path);
+	void saveCache(const sys::Path& path);
+	void resetStates();
+
 	void beginTrace();
 	void endTrace();
 	void doTrace(Block *v, cstring type, State *s);
@@ -74,6 +87,9 @@ private:
 	bool verbose, verbose_inst;
 	List<State *> in_use;
 	io::StructuredOutput *trace;
+	sys::Path cache_dir;
+	string cache_sign;
+	bool cache_hit;
 };
 
 } }	// otawa::ai
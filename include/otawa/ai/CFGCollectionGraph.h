@@ -59,6 +59,8 @@ public:
 	// Indexed concept
 	inline int index(Block *v) const { return v->id(); }
 	inline int count(void) const { return _coll.countBlocks(); }
+	inline int edgeIndex(Edge *e) const { return e->id(); }
+	inline int edgeCount(void) const { return _coll.countEdges(); }
 
 private:
 	const CFGCollection& _coll;
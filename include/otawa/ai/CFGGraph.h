@@ -57,9 +57,14 @@ public:
 		inline Iterator(const CFGGraph& g): CFG::BlockIter(g._cfg->blocks()) { }
 	};
 
+	inline Successor succs(vertex_t v) const { return Successor(*this, v); }
+	inline Predecessor preds(vertex_t v) const { return Predecessor(*this, v); }
+
 	// Indexed concept
 	inline int index(vertex_t v) const { return v->index(); }
 	inline int count(void) const { return _cfg->count(); }
+	inline int edgeIndex(edge_t e) const { return e->id() - _cfg->edgeOffset(); }
+	inline int edgeCount(void) const { return _cfg->countEdges(); }
 
 private:
 	CFG *_cfg;
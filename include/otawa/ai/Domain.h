@@ -50,6 +50,7 @@ public:
 	virtual bool implementsIO();
 	virtual void save(State *s, io::OutStream *out);
 	virtual State *load(io::InStream *in);
+	virtual void discard(State *s);
 
 	virtual bool implementsCodePrinting();
 	virtual void printCode(Block *b, io::Output& out);
@@ -22,7 +22,7 @@
 #ifndef OTAWA_AI_EDGESTORE_H_
 #define OTAWA_AI_EDGESTORE_H_
 
-#include <elm/data/HashMap.h>
+#include <elm/data/Array.h>
 
 namespace otawa { namespace ai {
 
@@ -40,36 +40,38 @@ public:
 	typedef typename G::vertex_t vertex_t;
 	typedef typename G::edge_t edge_t;
 
-	EdgeStore(D& dom, G& graph): _dom(dom), _graph(graph) {
+	EdgeStore(D& dom, G& graph): _dom(dom), _graph(graph), map(graph.edgeCount()) {
+		reset();
 	}
 
 	void set(vertex_t v, t s) {
 		for(typename G::Successor e(_graph, v); e(); e++)
-			map.put(*e, s);
+			map[_graph.edgeIndex(*e)] = s;
 	}
 
-	inline void set(edge_t e, const t& s) { map.put(e, s); }
+	inline void set(edge_t e, const t& s) { map[_graph.edgeIndex(e)] = s; }
 
 	t get(vertex_t v) const {
 		t s = _dom.bot();
 		for(typename G::Successor e(_graph, v); e(); e++)
-			_dom.join(s, map.get(e, _dom.bot()));
+			s = _dom.join(s, map[_graph.edgeIndex(*e)]);
 		return s;
 	}
 
-	inline const t& get(edge_t e) { return map.get(e, _dom.bot()); }
+	inline const t& get(edge_t e) { return map[_graph.edgeIndex(e)]; }
 
 	inline D& domain(void) const { return _dom; }
 	inline G& graph(void) const { return _graph; }
 
 	void reset(void) {
-		map.clear();
+		for(int i = 0; i < map.length(); i++)
+			_dom.copy(map[i], _dom.bot());
 	}
 
 private:
 	D& _dom;
 	G& _graph;
-	HashMap<edge_t, t> map;
+	AllocArray<t> map;
 };
 
 } }		// otawa::ai
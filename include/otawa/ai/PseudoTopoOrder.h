@@ -1,4 +1,4 @@
-#include <elm/data/HashMap.h>
+#include <elm/data/Vector.h>
 #include <elm/util/BitVector.h>
 
 #include <otawa/ai/CFGGraph.h>
@@ -10,9 +10,9 @@ namespace otawa { namespace ai {
 			void _getPseudoTopo(const otawa::ai::CFGGraph &graph);
 			void _topoLoopHelper(const otawa::ai::CFGGraph &graph, Block *start, int currentLoop);
 			void _topoNodeHelper(const otawa::ai::CFGGraph &graph, Block *end);
-			elm::HashMap<int, int> _loopOrder;
-			elm::HashMap<int, int> _blockOrder;
-			elm::HashMap<int, int> _belongsToLoop;
+			elm::Vector<int> _loopOrder;
+			elm::Vector<int> _blockOrder;
+			elm::Vector<int> _belongsToLoop;
 			BitVector *_visited{};
 			int _current;
 
@@ -22,9 +22,10 @@
 #ifndef INCLUDE_OTAWA_AI_ORDERED_AI_H_
 #define INCLUDE_OTAWA_AI_ORDERED_AI_H_
 
-#include <elm/data/SortedList.h>
 #include <elm/types.h>
+#include <elm/util/BitVector.h>
 #include <otawa/prop/Identifier.h>
+#include "BucketQueue.h"
 #include "features.h"
 
 namespace otawa { namespace ai {
@@ -43,35 +44,49 @@ public:
 
 	RankingAI(A& adapter, R& rank = single<R>()):
 		_adapter(adapter),
-		_rank(rank)
+		_rank(rank),
+		_in(adapter.graph().count()),
+		_updates(0)
 		{ }
 
 	void run(void) {
 		t s;
-		_todo.add(_adapter.graph().entry());
+		put(_adapter.graph().entry());
 		while(_todo) {
 
 			// process current item
-			vertex_t v = _todo.first();
-			_todo.removeFirst();
+			vertex_t v = _todo.get();
+			_in.clear(_adapter.graph().index(v));
 			_adapter.update(v, s);
+			_updates++;
 
 			// propagate modification
 			t p = _adapter.store().get(v);
 			if(!_adapter.domain().equals(s, p)) {
 				_adapter.store().set(v, s);
-				for(auto v_w = _adapter.graph().succs(v); v_w; v_w++)
-					_todo.add(_adapter.graph().sinkOf(v_w));
+				for(auto v_w = _adapter.graph().succs(v); v_w(); v_w++)
+					put(_adapter.graph().sinkOf(*v_w));
 			}
 		}
 	}
 
-	inline int doCompare(vertex_t v1, vertex_t v2) const { return _rank.rankOf(v1) - _rank.rankOf(v2); }
+	inline int updates(void) const { return _updates; }
 
 private:
+
+	inline void put(vertex_t v) {
+		int i = _adapter.graph().index(v);
+		if(!_in.bit(i)) {
+			_in.set(i);
+			_todo.put(v, _rank.rankOf(v));
+		}
+	}
+
 	A& _adapter;
 	R& _rank;
-	SortedList<vertex_t, RankingAI<A, R>> _todo;
+	BucketQueue<vertex_t> _todo;
+	BitVector _in;
+	int _updates;
 };
 
 } }		// otawa::ai
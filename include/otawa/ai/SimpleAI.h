@@ -32,20 +32,24 @@ public:
 	typedef A adapter_t;
 
 	SimpleAI(A& adapter)
-		: _adapter(adapter), _driver(adapter.domain(), adapter.graph(), adapter.store()) { }
+		: _adapter(adapter), _driver(adapter.domain(), adapter.graph(), adapter.store()), _updates(0) { }
 
 	void run(void) {
 		typename A::domain_t::t d;
 		while(_driver()) {
 			_adapter.update(*_driver, d);
+			_updates++;
 			_driver.check(d);
 			_driver.next();
 		}
 	}
 
+	inline int updates(void) const { return _updates; }
+
 private:
 	A& _adapter;
 	WorkListDriver<typename A::domain_t, typename A::graph_t, typename A::store_t> _driver;
+	int _updates;
 };
 
 template <class A>
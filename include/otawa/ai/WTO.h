@@ -0,0 +1,238 @@
+/*
+ *	WTO class interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ *	02110-1301  USA
+ */
+#ifndef OTAWA_AI_WTO_H_
+#define OTAWA_AI_WTO_H_
+
+#include <climits>
+#include <elm/data/Vector.h>
+#include <elm/PreIterator.h>
+
+namespace otawa { namespace ai {
+
+using namespace elm;
+
+template <class G>
+class WTO {
+public:
+	typedef typename G::vertex_t vertex_t;
+
+	WTO(const G& graph): _graph(graph), dfn(new int[graph.count()]), num(0) {
+		for(int i = 0; i < graph.count(); i++)
+			dfn[i] = 0;
+		visit(graph.entry());
+		delete [] dfn;
+		dfn = nullptr;
+
+		// reverse the order and fix the component ends
+		int n = _order.length();
+		for(int i = 0, j = n - 1; i < j; i++, j--) {
+			vertex_t v = _order[i];
+			_order[i] = _order[j];
+			_order[j] = v;
+			int e = _ends[i];
+			_ends[i] = _ends[j];
+			_ends[j] = e;
+		}
+		for(int i = 0; i < n; i++)
+			if(_ends[i] >= 0)
+				_ends[i] = n - _ends[i];
+	}
+
+	inline int count() const { return _order.length(); }
+	inline vertex_t operator[](int i) const { return _order[i]; }
+	inline bool isHead(int i) const { return _ends[i] >= 0; }
+	inline int endOf(int i) const { return _ends[i]; }
+
+private:
+
+	int visit(vertex_t v) {
+		stack.push(v);
+		dfn[_graph.index(v)] = ++num;
+		int head = num;
+		bool loop = false;
+		for(auto s = _graph.succs(v); s(); s++) {
+			vertex_t w = _graph.sinkOf(*s);
+			int min = dfn[_graph.index(w)];
+			if(min == 0)
+				min = visit(w);
+			if(min <= head) {
+				head = min;
+				loop = true;
+			}
+		}
+		if(head == dfn[_graph.index(v)]) {
+			dfn[_graph.index(v)] = INT_MAX;
+			vertex_t w = stack.pop();
+			if(!loop) {
+				_order.add(v);
+				_ends.add(-1);
+			}
+			else {
+				while(w != v) {
+					dfn[_graph.index(w)] = 0;
+					w = stack.pop();
+				}
+				component(v);
+			}
+		}
+		return head;
+	}
+
+	void component(vertex_t v) {
+		int start = _order.length();
+		for(auto s = _graph.succs(v); s(); s++) {
+			vertex_t w = _graph.sinkOf(*s);
+			if(dfn[_graph.index(w)] == 0)
+				visit(w);
+		}
+		_order.add(v);
+		_ends.add(start);
+	}
+
+	const G& _graph;
+	Vector<vertex_t> _order;
+	Vector<int> _ends;
+	Vector<vertex_t> stack;
+	int *dfn;
+	int num;
+};
+
+
+class NoWidening {
+public:
+	template <class D>
+	inline typename D::t widen(D& dom, typename D::t old, typename D::t s) const { return s; }
+};
+
+class DomainWidening {
+public:
+	template <class D>
+	inline typename D::t widen(D& dom, typename D::t old, typename D::t s) const { return dom.widen(old, s); }
+};
+
+
+template <class D, class G, class S, class W = NoWidening>
+class WTODriver: public PreIterator<WTODriver<D, G, S, W>, typename G::vertex_t> {
+public:
+	typedef typename G::vertex_t vertex_t;
+	typedef typename D::t t;
+
+	WTODriver(D& dom, const G& graph, S& store, const W& widening = W())
+	: _dom(dom), _graph(graph), _store(store), _wto(graph), _widening(widening), pos(-1), changed(false) {
+		store.set(_graph.entry(), dom.init());
+		next();
+	}
+
+	inline bool ended(void) const { return pos >= _wto.count(); }
+	inline vertex_t item(void) const { return _wto[pos]; }
+
+	void next(void) {
+		do {
+
+			// leaving a head
+			if(pos >= 0 && _wto.isHead(pos)) {
+				if(!comps || comps.top() != pos)
+					comps.push(pos);
+				else if(!changed) {
+					pos = _wto.endOf(pos);
+					comps.pop();
+					pos--;
+				}
+			}
+
+			// go to next vertex, iterating again at component end
+			pos++;
+			if(comps && pos == _wto.endOf(comps.top()))
+				pos = comps.top();
+			changed = false;
+
+		} while(pos < _wto.count() && !_wto.isHead(pos)
+			&& (_wto[pos] == _graph.entry() || _wto[pos] == _graph.exit()));
+	}
+
+	inline bool isHead(void) const { return _wto.isHead(pos); }
+
+	inline void change(t s) {
+		_store.set(item(), s);
+		changed = true;
+	}
+
+	inline void check(t s) {
+		t ps = _store.get(item());
+		if(comps && comps.top() == pos)
+			s = _widening.widen(_dom, ps, s);
+		if(!_dom.equals(s, ps))
+			change(s);
+	}
+
+	inline t input(void) { return input(item()); }
+
+	t input(vertex_t vertex) {
+		t s = _dom.bot();
+		for(auto pred = _graph.preds(vertex); pred(); pred++)
+			s = _dom.join(s, _store.get(*pred));
+		return s;
+	}
+
+	inline const WTO<G>& wto(void) const { return _wto; }
+
+private:
+	D& _dom;
+	const G& _graph;
+	S& _store;
+	WTO<G> _wto;
+	W _widening;
+	Vector<int> comps;
+	int pos;
+	bool changed;
+};
+
+
+template <class A, class W = NoWidening>
+class WTOAI {
+public:
+	typedef A adapter_t;
+
+	WTOAI(A& adapter, const W& widening = W())
+		: _adapter(adapter), _driver(adapter.domain(), adapter.graph(), adapter.store(), widening), _updates(0) { }
+
+	void run(void) {
+		typename A::domain_t::t d;
+		while(_driver()) {
+			_adapter.update(*_driver, d);
+			_updates++;
+			_driver.check(d);
+			_driver.next();
+		}
+	}
+
+	inline int updates(void) const { return _updates; }
+
+private:
+	A& _adapter;
+	WTODriver<typename A::domain_t, typename A::graph_t, typename A::store_t, W> _driver;
+	int _updates;
+};
+
+} }		// otawa::ai
+
+#endif /* OTAWA_AI_WTO_H_ */
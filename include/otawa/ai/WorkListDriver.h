@@ -24,6 +24,7 @@
 
 #include <elm/data/Vector.h>
 #include <elm/util/BitVector.h>
+#include <otawa/stats/ProcStats.h>
 
 namespace otawa { namespace ai {
 
@@ -69,8 +70,10 @@ public:
 	inline void next(void) {
 		while(!wl_vertices.isEmpty()) {
 			cur = pop();
-			if(cur != _graph.exit())
+			if(cur != _graph.exit()) {
+				ProcStats::iterate();
 				return;
+			}
 		}
 		end = true;
 	}
@@ -255,8 +258,10 @@ public:
 	inline void next(void) {
 		while(!wl_vertices.isEmpty()) {
 			cur = pop();
-			if(cur != _graph.exit())
+			if(cur != _graph.exit()) {
+				ProcStats::iterate();
 				return;
+			}
 		}
 		end = true;
 	}
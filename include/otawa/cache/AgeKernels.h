@@ -0,0 +1,160 @@
+/*
+ *	age kernels for abstract cache states
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef OTAWA_CACHE_AGEKERNELS_H
+#define OTAWA_CACHE_AGEKERNELS_H
+
+#include <elm/types.h>
+#if defined(__SSE2__) || defined(__AVX2__)
+#	include <immintrin.h>
+#endif
+
+namespace otawa { namespace cache {
+
+// Operations on arrays of byte ages, vectorized with AVX2 or SSE2 when
+// available at compile time. The absent age is usually -1 that is the smallest
+// signed age and the biggest unsigned one.
+
+// d[i] = max(d[i], s[i]) (signed ages)
+inline void maxAges(elm::t::int8 *d, const elm::t::int8 *s, int n) {
+	int i = 0;
+#	ifdef __AVX2__
+		for(; i + 32 <= n; i += 32) {
+			__m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(d + i));
+			__m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i));
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(d + i), _mm256_max_epi8(x, y));
+		}
+#	endif
+#	ifdef __SSE2__
+		const __m128i sign = _mm_set1_epi8(char(0x80));
+		for(; i + 16 <= n; i += 16) {
+			__m128i x = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(d + i)), sign);
+			__m128i y = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i)), sign);
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(d + i), _mm_xor_si128(_mm_max_epu8(x, y), sign));
+		}
+#	endif
+	for(; i < n; i++)
+		if(s[i] > d[i])
+			d[i] = s[i];
+}
+
+// d[i] = max(d[i], s[i]) (unsigned ages, -1 is absorbing)
+inline void umaxAges(elm::t::int8 *d, const elm::t::int8 *s, int n) {
+	int i = 0;
+#	ifdef __AVX2__
+		for(; i + 32 <= n; i += 32) {
+			__m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(d + i));
+			__m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i));
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(d + i), _mm256_max_epu8(x, y));
+		}
+#	endif
+#	ifdef __SSE2__
+		for(; i + 16 <= n; i += 16) {
+			__m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(d + i));
+			__m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(d + i), _mm_max_epu8(x, y));
+		}
+#	endif
+	for(; i < n; i++)
+		if(elm::t::uint8(s[i]) > elm::t::uint8(d[i]))
+			d[i] = s[i];
+}
+
+// d[i] = min(d[i], s[i]) (unsigned ages, -1 is neutral)
+inline void uminAges(elm::t::int8 *d, const elm::t::int8 *s, int n) {
+	int i = 0;
+#	ifdef __AVX2__
+		for(; i + 32 <= n; i += 32) {
+			__m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(d + i));
+			__m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i));
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(d + i), _mm256_min_epu8(x, y));
+		}
+#	endif
+#	ifdef __SSE2__
+		for(; i + 16 <= n; i += 16) {
+			__m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(d + i));
+			__m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(d + i), _mm_min_epu8(x, y));
+		}
+#	endif
+	for(; i < n; i++)
+		if(elm::t::uint8(s[i]) < elm::t::uint8(d[i]))
+			d[i] = s[i];
+}
+
+// test if a[i] = b[i] for all i
+inline bool equalAges(const elm::t::int8 *a, const elm::t::int8 *b, int n) {
+	int i = 0;
+#	ifdef __AVX2__
+		for(; i + 32 <= n; i += 32) {
+			__m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+			__m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+			if(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)) != -1)
+				return false;
+		}
+#	endif
+#	ifdef __SSE2__
+		for(; i + 16 <= n; i += 16) {
+			__m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+			__m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+			if(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) != 0xffff)
+				return false;
+		}
+#	endif
+	for(; i < n; i++)
+		if(a[i] != b[i])
+			return false;
+	return true;
+}
+
+// a[i] = a[i] + 1 if lo < a[i] < hi and a[i] ≠ top (signed ages);
+// passing top = lo disables the top test
+inline void incAges(elm::t::int8 *a, int n, elm::t::int8 lo, elm::t::int8 hi, elm::t::int8 top) {
+	int i = 0;
+#	ifdef __AVX2__
+		{
+			const __m256i vlo = _mm256_set1_epi8(lo), vhi = _mm256_set1_epi8(hi), vtop = _mm256_set1_epi8(top);
+			for(; i + 32 <= n; i += 32) {
+				__m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+				__m256i m = _mm256_and_si256(_mm256_cmpgt_epi8(x, vlo), _mm256_cmpgt_epi8(vhi, x));
+				m = _mm256_andnot_si256(_mm256_cmpeq_epi8(x, vtop), m);
+				_mm256_storeu_si256(reinterpret_cast<__m256i *>(a + i), _mm256_sub_epi8(x, m));
+			}
+		}
+#	endif
+#	ifdef __SSE2__
+		{
+			const __m128i vlo = _mm_set1_epi8(lo), vhi = _mm_set1_epi8(hi), vtop = _mm_set1_epi8(top);
+			for(; i + 16 <= n; i += 16) {
+				__m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+				__m128i m = _mm_and_si128(_mm_cmpgt_epi8(x, vlo), _mm_cmpgt_epi8(vhi, x));
+				m = _mm_andnot_si128(_mm_cmpeq_epi8(x, vtop), m);
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(a + i), _mm_sub_epi8(x, m));
+			}
+		}
+#	endif
+	for(; i < n; i++)
+		if(lo < a[i] && a[i] < hi && a[i] != top)
+			a[i]++;
+}
+
+} }	// otawa::cache
+
+#endif	// OTAWA_CACHE_AGEKERNELS_H
@@ -24,7 +24,9 @@
 #ifndef CACHE_MUSTPROBLEM_H_
 #define CACHE_MUSTPROBLEM_H_
 
+#include <string.h>
 #include <otawa/dfa/hai/HalfAbsInt.h>
+#include <otawa/cache/AgeKernels.h>
 #include <elm/assert.h>
 #include <elm/io.h>
 #include <otawa/prog/WorkSpace.h>
@@ -56,9 +58,8 @@ class MUSTProblem {
 			inline Domain(const int _size, const int _A)
 			: A (_A), size(_size)
 			{
-				age = new int [size];
-				for (int i = 0; i < size; i++)
-					age[i] = 0;
+				age = new t::int8 [size];
+				memset(age, 0, size);
 			}
 			
 			inline ~Domain() {
@@ -66,36 +67,27 @@ class MUSTProblem {
 			}
 			
 			inline Domain(const Domain &source) : A(source.A), size(source.size) {
-				age = new int [size];
-				for (int i = 0; i < size; i++)
-					age[i] = source.age[i];
-
-			} 
+				age = new t::int8 [size];
+				memcpy(age, source.age, size);
+			}
 		
 			inline Domain& operator=(const Domain &src) {
 				ASSERT((A == src.A) && (size == src.size));
-				for (int i = 0; i < size ; i++)
-					age[i] = src.age[i];
+				memcpy(age, src.age, size);
 				return(*this);
 				
 			}
 			 
 			inline void glb(const Domain &dom) {
 				ASSERT((A == dom.A) && (size == dom.size));
-				
-				for (int i = 0; i < size; i++) {
-					if (((age[i] > dom.age[i]) && (dom.age[i] != -1)) || (age[i] == -1))
-						age[i] = dom.age[i];
-				}
+				// -1 is the biggest unsigned age
+				cache::uminAges(age, dom.age, size);
 			}
 			
 			inline void lub(const Domain &dom) {
 				ASSERT((A == dom.A) && (size == dom.size));
-
-				for (int i = 0; i < size; i++) {
-					if (((age[i] < dom.age[i]) && (age[i] != -1))|| (dom.age[i] == -1))
-						age[i] = dom.age[i];
-				}
+				// -1 is the biggest unsigned age
+				cache::umaxAges(age, dom.age, size);
 			}
 			
 			inline int getSize(void) {
@@ -106,23 +98,17 @@ class MUSTProblem {
 				ASSERT((id >= 0) && (id < size));
 				if (age[id] == -1)
 					return;
-				age[id] += damage;
-				if (age[id] >= A)
-					age[id] = -1;
+				int a = age[id] + damage;
+				age[id] = a >= A ? -1 : a;
 			}
 			
 			inline bool equals(const Domain &dom) const {
 				ASSERT((A == dom.A) && (size == dom.size));
-				for (int i = 0; i < size; i++)
-					if (age[i] != dom.age[i])
-						return false;
-				return true;
+				return cache::equalAges(age, dom.age, size);
 			}
 			
 			inline void empty() {
-				for (int i = 0; i < size; i++)
-					age[i] = -1;
-				
+				memset(age, -1, size);
 			}
 			
 			inline bool contains(const int id) {
@@ -133,10 +119,7 @@ class MUSTProblem {
 			
 			inline void inject(const int id) {
 				if (contains(id)) {
-					for (int i = 0; i < size; i++) {
-						if ((age[i] < age[id]) && (age[i] != -1))
-							age[i]++;						
-					}
+					cache::incAges(age, size, -1, age[id], -1);
 					age[id] = 0;
 				} else {
 					for (int i = 0; i < size; i++) {
@@ -160,7 +143,7 @@ class MUSTProblem {
 						// output << i << ":" << age[i];
 						output << i;
 						output << ":";
-						output << age[i];
+						output << int(age[i]);
 						
 						first = false;
 					}
@@ -186,7 +169,7 @@ class MUSTProblem {
 			 * age[block] represents its age, from 0 (newest) to A-1 (oldest).
 			 * The value -1 means that the block is not in the set.
 			 */  
-			int *age;
+			t::int8 *age;
 	};
 	
 	private:
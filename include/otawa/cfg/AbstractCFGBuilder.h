@@ -36,6 +36,7 @@ public:
 	~AbstractCFGBuilder();
 
 	CFGMaker &maker(Inst *i);
+	void reuse(CFG *g);
 
 	class Iter: public PreIterator<Iter, CFGMaker *> {
 	public:
@@ -59,6 +60,7 @@ private:
 	void seq(CFGMaker& m, BasicBlock *b, Block *src, t::uint32 flags = Edge::NOT_TAKEN);
 
 	makers_t makers;
+	Vector<CFG *> reused;
 	Bag<Address> bounds;
 };
 
@@ -0,0 +1,101 @@
+/*
+ *	BlockArrayStore and EdgeArrayStore classes interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ *	02110-1301  USA
+ */
+#ifndef OTAWA_CFG_ARRAYSTORES_H_
+#define OTAWA_CFG_ARRAYSTORES_H_
+
+#include <new>
+#include <otawa/cfg/features.h>
+
+namespace otawa {
+
+template <class T>
+class IdArrayStore {
+public:
+	inline IdArrayStore(void): _size(0), _tab(nullptr) { }
+	inline ~IdArrayStore(void) { clear(); }
+
+	void init(int size, const T& x) {
+		clear();
+		_tab = static_cast<T *>(::operator new(sizeof(T) * size));
+		for(int i = 0; i < size; i++)
+			new(_tab + i) T(x);
+		_size = size;
+	}
+
+	void fill(const T& x) {
+		for(int i = 0; i < _size; i++)
+			_tab[i] = x;
+	}
+
+	void clear(void) {
+		if(_tab == nullptr)
+			return;
+		for(int i = 0; i < _size; i++)
+			_tab[i].~T();
+		::operator delete(_tab);
+		_tab = nullptr;
+		_size = 0;
+	}
+
+	inline bool isEmpty(void) const { return _size == 0; }
+	inline int count(void) const { return _size; }
+	inline T& operator[](int i) { ASSERT(0 <= i && i < _size); return _tab[i]; }
+	inline const T& operator[](int i) const { ASSERT(0 <= i && i < _size); return _tab[i]; }
+
+private:
+	IdArrayStore(const IdArrayStore<T>&);
+	IdArrayStore<T>& operator=(const IdArrayStore<T>&);
+	int _size;
+	T *_tab;
+};
+
+template <class T>
+class BlockArrayStore: public IdArrayStore<T> {
+public:
+	inline BlockArrayStore(void) { }
+	inline BlockArrayStore(const CFGCollection& coll, const T& x) { init(coll, x); }
+
+	inline void init(const CFGCollection& coll, const T& x) { IdArrayStore<T>::init(coll.countBlocks(), x); }
+	using IdArrayStore<T>::operator[];
+	inline T& operator[](Block *v) { return (*this)[v->id()]; }
+	inline const T& operator[](Block *v) const { return (*this)[v->id()]; }
+	inline const T& get(Block *v) const { return (*this)[v->id()]; }
+	inline void set(Block *v, const T& x) { (*this)[v->id()] = x; }
+};
+
+template <class T>
+class EdgeArrayStore: public IdArrayStore<T> {
+public:
+	inline EdgeArrayStore(void) { }
+	inline EdgeArrayStore(const CFGCollection& coll, const T& x) { init(coll, x); }
+
+	inline void init(const CFGCollection& coll, const T& x) { IdArrayStore<T>::init(coll.countEdges(), x); }
+	using IdArrayStore<T>::operator[];
+	inline T& operator[](Edge *e) { return (*this)[e->id()]; }
+	inline const T& operator[](Edge *e) const { return (*this)[e->id()]; }
+	inline const T& get(Edge *e) const { return (*this)[e->id()]; }
+	inline void set(Edge *e, const T& x) { (*this)[e->id()] = x; }
+};
+
+}	// otawa
+
+#endif /* OTAWA_CFG_ARRAYSTORES_H_ */
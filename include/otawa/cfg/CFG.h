@@ -41,9 +41,11 @@ class SynthBlock;
 
 class Edge: public PropList, public graph::GenEdge<Block, Edge> {
 	friend class CFGMaker;
+	friend class CFGCollection;
 public:
-	inline Edge(t::uint32 flags): _flags(flags) { }
+	inline Edge(t::uint32 flags): _flags(flags), _id(-1) { }
 	inline Block *target(void) const { return sink(); }
+	inline int id(void) const { return _id; }
 
 	inline t::uint32 flags(void) const { return _flags; }
 	static const t::uint32 NOT_TAKEN	= 0x00000001;
@@ -61,6 +63,7 @@ public:
 
 private:
 	t::uint32 _flags;
+	int _id;
 };
 io::Output& operator<<(io::Output& out, Edge *edge);
 
@@ -236,6 +239,8 @@ public:
 	string format(const Address& addr);
 	inline int index(void) const { return idx; }
 	inline int offset(void) const { return _offset; }
+	inline int edgeOffset(void) const { return _eoffset; }
+	inline int countEdges(void) const { return _ecount; }
 	inline Inst *first(void) const { return fst; }
 	inline Address address(void) const { return first()->address(); }
 	inline Block *entry(void) const  { return _entry; }
@@ -250,7 +255,7 @@ public:
 
 private:
 	CFG(Inst *first, type_t type = SUBPROG);
-	int idx, _offset;
+	int idx, _offset, _eoffset, _ecount;
 	type_t _type;
 	Inst *fst;
 	Block *_entry, *_exit, *_unknown;
@@ -290,6 +295,7 @@ public:
 	inline Block *at(int index) const { return cfg->at(index); }
 	void fix(SynthBlock *v, CFGMaker *g);
 	void fix(SynthBlock *v, CFG *g);
+	static void relink(SynthBlock *v, CFG *g);
 private:
 	CFG *cfg;
 	bool _fix;
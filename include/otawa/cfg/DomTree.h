@@ -0,0 +1,63 @@
+/*
+ *	DomTree class interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef OTAWA_CFG_DOMTREE_H
+#define OTAWA_CFG_DOMTREE_H
+
+#include <elm/data/Array.h>
+#include <otawa/cfg/CFG.h>
+
+namespace otawa {
+
+class DomTree {
+public:
+	DomTree(CFG *cfg, bool post = false);
+
+	inline CFG *cfg(void) const { return _cfg; }
+	inline bool isPost(void) const { return _post_dom; }
+	inline Block *root(void) const { return _post_dom ? _cfg->exit() : _cfg->entry(); }
+	inline bool isReachable(Block *b) const { return _pre[b->index()] >= 0; }
+	inline int preorder(Block *b) const { return _pre[b->index()]; }
+	inline int postorder(Block *b) const { return _post[b->index()]; }
+
+	inline Block *idom(Block *b) const {
+		int i = _idom[b->index()];
+		return i < 0 || i == b->index() ? nullptr : _cfg->at(i);
+	}
+
+	inline bool dominates(Block *b1, Block *b2) const {
+		int i1 = b1->index(), i2 = b2->index();
+		if(_pre[i2] < 0)
+			return true;
+		return _pre[i1] >= 0 && _pre[i1] <= _pre[i2] && _post[i2] <= _post[i1];
+	}
+
+private:
+	void computeIDom(void);
+	void computeOrders(void);
+
+	CFG *_cfg;
+	bool _post_dom;
+	AllocArray<int> _idom, _pre, _post;
+};
+
+} // otawa
+
+#endif // OTAWA_CFG_DOMTREE_H
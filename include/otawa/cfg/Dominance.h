@@ -29,6 +29,7 @@ namespace otawa {
 
 // External
 class BasicBlock;
+class DomTree;
 class Edge;
 namespace dfa { class BitSet; }
 
@@ -61,6 +62,7 @@ private:
 
 // Features
 extern Identifier<const dfa::BitSet *> REVERSE_DOM;
+extern Identifier<DomTree *> DOM_TREE;
 
 } // otawa
 
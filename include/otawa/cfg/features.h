@@ -42,12 +42,14 @@ namespace graph { class Edge; }
 // CFGCollection Class
 class CFGCollection {
 public:
+	inline CFGCollection(void): _bcount(0), _ecount(0) { }
 	static const CFGCollection *get(WorkSpace *ws);
 	inline int count(void) const { return cfgs.length(); }
 	inline CFG *get(int index) const { return cfgs[index]; }
 	inline CFG *operator[](int index) const { return cfgs[index]; }
 	inline CFG *entry(void) const { return get(0); }
 	int countBlocks(void) const;
+	int countEdges(void) const;
 
 	class Iter: public FragTable<CFG *>::Iter {
 		friend class CFGCollection;
@@ -91,9 +93,12 @@ public:
 	inline BlockRange blocks(void) const { return BlockRange(*this); }
 
 	void add(CFG *cfg);
+	void keep(CFG *cfg);
+	void numberAfter(const CFGCollection& coll);
 
 private:
 	elm::FragTable<CFG *> cfgs;
+	int _bcount, _ecount;
 };
 
 // context support
@@ -50,6 +50,7 @@ protected:
 	bool all;
 	bool no_insts;
 	bool line_info;
+	bool binary;
 };
 
 } }	// otawa::cfgio
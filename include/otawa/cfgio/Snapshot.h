@@ -0,0 +1,85 @@
+/*
+ *	cfgio::Snapshot class interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef OTAWA_CFGIO_SNAPSHOT_H_
+#define OTAWA_CFGIO_SNAPSHOT_H_
+
+#include <elm/avl/Set.h>
+#include <elm/io/OutStream.h>
+#include <elm/sys/Path.h>
+#include <otawa/cfg.h>
+#include <otawa/proc/Monitor.h>
+
+namespace otawa { namespace cfgio {
+
+using namespace elm;
+
+class Snapshot {
+public:
+	static const t::uint32 VERSION = 2;
+
+	typedef struct header_t {
+		char magic[8];
+		t::uint32 version, bom;
+		t::uint32 cfg_count, block_count, edge_count, prop_count, string_size;
+		t::uint32 pad;
+	} header_t;
+
+	typedef struct cfg_t {
+		t::uint32 page, address, label;
+		t::uint32 block, block_count;
+		t::uint32 edge, edge_count;
+	} cfg_t;
+
+	typedef enum {
+		ENTRY = 0,
+		EXIT = 1,
+		UNKNOWN = 2,
+		BASIC = 3,
+		CALL = 4
+	} kind_t;
+
+	typedef struct block_t {
+		t::uint32 kind, page, address, size;
+		t::int32 callee;
+	} block_t;
+
+	typedef struct edge_t {
+		t::uint32 source, target, flags;
+	} edge_t;
+
+	typedef enum {
+		ON_CFG = 0,
+		ON_BLOCK = 1,
+		ON_EDGE = 2
+	} owner_t;
+
+	typedef struct prop_t {
+		t::uint32 owner_kind, owner, id, value;
+	} prop_t;
+
+	static bool isSnapshot(const sys::Path& path);
+	static void save(const CFGCollection& coll, io::OutStream *out, const avl::Set<const AbstractIdentifier *>& ids);
+	static CFGCollection *load(WorkSpace *ws, const sys::Path& path, Monitor& mon);
+};
+
+} }	// otawa::cfgio
+
+#endif /* OTAWA_CFGIO_SNAPSHOT_H_ */
@@ -30,6 +30,7 @@ extern p::id<cstring> INCLUDE;
 extern p::id<bool> NO_INSTS;
 extern p::id<Path> OUTPUT;
 extern p::id<bool> LINE_INFO;
+extern p::id<bool> BINARY;
 
 // Input configuration
 extern Identifier<Path> FROM;
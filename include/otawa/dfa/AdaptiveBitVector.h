@@ -0,0 +1,107 @@
+/*
+ *	AdaptiveBitVector class interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ *	02110-1301  USA
+ */
+#ifndef OTAWA_DFA_ADAPTIVEBITVECTOR_H
+#define OTAWA_DFA_ADAPTIVEBITVECTOR_H
+
+#include <elm/assert.h>
+#include <elm/types.h>
+#include <elm/PreIterator.h>
+
+namespace otawa { namespace dfa {
+
+using namespace elm;
+
+// AdaptiveBitVector class
+class AdaptiveBitVector {
+public:
+	typedef t::uint32 word_t;
+
+	inline AdaptiveBitVector(void): _size(0), _count(0), _cap(0), _dense(true), _data(nullptr) { }
+	AdaptiveBitVector(int size, bool set = false);
+	AdaptiveBitVector(const AdaptiveBitVector& v);
+	inline ~AdaptiveBitVector(void) { delete [] _data; }
+	AdaptiveBitVector& operator=(const AdaptiveBitVector& v);
+
+	inline int __size(void) const { return sizeof(*this) + _cap * sizeof(word_t); }
+	inline bool isDense(void) const { return _dense; }
+	inline int size(void) const { return _size; }
+	inline int countBits(void) const { return _count; }
+	inline bool isEmpty(void) const { return _count == 0; }
+	inline bool isFull(void) const { return _count == _size; }
+
+	bool bit(int i) const;
+	inline bool operator[](int i) const { return bit(i); }
+	void set(int i);
+	void clear(int i);
+	void set(void);
+	void clear(void);
+
+	bool equals(const AdaptiveBitVector& v) const;
+	bool includes(const AdaptiveBitVector& v) const;
+	inline bool includesStrictly(const AdaptiveBitVector& v) const
+		{ return _count > v._count && includes(v); }
+	bool meets(const AdaptiveBitVector& v) const;
+
+	void applyNot(void);
+	void applyOr(const AdaptiveBitVector& v);
+	void applyAnd(const AdaptiveBitVector& v);
+	void applyReset(const AdaptiveBitVector& v);
+
+	inline AdaptiveBitVector makeNot(void) const
+		{ AdaptiveBitVector r(*this); r.applyNot(); return r; }
+	inline AdaptiveBitVector makeOr(const AdaptiveBitVector& v) const
+		{ AdaptiveBitVector r(*this); r.applyOr(v); return r; }
+	inline AdaptiveBitVector makeAnd(const AdaptiveBitVector& v) const
+		{ AdaptiveBitVector r(*this); r.applyAnd(v); return r; }
+	inline AdaptiveBitVector makeReset(const AdaptiveBitVector& v) const
+		{ AdaptiveBitVector r(*this); r.applyReset(v); return r; }
+
+	// OneIterator class
+	class OneIterator: public PreIterator<OneIterator, int> {
+	public:
+		inline OneIterator(const AdaptiveBitVector& v): _v(v), _i(-1) { next(); }
+		inline bool ended(void) const { return _i >= (_v._dense ? _v._size : _v._count); }
+		inline int item(void) const { return _v._dense ? _i : int(_v._data[_i]); }
+		void next(void);
+	private:
+		const AdaptiveBitVector& _v;
+		int _i;
+	};
+
+private:
+	inline int words(void) const { return (_size + 31) >> 5; }
+	inline word_t mask(void) const { return _size & 31 ? (word_t(1) << (_size & 31)) - 1 : ~word_t(0); }
+	int find(int i) const;
+	void alloc(int cap);
+	void toDense(void);
+	void toSparse(void);
+	void adapt(void);
+	void recount(void);
+
+	int _size, _count, _cap;
+	bool _dense;
+	word_t *_data;
+};
+
+} }	// otawa::dfa
+
+#endif	// OTAWA_DFA_ADAPTIVEBITVECTOR_H
@@ -28,9 +28,12 @@
 #if defined(OTAWA_BITSET_WAH) || defined(OTAWA_BITSET_BOTH)
 #	include <elm/util/WAHVector.h>
 #endif
-#if defined(OTAWA_BITSET_BOTH) || !defined(OTAWA_BITSET_WAH)
+#if defined(OTAWA_BITSET_BOTH) || defined(OTAWA_BITSET_DENSE)
 #	include <elm/util/BitVector.h>
 #endif
+#if !defined(OTAWA_BITSET_WAH) && !defined(OTAWA_BITSET_BOTH) && !defined(OTAWA_BITSET_DENSE)
+#	include <otawa/dfa/AdaptiveBitVector.h>
+#endif
 #ifdef OTAWA_BITSET_BOTH
 #	include <elm/util/WAHVector.h>
 #	include <elm/util/BitVector.h>
@@ -84,8 +87,10 @@ class BitSet {
 		typedef elm::WAHVector vec_t;
 #	elif defined(OTAWA_BITSET_BOTH)
 		typedef Both vec_t;
-#	else
+#	elif defined(OTAWA_BITSET_DENSE)
 		typedef elm::BitVector vec_t;
+#	else
+		typedef AdaptiveBitVector vec_t;
 #	endif
 	vec_t vec;
 public:
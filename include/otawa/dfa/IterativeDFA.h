@@ -25,6 +25,7 @@
 #include <elm/data/VectorQueue.h>
 #include <elm/util/BitVector.h>
 #include <otawa/graph/DiGraph.h>
+#include <otawa/stats/ProcStats.h>
 
 #ifdef OTAWA_IDFA_DEBUG
 #	define OTAWA_IDFA_TRACE(x)	cerr << x << io::endl
@@ -165,7 +166,9 @@ inline void IterativeDFA<Problem, Set, G, Iter>::compute(void) {
 		}
 
 	// perform until no change
+	int iters = 0;
 	while(todo) {
+		iters++;
 		typename G::vertex_t *bb = todo.get();
 		int idx = bb->index();
 		ASSERT(idx >= 0);
@@ -208,6 +211,7 @@ inline void IterativeDFA<Problem, Set, G, Iter>::compute(void) {
 		}
 		prob.reset(comp);
 	}
+	ProcStats::iterate(iters);
 
 	// cleanup
 	prob.free(comp);
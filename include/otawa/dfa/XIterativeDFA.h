@@ -8,6 +8,7 @@
 #define OTAWA_DFA_XITERATIVEDFA_H
 
 #include <elm/assert.h>
+#include <otawa/stats/ProcStats.h>
 
 namespace otawa { namespace dfa {
 
@@ -77,6 +78,7 @@ inline void XIterativeDFA<V>::process(void) {
 	new_out = visit.empty();
 	while(!fixpoint) {
 		fixpoint = true;
+		ProcStats::iterate(size);
 		for(int i = 0; i < size; i++) {
 			new_out->reset();
 			visit.visitPreds(*this, i);
@@ -25,6 +25,7 @@
 #define OTAWA_DFA_HAI_DEFAULTLISTENER_H_
 
 #include "DefaultFixPoint.h"
+#include <otawa/cfg/ArrayStores.h>
 #include <otawa/cfg/CFG.h>
 #include <otawa/cfg/CFGCollector.h>
 #include <otawa/cfg/BasicBlock.h>
@@ -47,18 +48,21 @@ public:
 
 	DefaultListener(WorkSpace *_fw, Problem& _prob, bool _store_out = false) : fw(_fw), prob(_prob), store_out(_store_out) {
 		const CFGCollection *col = INVOLVED_CFGS(fw);
+		ins.init(*col, prob.bottom());
 		results = new typename Problem::Domain**[col->count()];
-		if (store_out)
+		if (store_out) {
+			outs.init(*col, prob.bottom());
 		  	results_out = new typename Problem::Domain**[col->count()];
+		}
 		for (int i = 0; i < col->count();  i++) {
 			CFG *cfg = col->get(i);
 			results[i] = new typename Problem::Domain*[cfg->count()];
 			if (store_out)
 			  results_out[i] = new typename Problem::Domain*[cfg->count()];
 			for (int j = 0; j < cfg->count(); j++){
-				results[i][j] = new typename Problem::Domain(prob.bottom());
+				results[i][j] = &ins[cfg->offset() + j];
 				if (store_out)
-				  results_out[i][j] = new typename Problem::Domain(prob.bottom());
+				  results_out[i][j] = &outs[cfg->offset() + j];
 			}
 		}
 	}
@@ -66,12 +70,6 @@ public:
 	~DefaultListener() {
 		const CFGCollection *col = INVOLVED_CFGS(fw);
 		for (int i = 0; i < col->count();  i++) {
-			CFG *cfg = col->get(i);
-			for (int j = 0; j < cfg->count(); j++){
-				delete results[i][j];
-				if (store_out)
-				  delete results_out[i][j];
-			}
 			delete [] results[i];
 			if (store_out)
 			  delete [] results_out[i];
@@ -81,6 +79,9 @@ public:
 		  delete [] results_out;
 	}
 
+	inline const typename Problem::Domain& in(Block *bb) const { return ins[bb]; }
+	inline const typename Problem::Domain& out(Block *bb) const { return outs[bb]; }
+
 	void blockInterpreted(const DefaultFixPoint< DefaultListener >  *fp, Block* bb, const typename Problem::Domain& in, const typename Problem::Domain& out, CFG *cur_cfg, Vector<Edge*> *callStack) const;
 
 	void fixPointReached(const DefaultFixPoint<DefaultListener > *fp, Block*bb );
@@ -93,6 +94,7 @@ private:
 	WorkSpace *fw;
 	Problem& prob;
 	bool store_out;
+	mutable BlockArrayStore<typename Problem::Domain> ins, outs;
 
 };
 
@@ -105,16 +107,13 @@ Identifier<typename Problem::Domain*> DefaultListener<Problem>::BB_OUT_STATE("",
 template <class Problem >
 void DefaultListener<Problem>::blockInterpreted(const DefaultFixPoint<DefaultListener>  *fp, Block* bb, const typename Problem::Domain& in, const typename Problem::Domain& out, CFG *cur_cfg, Vector<Edge*> *callStack) const {
 
-		int bbnumber = bb->index() ;
-		int cfgnumber = cur_cfg->index();
-
-		prob.lub(*results[cfgnumber][bbnumber], in);
+		prob.lub(ins[bb], in);
 
 		if (BB_OUT_STATE(bb) != 0)
 			prob.lub(**BB_OUT_STATE(bb), out);
 
 		if (store_out)
-		  prob.lub(*results_out[cfgnumber][bbnumber], out);
+		  prob.lub(outs[bb], out);
 #ifdef HAI_LISTENER_DEBUG
 		cerr << "INFO: " << bb << "\n\tIN = " << in << "\n\tOUT= " << out << "\n";
 #endif
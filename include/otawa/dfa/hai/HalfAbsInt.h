@@ -35,6 +35,7 @@
 #include <otawa/cfg/features.h>
 #include <otawa/prop/Identifier.h>
 #include <otawa/prog/WorkSpace.h>
+#include <otawa/stats/ProcStats.h>
 #ifdef	HAI_JSON
 #	include <otawa/dfa/Debug.h>
 #endif
@@ -536,6 +537,7 @@ int HalfAbsInt<FixPoint>::solve(otawa::CFG *main_cfg, typename FixPoint::Domain
     	HAI_BASE = 0;
 #	endif
 
+	ProcStats::iterate(iterations);
 	return(iterations);
 }
 
@@ -31,6 +31,7 @@ namespace otawa { namespace etime {
 
 class ConfigSet;
 class EdgeTimeBuilder;
+class TimeCache;
 
 class EdgeTimeGraph: public ParExeGraph {
 public:
@@ -57,6 +58,7 @@ protected:
 	virtual void configure(const PropList& props);
 
 	// BBProcessor overload
+	virtual void processWorkSpace(WorkSpace *ws);
 	virtual void setup(WorkSpace *ws);
 	virtual void processBB(WorkSpace *ws, CFG *cfg, Block *bb);
 	virtual void cleanup(WorkSpace *ws);
@@ -69,6 +71,7 @@ protected:
 	virtual void processEdge(WorkSpace *ws, CFG *cfg);
 	virtual void processSequence(void);
 	virtual void clean(ParExeGraph *graph);
+	virtual EdgeTimeBuilder *makeWorker(void);
 	void processTimes(const config_list_t& confs);
 	void applyStrictSplit(const config_list_t& confs);
 	void applyFloppySplit(const config_list_t& confs);
@@ -93,6 +96,33 @@ private:
 		}
 	};
 
+	class result_t {
+	public:
+		inline result_t(void) { }
+		inline result_t(const event_list_t& e, const config_list_t& c, const string& k)
+			: events(e), confs(c), key(k) { }
+		event_list_t events;
+		config_list_t confs;
+		string key;
+	};
+
+	class task_t {
+	public:
+		inline task_t(BasicBlock *s, Edge *e, BasicBlock *t)
+			: source(s), edge(e), target(t) { }
+		BasicBlock *source;
+		Edge *edge;
+		BasicBlock *target;
+		Vector<result_t> results;
+		string error;
+	};
+
+	void processTasks(WorkSpace *ws);
+	void initWorker(EdgeTimeBuilder *master);
+	void runTask(task_t& task);
+	void releaseWorker(void);
+	void produce(const config_list_t& confs, const string& key, bool found);
+	void genForTimes(const config_list_t& confs);
 	void apply(Event *event, ParExeInst *inst);
 	void rollback(Event *event, ParExeInst *inst);
 	EventCollector *get(Event *event);
@@ -102,6 +132,12 @@ private:
 	void sortEvents(event_list_t& events, BasicBlock *bb, place_t place, Edge *edge = 0);
 	void displayConfs(const Vector<ConfigSet>& confs, const event_list_t& events);
 	int countDynEvents(const event_list_t& events);
+	void processIncremental(config_list_t& confs, const Vector<ParExeInst *>& insts);
+	void addTime(config_list_t& confs, ot::time cost, t::uint32 mask);
+	void dumpGraph(ot::time cost);
+	inline void touch(ParExeNode *n) { if(incremental) touched.add(n); }
+	string makeKey(void);
+	string signature(WorkSpace *ws);
 
 	ParExeInst *findInst(Inst *i, ParExeInst *from);
 	ParExeNode *findNode(ParExeInst *i, const hard::PipelineUnit *unit);
@@ -133,7 +169,19 @@ private:
 
 	// configuration
 	bool record;
+	bool incremental;
+	Vector<ParExeNode *> touched;
+	bool use_cache;
+	sys::Path cache_path;
+	TimeCache *cache;
+	string cache_sign;
 	t::uint32 event_mask;
+
+	// parallel computation
+	bool parallel;
+	Vector<task_t *> tasks;
+	EdgeTimeBuilder *master;
+	Vector<result_t> *results;
 };
 
 } }	// otawa::etime
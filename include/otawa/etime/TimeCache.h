@@ -0,0 +1,59 @@
+/*
+ *	TimeCache class interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef OTAWA_ETIME_TIMECACHE_H_
+#define OTAWA_ETIME_TIMECACHE_H_
+
+#include <elm/data/HashMap.h>
+#include <elm/data/Vector.h>
+#include <elm/sys/Path.h>
+#include <otawa/etime/Config.h>
+
+namespace otawa { namespace etime {
+
+class TimeCache {
+public:
+	typedef Vector<ConfigSet> config_list_t;
+
+	TimeCache(void);
+	~TimeCache(void);
+
+	const config_list_t *get(const string& key);
+	inline const config_list_t *find(const string& key) const { return _map.get(key, nullptr); }
+	void put(const string& key, const config_list_t& confs);
+	void clear(void);
+
+	inline int count(void) const { return _map.count(); }
+	inline int hits(void) const { return _hits; }
+	inline int misses(void) const { return _misses; }
+	inline bool isModified(void) const { return _modified; }
+
+	bool load(const sys::Path& path, const string& sign);
+	void save(const sys::Path& path, const string& sign);
+
+private:
+	HashMap<string, config_list_t *> _map;
+	int _hits, _misses;
+	bool _modified;
+};
+
+} }	// otawa::etime
+
+#endif /* OTAWA_ETIME_TIMECACHE_H_ */
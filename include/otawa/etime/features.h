@@ -23,6 +23,7 @@
 
 #include <elm/data/List.h>
 #include <elm/data/Vector.h>
+#include <elm/sys/Path.h>
 #include <otawa/cfg/CFG.h>
 #include <otawa/events/features.h>
 #include <otawa/proc/Feature.h>
@@ -124,6 +125,12 @@ extern p::alias<Event *> PREFIX_EVENT;
 // configuration feature
 extern p::id<bool> PREDUMP;
 extern p::id<int> EVENT_THRESHOLD;
+extern p::id<bool> INCREMENTAL_ANALYSIS;
+extern p::id<bool> TIME_CACHE;
+extern p::id<sys::Path> TIME_CACHE_PATH;
+extern p::id<int> TIME_CACHE_HITS;
+extern p::id<int> TIME_CACHE_MISSES;
+extern p::id<bool> PARALLEL_TIMING;
 extern p::id<bool> RECORD_TIME;
 extern p::feature EDGE_TIME_FEATURE;
 extern p::id<ot::time> LTS_TIME;
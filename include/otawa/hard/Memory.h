@@ -22,6 +22,8 @@
 #ifndef OTAWA_HARD_MEMORY_H
 #define OTAWA_HARD_MEMORY_H
 
+#include <atomic>
+#include <mutex>
 #include <elm/assert.h>
 #include <elm/data/HashMap.h>
 #include <elm/data/Array.h>
@@ -29,6 +31,7 @@
 #include <elm/serial2/collections.h>
 #include <elm/serial2/macros.h>
 #include <elm/sys/Path.h>
+#include <elm/util/Pair.h>
 
 #include <otawa/hard/features.h>
 #include <otawa/prog/Manager.h>
@@ -183,6 +186,8 @@ private:
 public:
 	static const Memory null, full;
 	Memory(bool full = false);
+	Memory(const Memory&) = delete;
+	Memory& operator=(const Memory&) = delete;
 	virtual ~Memory(void);
 
 	inline const AllocArray<const Bank *>& banks(void) const { return _banks; }
@@ -209,8 +214,18 @@ public:
 	inline ot::time worstWriteAccess(void) const { return worstWriteTime(); }
 
 private:
+	typedef struct segment_t {
+		Address::page_t page;
+		t::uint64 base, top;
+		const Bank *bank;
+	} segment_t;
+	void buildIndex(void) const;
+
 	AllocArray<const Bank *> _banks;
 	AllocArray<const Bus *> _buses;
+	mutable AllocArray<segment_t> _index;
+	mutable std::atomic<bool> _indexed;
+	mutable std::mutex _mutex;
 	mutable ot::time _waccess, _wread, _wwrite;
 	mutable ot::time _baccess, _bread, _bwrite;
 };
@@ -218,6 +233,8 @@ private:
 // features
 //extern p::feature MEMORY_FEATURE;
 //extern Identifier<const Memory *> MEMORY;
+extern p::feature ACCESS_TIME_FEATURE;
+extern p::id<Pair<ot::time, ot::time> > ACCESS_TIME;
 
 } // hard
 
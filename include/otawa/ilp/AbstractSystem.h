@@ -22,6 +22,8 @@
 #define OTAWA_ILP_ABSTRACTSYSTEM_H_
 
 #include <elm/data/FragTable.h>
+#include <elm/data/Vector.h>
+#include <elm/PreIterator.h>
 #include <otawa/ilp/Expression.h>
 #include <otawa/ilp/System.h>
 
@@ -46,21 +48,30 @@ public:
 	virtual void setComparator(comparator_t comp);
 	virtual void setLabel(const string& label);
 
-	class TermIter: public Expression::Iter {
+	class TermIter: public PreIterator<TermIter, Term> {
 	public:
-		inline TermIter(AbstractConstraint *cons): Expression::Iter(&cons->_expr) { }
+		TermIter(AbstractConstraint *cons);
+		inline bool ended(void) const { return _p == _e && _i.ended(); }
+		inline Term item(void) const { return _p != _e ? *_p : *_i; }
+		inline void next(void) { if(_p != _e) _p++; else _i.next(); }
+	private:
+		const Term *_p, *_e;
+		Expression::Iter _i;
 	};
 
 	void reset(void) override;
 
 private:
 	friend class AbstractSystem;
+	void unpack(void);
+	const Term *packed(void) const;
 	string _label;
 	Expression _expr;
 	comparator_t _comp;
 	double _cst;
 	int _idx;
 	AbstractSystem *_sys;
+	int _beg, _len;
 };
 
 class AbstractSystem: public System {
@@ -94,6 +105,12 @@ public:
 	Var *newVar(Var::type_t type, const string& name) override;
 	void resetObjectFunction() override;
 	void remove(otawa::ilp::Constraint*) override;
+	void setConstant(Constraint *c, double cst) override;
+	void setCoefficient(Constraint *c, Var *var, double coef) override;
+	void setObjectCoefficient(Var *var, double coef) override;
+	bool snapshot() override;
+	void restore() override;
+	Constraint *addRow(const Term *terms, int n, Constraint::comparator_t comp, double cst = 0, const string& label = "") override;
 
 protected:
 	int index(ilp::Var *var);
@@ -122,6 +139,23 @@ protected:
 
 private:
 
+	typedef enum {
+		CONSTANT,
+		COEFFICIENT,
+		OBJECT
+	} change_t;
+
+	class Change {
+	public:
+		inline Change(): kind(CONSTANT), cons(nullptr), var(nullptr), old(0) { }
+		inline Change(change_t k, AbstractConstraint *c, Var *v, double o)
+			: kind(k), cons(c), var(v), old(o) { }
+		change_t kind;
+		AbstractConstraint *cons;
+		Var *var;
+		double old;
+	};
+
 	friend class AbstractConstraint;
 	void remove(AbstractConstraint *cons);
 	friend class AbstractVar;
@@ -133,6 +167,9 @@ private:
 	bool cleaning;
 	bool _max;
 	List<int> free;
+	Vector<Change> log;
+	Vector<int> marks;
+	Vector<Term> rows;
 };
 
 } }		// otawa::ilp
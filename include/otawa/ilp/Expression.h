@@ -35,6 +35,7 @@ typedef double coef_t;
 
 class Term {
 public:
+	inline Term(void): fst(0), snd(0) { }
 	inline Term(coef_t c, Var *v = 0): fst(v), snd(c) { }
 	inline Term(Var *v, coef_t c = 1.): fst(v), snd(c) { }
 	Var *fst;
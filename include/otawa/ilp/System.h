@@ -72,6 +72,18 @@ public:
 	// 1.3 interface
 	virtual void remove(ilp::Constraint *c) = 0;
 
+	// 1.4 interface
+	virtual void setConstant(Constraint *c, double cst);
+	virtual void setCoefficient(Constraint *c, Var *var, double coef);
+	virtual void setObjectCoefficient(Var *var, double coef);
+	virtual bool snapshot(void);
+	virtual void restore(void);
+	virtual bool isIncremental(void);
+	virtual bool resolve(WorkSpace *ws, otawa::Monitor& mon);
+
+	// 1.5 interface
+	virtual Constraint *addRow(const Term *terms, int n, Constraint::comparator_t comp, double cst = 0, const string& label = "");
+
 	// object function
 	inline void addObject(const Term& t) { addObjectFunction(t.snd, t.fst); }
 	inline void subObject(const Term& t) { addObjectFunction(-t.snd, t.fst); }
@@ -23,6 +23,7 @@
 #define OTAWA_IPET_BASIC_CONSTRAINTS_BUILDER_H
 
 #include <elm/assert.h>
+#include <elm/data/Vector.h>
 #include <otawa/proc/BBProcessor.h>
 #include <otawa/ipet/features.h>
 #include <otawa/ilp/Constraint.h>
@@ -49,6 +50,7 @@ protected:
 	
 private:
 	bool _explicit;
+	Vector<ilp::Term> row;
 	//void addEntryConstraint(ilp::System *system, CFG *caller, Block *bb, CFG *callee, ilp::Var *var);
 };
 
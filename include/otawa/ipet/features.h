@@ -66,6 +66,7 @@ extern p::feature CONTROL_CONSTRAINTS_FEATURE;
 extern Identifier<otawa::ilp::Constraint *> CALLING_CONSTRAINT;
 
 extern p::feature FLOW_FACTS_CONSTRAINTS_FEATURE;
+extern Identifier<otawa::ilp::Constraint *> LOOP_MAX_CONSTRAINT;
 
 extern p::feature FLOW_FACTS_CONFLICT_CONSTRAINTS_FEATURE;  // conflict MDM
 
@@ -247,6 +247,12 @@ namespace otawa {
 		ParExeSequence * _sequence;									// sequence of instructions related to the graph
 		int _capacity;																										// ====== REALLY USEFUL? (used in analyze())
 		bool _explicit;
+		Vector<ParExeNode *> _order;								// nodes in topological order (incremental analysis)
+		Vector<int> _rank;											// rank of nodes in _order by index (incremental analysis)
+		Vector<int> _init;											// initial delays of nodes in _order (incremental analysis)
+
+		int computeCost();
+		inline int rank(ParExeNode *node);
 
 
 		inline string comment(string com)
@@ -287,6 +293,8 @@ namespace otawa {
 		void createSequenceResources();
 		RegResource *newRegResource(const hard::Register *r);
 		int analyze();
+		int analyzeIncremental();
+		int reanalyze(const Vector<ParExeNode *>& changed);
 		virtual void initDelays();
 		void clearDelays();
 		void restoreDefaultLatencies();
@@ -451,6 +459,9 @@ namespace otawa {
 		inline virtual void customDump(io::Output& out) { }
 	};
 
+	inline int ParExeGraph::rank(ParExeNode *node)
+		{ return node->index() < _rank.length() ? _rank[node->index()] : -1; }
+
 	inline bool ParExeGraph::Predecessor::ended(void) const {return iter.ended();}
 	inline ParExeNode *ParExeGraph::Predecessor::item(void) const {return iter->source();}
 	inline void ParExeGraph::Predecessor::next(void) {iter.next();}
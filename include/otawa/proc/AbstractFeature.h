@@ -39,6 +39,7 @@ public:
 	AbstractFeature(cstring name = "");
 	virtual ~AbstractFeature(void);
 	virtual void process(WorkSpace *ws, const PropList& props = PropList::EMPTY) const = 0;
+	virtual Processor *make(void) const;
 	inline bool operator==(const AbstractFeature& f) const { return this == &f; }
 	inline bool operator!=(const AbstractFeature& f) const { return !operator==(f); }
 };
@@ -64,6 +65,7 @@ namespace p {
 		feature(cstring name, p::declare& reg);
 		~feature(void);
 		virtual void process(WorkSpace *ws, const PropList& props) const;
+		virtual Processor *make(void) const;
 	private:
 		AbstractMaker *_maker;
 	};
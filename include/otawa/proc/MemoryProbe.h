@@ -0,0 +1,60 @@
+/*
+ *	MemoryProbe class interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef OTAWA_PROC_MEMORYPROBE_H_
+#define OTAWA_PROC_MEMORYPROBE_H_
+
+#include <atomic>
+#include <elm/types.h>
+
+namespace otawa {
+
+using namespace elm;
+
+class MemoryProbe {
+public:
+
+	class Account {
+	public:
+		std::atomic<t::int64> alloc, used, peak;
+		Account *parent;
+	};
+
+	static bool isAvailable(void);
+	static Account *account(void);
+	static Account *use(Account *account);
+
+	inline MemoryProbe(void): _alloc(0), _peak(0), _running(false) { }
+	inline ~MemoryProbe(void) { if(_running) stop(); }
+	void start(void);
+	void stop(void);
+
+	inline t::int64 allocated(void) const { return _alloc; }
+	inline t::int64 peak(void) const { return _peak; }
+
+private:
+	Account _account;
+	t::int64 _alloc, _peak;
+	bool _running;
+};
+
+}	// otawa
+
+#endif /* OTAWA_PROC_MEMORYPROBE_H_ */
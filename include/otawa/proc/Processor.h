@@ -103,6 +103,10 @@ public:
 
 	// Statistics Properties
 	static p::id<elm::sys::time_t> RUNTIME;
+	static p::id<t::int64> ALLOCATED;
+	static p::id<t::int64> PEAK_MEMORY;
+	static p::id<int> ADDED_PROPS;
+	static p::id<t::int64> ITERATIONS;
 
 	// Deprecated
 	Processor(const PropList& props);
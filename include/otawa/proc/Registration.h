@@ -82,6 +82,7 @@ public:
 	inline const Version& version(void) const { return _version; }
 	inline AbstractRegistration& base(void) const { return *_base; }
 	inline const List<FeatureUsage>& features(void) const { return _feats; }
+	inline bool isConcurrent(void) const { return _concurrent; }
 
 	virtual Processor *make(void) const = 0;
 	bool provides(const AbstractFeature& feature);
@@ -116,6 +117,7 @@ private:
 	List<FeatureUsage> _feats;
 	List<Requirement *> _reqs;
 	int cnt;
+	bool _concurrent;
 };
 
 
@@ -154,9 +156,9 @@ class init {
 	friend class declare;
 public:
 	inline init(string name, Version version)
-		: _name(name), _version(version), _base(0), _maker(0) { }
+		: _name(name), _version(version), _base(0), _maker(0), _concurrent(false) { }
 	inline init(string name, Version version, AbstractRegistration& base)
-		: _name(name), _version(version), _base(&base), _maker(0) { }
+		: _name(name), _version(version), _base(&base), _maker(0), _concurrent(false) { }
 	inline init& require(const AbstractFeature& feature)
 		{ features.add(FeatureUsage(FeatureUsage::require, feature)); return *this; }
 	inline init& require(Requirement& r)
@@ -172,6 +174,7 @@ public:
 	template <class T> inline init& maker(void) { _maker = new Maker<T>(); return *this; }
 	template <class T> inline init& make(void) { _maker = new Maker<T>(); return *this; }
 	template <class T> inline init& extend(void) { _base = &T::reg; return *this; }
+	inline init& concurrent(void) { _concurrent = true; return *this; }
 
 private:
 	string _name;
@@ -181,6 +184,7 @@ private:
 	List<FeatureUsage> features;
 	List<Requirement *> _reqs;
 	AbstractMaker *_maker;
+	bool _concurrent;
 };
 
 
@@ -36,9 +36,11 @@ public:
 protected:
 	virtual void processWorkSpace(WorkSpace *fw);
 	virtual void setup(WorkSpace *fw);
+	virtual void configure(const PropList& props);
 
 private:
 	t::uint32 size;
+	bool concurrent;
 };
 
 } // otawa
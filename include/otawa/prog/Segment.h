@@ -62,6 +62,11 @@ public:
 	Inst *findInstAt(const Address& addr);
 	inline bool contains(const Address& addr) const { return address() <= addr && addr < topAddress(); }
 
+	// Instruction map
+	void makeFlat(int align);
+	inline bool isFlat(void) const { return flat != nullptr; }
+	void decodeAll(int size, bool concurrent = false);
+
 	// ItemIter class	
 	class ItemIter: public PreIterator<ItemIter, ProgItem *> {
 	public:
@@ -100,6 +105,8 @@ private:
 	ot::size _size;
 	inhstruct::DLList _items;
 	ProgItem **map;
+	ProgItem **flat;
+	int flat_shift;
 };
 
 };	// namespace otawa
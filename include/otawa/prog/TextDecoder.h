@@ -33,6 +33,8 @@ public:
 	static TextDecoder _;
 	TextDecoder(void);
 	static Identifier<bool> FOLLOW_PATHS;
+	static Identifier<bool> CONCURRENT;
+	static Identifier<int> FLAT_MAP;
 	virtual void configure(const PropList& props);
 
 protected:
@@ -37,11 +37,13 @@ public:
 
 protected:
 	virtual void processWorkSpace(WorkSpace *fw);
+	virtual void configure(const PropList& props);
 
 private:
 	void processEntry(WorkSpace *ws, address_t address);
 	Inst *getInst(WorkSpace *ws, address_t address, Inst *source = 0);
 	string getBytes(Address addr, int size);
+	int flat_align;
 };
 
 } // otawa
@@ -23,6 +23,8 @@
 #ifndef OTAWA_PROG_WORK_SPACE_H
 #define OTAWA_PROG_WORK_SPACE_H
 
+#include <functional>
+
 #include <elm/data/List.h>
 #include <elm/data/HashMap.h>
 #include <elm/data/Vector.h>
@@ -49,6 +51,7 @@ namespace ast {
 }
 class CFG;
 class CFGInfo;
+class FeatureUsage;
 class File;
 class Inst;
 class Loader;
@@ -76,6 +79,7 @@ public:
 	WorkSpace(Process *_proc);
 	WorkSpace(const WorkSpace *ws);
 	virtual ~WorkSpace(void);
+	WorkSpace *fork(void) const;
 	inline Process *process(void) const { return &proc; };
 
 	// name management
@@ -121,7 +125,10 @@ public:
 	// concurrency support
 	static sys::Thread *run(sys::Runnable& run);
 	static void runAll(sys::Runnable& run);
+	static void forAll(int n, const std::function<void(int)>& f, int grain = 1);
 	static void remove(Property *prop);
+	static int threadCount(void);
+	static void setThreadCount(int n);
 
 	// deprecated
 	ast::ASTInfo *getASTInfo(void);
@@ -135,10 +142,10 @@ private:
 	// new dependency system
 	typedef struct Dependency {
 		Dependency(void);
-		Dependency(Processor *proc, bool del_proc = false);
+		Dependency(Processor *proc, bool del_proc = false, bool shared = false);
 		Processor *_proc;
 		List<struct Dependency *> _users, _used;
-		bool _del_proc;
+		bool _del_proc, _shared;
 	} Dependency ;
 	typedef HashMap<const AbstractFeature *, Dependency *> dep_map_t;
 	dep_map_t dep_map;
@@ -147,12 +154,23 @@ private:
 	void add(Processor *proc, bool del_proc);
 	void remove(Dependency *dep);
 
+	class Scheduler;
+	friend class Scheduler;
+	void prepare(Processor *proc, const PropList& props);
+	void logRequire(Processor *proc, const FeatureUsage *use);
+	void check(Processor *proc);
+	bool commit(Processor *proc, bool del_proc);
+
 	LockPtr<Process> proc;
 	bool cancelled;
 	string _name;
 	sys::Path wdir;
 };
 
+// configuration
+extern p::id<int> THREAD_COUNT;
+extern p::id<bool> PARALLEL_REQUIRE;
+
 };	// otawa
 
 #endif	// OTAWA_PROG_WORK_SPACE_H
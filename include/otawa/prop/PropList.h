@@ -21,6 +21,8 @@
 #ifndef OTAWA_PROP_PROPLIST_H
 #define OTAWA_PROP_PROPLIST_H
 
+#include <atomic>
+#include <cstdint>
 #include <elm/utility.h>
 #include <elm/PreIterator.h>
 #include <elm/util/VarArg.h>
@@ -42,7 +44,7 @@ extern const AbstractIdentifier END;
 // Property description
 class Property {
 	friend class PropList;
-	friend class RCURunnable;
+	friend class TaskPool;
 	friend class WorkSpace;
 public:
 	static const AbstractIdentifier *getID(elm::CString name);
@@ -65,12 +67,23 @@ private:
 
 // PropList class
 class PropList {
-	mutable Property *head;
+	class Index;
+	mutable std::atomic<Property *> head;
+	static const std::uintptr_t INDEXED = 1;
+	inline bool isIndexed(void) const { return (std::uintptr_t(head.load(std::memory_order_acquire)) & INDEXED) != 0; }
+	inline Property *first(void) const {
+		Property *h = head.load(std::memory_order_acquire);
+		return (std::uintptr_t(h) & INDEXED) == 0 ? h : indexedFirst();
+	}
+	Property *indexedFirst(void) const;
+	inline Index *index(void) const { return reinterpret_cast<Index *>(std::uintptr_t(head.load(std::memory_order_acquire)) & ~INDEXED); }
+	void setFirst(Property *prop);
+	void updateIndex(void);
 public:
 	static rtti::Type& __type;
 	static const PropList EMPTY;
-	inline PropList(const PropList& props): head(0) { addProps(props); };
-	inline PropList(void): head(0) { };
+	inline PropList(const PropList& props): head(nullptr) { addProps(props); };
+	inline PropList(void): head(nullptr) { };
 	inline ~PropList(void) { clearProps(); };
 
 	// Property access
@@ -87,6 +100,8 @@ public:
 		{ return getProp(&id) != 0; }
 
 	// Global management
+	static void shareWrites(bool enable);
+	static bool areWritesShared(void);
 	void clearProps(void);
 	void addProps(const PropList& props);
 	void takeProps(PropList& props);
@@ -98,8 +113,8 @@ public:
 	class Iter: public elm::PreIterator<Iter, Property *> {
 	public:
 		inline Iter(void): prop(nullptr) { }
-		inline Iter(const PropList& list): prop(list.head) { }
-		inline Iter(const PropList *list): prop(list->head) { }
+		inline Iter(const PropList& list): prop(list.first()) { }
+		inline Iter(const PropList *list): prop(list->first()) { }
 		inline void next(void) { ASSERT(prop); prop = prop->next(); }
 		inline bool ended(void) const { return prop == 0; }
 		inline Property *item(void) const { ASSERT(prop); return prop; }
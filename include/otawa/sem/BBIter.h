@@ -27,9 +27,18 @@
 
 namespace otawa { namespace sem {
 
+class Cache;
+class Program;
+
 class BBIter: public PreIterator<BBIter, sem::inst> {
 public:
+	BBIter(void);
+	BBIter(const BBIter& it);
+	~BBIter(void);
+	BBIter& operator=(const BBIter& it);
+
 	void start(BasicBlock *bb);
+	void start(BasicBlock *bb, Cache *cache);
 
 	inline bool pathEnd(void) const { return si.pathEnd(); }
 	inline bool isCond(void) const { return si.isFork(); }
@@ -45,9 +54,13 @@ public:
 	void toEnd(void);
 
 private:
+	void release(void);
 	sem::Block b;
 	sem::PathIter si;
 	BasicBlock::InstIter i;
+	Cache *_cache;
+	Program *_prog;
+	int _k;
 };
 
 } }		// otawa::sem
@@ -0,0 +1,91 @@
+/*
+ *	sem::Cache class interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ *	02110-1301  USA
+ */
+#ifndef OTAWA_SEM_CACHE_H_
+#define OTAWA_SEM_CACHE_H_
+
+#include <mutex>
+#include <elm/data/HashMap.h>
+#include <otawa/cfg/BasicBlock.h>
+#include <otawa/proc/Feature.h>
+#include <otawa/sem/inst.h>
+
+namespace otawa { namespace sem {
+
+class Cache;
+
+// Program class
+class Program {
+	friend class Cache;
+public:
+	inline BasicBlock *block(void) const { return _bb; }
+	inline int count(void) const { return _n; }
+	inline const inst *code(int i) const { return _code + _offs[i]; }
+	inline int length(int i) const { return _offs[i + 1] - _offs[i] - 1; }
+	inline int size(void) const { return _offs[_n]; }
+
+private:
+	Program(BasicBlock *bb, const Block& code, const int *offs, int n);
+	~Program(void);
+	BasicBlock *_bb;
+	inst *_code;
+	int *_offs;
+	int _n;
+	int _pins;
+	Program *_prev, *_next;
+};
+
+// Cache class
+class Cache {
+public:
+	Cache(int capacity = 0);
+	~Cache(void);
+
+	Program *use(BasicBlock *bb);
+	void release(Program *prog);
+	void clear(void);
+
+	inline int capacity(void) const { return _cap; }
+	inline int size(void) const { return _size; }
+	inline int count(void) const { return _map.count(); }
+	inline int hits(void) const { return _hits; }
+	inline int misses(void) const { return _misses; }
+
+private:
+	Program *translate(BasicBlock *bb);
+	void unlink(Program *prog);
+	void evict(void);
+
+	HashMap<BasicBlock *, Program *> _map;
+	Program *_first, *_last;
+	int _cap, _size, _hits, _misses;
+	Block _buf;
+	Vector<int> _offs;
+	std::mutex _mutex;
+};
+
+// features
+extern p::interfaced_feature<Cache> COMPILED_SEM_FEATURE;
+extern p::id<int> CACHE_SIZE;
+
+} }		// otawa::sem
+
+#endif /* OTAWA_SEM_CACHE_H_ */
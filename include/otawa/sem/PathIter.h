@@ -32,17 +32,22 @@ namespace sem {
 
 class PathIter: public PreIterator<PathIter, sem::inst> {
 public:
+	inline PathIter(void): bb(nullptr), code(nullptr), pc(0), top(0), more(nullptr) { }
+	PathIter(const PathIter& it);
+	inline ~PathIter(void) { delete bb; delete more; }
+	PathIter& operator=(const PathIter& it);
 
 	void start(Inst *inst);
 	void start(Process *proc);
 	void start(const sem::Block& block);
+	void start(const sem::inst *code);
 
-	inline bool pathEnd(void) const { return bb[pc].op == sem::CONT; }
-	inline bool isCond(void) const { return bb[pc].op == sem::IF; }
-	inline bool isFork(void) const { return bb[pc].op == sem::IF || bb[pc].op == sem::FORK; }
+	inline bool pathEnd(void) const { return at(pc).op == sem::CONT; }
+	inline bool isCond(void) const { return at(pc).op == sem::IF; }
+	inline bool isFork(void) const { return at(pc).op == sem::IF || at(pc).op == sem::FORK; }
 
-	inline bool ended(void) const { return pathEnd() && !todo; }
-	inline sem::inst item(void) const { return bb[pc]; }
+	inline bool ended(void) const { return pathEnd() && top == 0; }
+	inline sem::inst item(void) const { return at(pc); }
 	void next(void);
 
 	inline opcode op(void) const { return opcode(item().op); }
@@ -54,9 +59,18 @@ public:
 	inline elm::t::uint32 addr(void) const { return item().addr(); }
 
 private:
-	sem::Block bb;
-	Vector<int> todo;
+	static const int STACK_SIZE = 8;
+	inline const sem::inst& at(int i) const { return code[i]; }
+	sem::Block& buffer(void);
+	void reset(const sem::inst *code);
+	void push(int i);
+	int pop(void);
+	sem::Block *bb;
+	const sem::inst *code;
 	int pc;
+	int stack[STACK_SIZE];
+	int top;
+	Vector<int> *more;
 };
 
 } }	// otawa::sem
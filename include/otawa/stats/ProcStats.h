@@ -0,0 +1,64 @@
+/*
+ *	ProcStats class interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef OTAWA_STATS_PROCSTATS_H_
+#define OTAWA_STATS_PROCSTATS_H_
+
+#include <elm/data/Vector.h>
+#include <elm/string.h>
+#include <elm/sys/StopWatch.h>
+#include <otawa/prop/Identifier.h>
+
+namespace elm { namespace json { class Saver; } }
+
+namespace otawa {
+
+using namespace elm;
+
+class WorkSpace;
+
+class ProcStats {
+public:
+	static Identifier<ProcStats *> ID;
+
+	typedef struct record_t {
+		string name;
+		sys::time_t time;
+		t::int64 allocated, peak, iterations;
+		int props;
+	} record_t;
+
+	static void add(WorkSpace *ws, const record_t& record);
+	static const Vector<record_t>& get(WorkSpace *ws);
+	static int census(WorkSpace *ws);
+	static void print(WorkSpace *ws, io::Output& out);
+	static void save(WorkSpace *ws, json::Saver& saver);
+
+	static void iterate(int n = 1);
+	static t::int64 iterations(void);
+
+private:
+	Vector<record_t> records;
+};
+
+}	// otawa
+
+#endif /* OTAWA_STATS_PROCSTATS_H_ */
@@ -26,6 +26,7 @@
 #include <otawa/cfg.h>
 #include <otawa/cfg/features.h>
 #include <otawa/prog/sem.h>
+#include <otawa/sem/Cache.h>
 #include <otawa/dfa/State.h>
 
 #define GLOBAL_MEMORY_LOADER true
@@ -96,6 +97,7 @@ private:
 	int bbCount;
 	unsigned int** processBBFreq;
 	unsigned int* processCFGFreq;
+	sem::Cache *cache;
 
 };
 
@@ -46,6 +46,7 @@ p::declare GlobalAnalysis::reg = p::init("otawa::dynbranch::GlobalAnalysis", Ver
 	.require(COLLECTED_CFG_FEATURE)
 	.require(LOOP_INFO_FEATURE)
 	.require(dfa::INITIAL_STATE_FEATURE)
+	.require(sem::COMPILED_SEM_FEATURE)
 	.provide(GLOBAL_ANALYSIS_FEATURE);
 
 /**
@@ -25,6 +25,7 @@
 #include <otawa/dfa/hai/HalfAbsInt.h>
 #include <otawa/dfa/FastState.h>
 #include <otawa/dynbranch/features.h>
+#include <otawa/sem/Cache.h>
 #include <time.h>
 #include "PotentialValue.h"
 #include "State.h"
@@ -46,7 +47,7 @@ namespace otawa { namespace dynbranch {
 Identifier<bool> DEBUG_INFO("otawa::dynbranch::DEBUG_INFO", false) ;
 
 GlobalAnalysisProblem::GlobalAnalysisProblem(WorkSpace* workspace, bool v, Domain & entry, MyGC* m)
-: ws(workspace), verbose(v), myGC(m), _nb_bb_count(0) {
+: ws(workspace), verbose(v), myGC(m), _nb_bb_count(0), cache(sem::COMPILED_SEM_FEATURE.get(workspace)) {
 	istate = dfa::INITIAL_STATE(workspace);
 
 	// initial the BOT state
@@ -213,17 +214,17 @@ void GlobalAnalysisProblem::update(Domain& out, const Domain& in, Block *b) {
 	BasicBlock *bb = b->toBasic();
 
 	// process each instruction in turn
-	for(BasicBlock::InstIter insto(bb) ; insto() ; insto++) {
+	sem::Program *prog = cache->use(bb);
+	for(int k = 0; k < prog->count(); k++) {
 
 		// get semantic instructions
-		sem::Block block;
-		insto->semInsts(block);
+		const sem::inst *code = prog->code(k);
 
 		// process the semantic instruction
-		for(sem::Block::InstIter semi(block) ; semi() ; semi++) {
+		for(int j = 0; j < prog->length(k); j++) {
 			processedSemInstCount++;
 
-			sem::inst inst = *semi ;
+			sem::inst inst = code[j];
 
 			// unsupported instructions without side-effects
 			switch(inst.op) {
@@ -653,6 +654,7 @@ void GlobalAnalysisProblem::update(Domain& out, const Domain& in, Block *b) {
 			} // end switch(inst.op) {
 		} // end of each semantic instruction
 	} // end of each instruction
+	cache->release(prog);
 
 
 } // end of the BB
@@ -19,12 +19,26 @@
  *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <atomic>
+#include <exception>
+#include <typeinfo>
 #include <otawa/etime/EdgeTimeBuilder.h>
 #include <elm/avl/Set.h>
+#include <elm/data/Array.h>
 #include <otawa/etime/features.h>
 #include <elm/data/quicksort.h>
 #include <otawa/etime/Config.h>
 #include <otawa/etime/EventCollector.h>
+#include <otawa/etime/TimeCache.h>
+#include <otawa/hard/CacheConfiguration.h>
+#include <otawa/hard/Memory.h>
+#include <otawa/hard/Processor.h>
+#include <otawa/prog/File.h>
+#include <otawa/prog/Process.h>
+#include <elm/checksum/MD5.h>
+#include <elm/io/BlockInStream.h>
+#include <elm/serial2/TextSerializer.h>
+#include <elm/sys/System.h>
 
 namespace otawa { namespace etime {
 
@@ -353,7 +367,13 @@ EdgeTimeBuilder::EdgeTimeBuilder(p::declare& r)
  	source(0),
  	target(0),
 	record(false),
-	event_mask(0)
+	incremental(false),
+	use_cache(false),
+	cache(nullptr),
+	event_mask(0),
+	parallel(false),
+	master(nullptr),
+	results(nullptr)
 { }
 
 
@@ -363,15 +383,45 @@ void EdgeTimeBuilder::configure(const PropList& props) {
 	predump = PREDUMP(props);
 	event_th = EVENT_THRESHOLD(props);
 	record = RECORD_TIME(props);
+	incremental = INCREMENTAL_ANALYSIS(props);
+	use_cache = TIME_CACHE(props);
+	cache_path = TIME_CACHE_PATH(props);
+	if(cache_path)
+		use_cache = true;
+	parallel = PARALLEL_TIMING(props) && !_do_output_graphs && !logFor(LOG_BLOCK);
 	_props = props;
 }
 
 
+/**
+ */
+void EdgeTimeBuilder::processWorkSpace(WorkSpace *ws) {
+	GraphBBTime<EdgeTimeGraph>::processWorkSpace(ws);
+	if(parallel)
+		processTasks(ws);
+}
+
+
 /**
  */
 void EdgeTimeBuilder::setup(WorkSpace *ws) {
 	sys = ipet::SYSTEM(ws);
-
+	if(WorkSpace::threadCount() <= 1)
+		parallel = false;
+
+	// prepare the time cache (not compatible with graph output)
+	if(use_cache && !_do_output_graphs) {
+		cache = new TimeCache();
+		if(cache_path) {
+			cache_sign = signature(ws);
+			if(cache_sign == "")
+				cache_path = sys::Path();
+			else if(cache->load(cache_path, cache_sign)) {
+				if(logFor(LOG_FUN))
+					log << "\tloaded " << cache->count() << " times from " << cache_path << io::endl;
+			}
+		}
+	}
 }
 
 
@@ -383,6 +433,118 @@ void EdgeTimeBuilder::cleanup(WorkSpace *ws) {
 		delete *coll;
 	}
 	events.clear();
+	for(auto t: tasks)
+		delete t;
+	tasks.clear();
+
+	// record and save the time cache
+	if(cache != nullptr) {
+		if(logFor(LOG_FUN))
+			log << "\ttime cache: " << cache->hits() << " hits, " << cache->misses() << " misses\n";
+		if(recordsStats()) {
+			TIME_CACHE_HITS(*stats) = cache->hits();
+			TIME_CACHE_MISSES(*stats) = cache->misses();
+		}
+		if(cache_path && cache->isModified()) {
+			try {
+				cache->save(cache_path, cache_sign);
+			}
+			catch(sys::SystemException& e) {
+				warn(_ << "cannot save time cache to " << cache_path << ": " << e.message());
+			}
+		}
+		delete cache;
+		cache = nullptr;
+	}
+}
+
+
+/**
+ * Add to the signature the MD5 sum of the serialized form of a hardware
+ * description: this covers all its fields, whatever the way it is described.
+ * @param buf	Buffer to output to.
+ * @param kind	Kind of description.
+ * @param obj	Described object.
+ */
+template <class T>
+static void signObject(StringBuffer& buf, const char *kind, const T& obj) {
+	StringBuffer text;
+	serial2::TextSerializer ser(text);
+	ser << obj;
+	ser.flush();
+	io::BlockInStream in(text.toString());
+	checksum::MD5 md5;
+	md5.put(in);
+	buf << ' ' << kind << '/';
+	md5.print(buf);
+}
+
+
+/**
+ * Compute the signature of the program, of the processor, of the memory
+ * and of the caches identifying the times in a saved time cache.
+ * @param ws	Current workspace.
+ * @return		Signature or empty string if the program cannot be read.
+ */
+string EdgeTimeBuilder::signature(WorkSpace *ws) {
+	StringBuffer buf;
+
+	// program checksum
+	checksum::MD5 md5;
+	try {
+		io::InStream *in = sys::System::readFile(ws->process()->program()->name());
+		md5.put(*in);
+		delete in;
+	}
+	catch(sys::SystemException& e) {
+		warn(_ << "cannot read the program to sign the time cache: " << e.message());
+		return "";
+	}
+	catch(io::IOException& e) {
+		warn(_ << "cannot read the program to sign the time cache: " << e.message());
+		return "";
+	}
+	md5.print(buf);
+
+	// processor description
+	signObject(buf, "P", *hard::PROCESSOR_FEATURE.get(ws));
+
+	// memory description
+	if(ws->provides(hard::MEMORY_FEATURE))
+		signObject(buf, "M", *hard::MEMORY_FEATURE.get(ws));
+
+	// cache description
+	if(ws->provides(hard::CACHE_CONFIGURATION_FEATURE))
+		signObject(buf, "C", *hard::CACHE_CONFIGURATION_FEATURE.get(ws));
+
+	return buf.toString();
+}
+
+
+/**
+ * Build the key identifying the current sequence and its events in the time cache.
+ * @return	Sequence key.
+ */
+string EdgeTimeBuilder::makeKey(void) {
+	StringBuffer buf;
+	for(ParExeSequence::InstIterator inst(seq); inst(); inst++)
+		buf << (inst->codePart() == PROLOGUE ? 'P' : 'B') << inst->inst()->address();
+	for(event_list_t::Iter event(all_events); event(); event++) {
+		Event *evt = (*event).fst;
+		buf << '|' << int((*event).snd) << ':' << evt->inst()->address()
+			<< ':' << int(evt->kind()) << ':' << int(evt->type()) << ':' << int(evt->occurrence())
+			<< ':' << evt->cost() << ':';
+		if(evt->unit() != nullptr)
+			buf << evt->unit()->index();
+		Event::rel_t rel = evt->related();
+		buf << ':';
+		if(rel.fst != nullptr)
+			buf << rel.fst->address();
+		buf << ':';
+		if(rel.snd != nullptr)
+			buf << rel.snd->index();
+	}
+	return buf.toString();
 }
 
 
@@ -403,7 +565,10 @@ void EdgeTimeBuilder::processBB(WorkSpace *ws, CFG *cfg, Block *b) {
 	for(auto p: ps) {
 		source = p.fst;
 		edge = p.snd;
-		processEdge(ws, cfg);
+		if(parallel)
+			tasks.add(new task_t(source, edge, target));
+		else
+			processEdge(ws, cfg);
 	}
 
 #if 0
@@ -527,7 +692,8 @@ void EdgeTimeBuilder::processBB(WorkSpace *ws, CFG *cfg, Block *b) {
  * @return		Built graph.
  */
 EdgeTimeGraph *EdgeTimeBuilder::make(ParExeSequence *seq) {
-	EdgeTimeGraph *graph = new EdgeTimeGraph(this->workspace(), _microprocessor, &_hw_resources, seq, _props);
+	WorkSpace *ws = master != nullptr ? master->workspace() : this->workspace();
+	EdgeTimeGraph *graph = new EdgeTimeGraph(ws, _microprocessor, &_hw_resources, seq, _props);
 	if(_do_output_graphs)
 		graph->setExplicit(true);
 	graph->build();
@@ -544,6 +710,142 @@ void EdgeTimeBuilder::clean(ParExeGraph *graph) {
 }
 
 
+/**
+ * Called to build a worker used to compute the edge times in parallel
+ * (see @ref PARALLEL_TIMING). The worker must have the same behavior as
+ * this builder. As a default, a plain EdgeTimeBuilder is returned but
+ * only if this builder is not a sub-class: the sub-classes have to overload
+ * this function to support parallel computation.
+ * @return	Built worker or null if parallel computation is not supported.
+ */
+EdgeTimeBuilder *EdgeTimeBuilder::makeWorker(void) {
+	if(typeid(*this) != typeid(EdgeTimeBuilder))
+		return nullptr;
+	return new EdgeTimeBuilder();
+}
+
+
+/**
+ * Initialize a worker built by @ref makeWorker(). The worker gets its own
+ * execution graph resources but shares the time cache of the master in
+ * read-only mode.
+ * @param m		Master builder.
+ */
+void EdgeTimeBuilder::initWorker(EdgeTimeBuilder *m) {
+	configure(m->_props);
+	parallel = false;
+	master = m;
+	cache = m->cache;
+	_microprocessor = new ParExeProc(hard::PROCESSOR_FEATURE.get(m->workspace()));
+	BuildVectorOfHwResources();
+	configureMem(m->workspace());
+}
+
+
+/**
+ * Compute, in a worker, the times of the edge of the given task.
+ * The times are only recorded in the task and the ILP system
+ * is not modified.
+ * @param task	Task to process.
+ */
+void EdgeTimeBuilder::runTask(task_t& task) {
+	source = task.source;
+	edge = task.edge;
+	target = task.target;
+	results = &task.results;
+	try {
+		processEdge(master->workspace(), target->cfg());
+	}
+	catch(elm::Exception& e) {
+		task.error = _ << "edge " << edge << ": " << e.message();
+	}
+	catch(std::exception& e) {
+		task.error = _ << "edge " << edge << ": " << e.what();
+	}
+	catch(...) {
+		task.error = _ << "edge " << edge << ": unknown exception";
+	}
+	results = nullptr;
+}
+
+
+/**
+ * Release the execution graph resources built by @ref initWorker().
+ */
+void EdgeTimeBuilder::releaseWorker(void) {
+	for(auto r: _hw_resources)
+		delete r;
+	_hw_resources.clear();
+	delete _microprocessor;
+	_microprocessor = nullptr;
+}
+
+
+/**
+ * Compute in parallel the times of the edges collected by processBB()
+ * and then generate the ILP in the same order as the sequential
+ * computation: the produced ILP system does not depend on the number
+ * of used threads.
+ * @param ws	Current workspace.
+ */
+void EdgeTimeBuilder::processTasks(WorkSpace *ws) {
+
+	// build the workers
+	int k = min(WorkSpace::threadCount(), tasks.length());
+	Vector<EdgeTimeBuilder *> workers;
+	for(int i = 0; i < k; i++) {
+		EdgeTimeBuilder *worker = makeWorker();
+		if(worker == nullptr)
+			break;
+		worker->initWorker(this);
+		workers.add(worker);
+	}
+	if(logFor(LOG_FUN))
+		log << "\tcomputing " << tasks.length() << " edge times with " << workers.length() << " workers\n";
+
+	// compute the times
+	if(workers) {
+		std::atomic<int> next(0);
+		int n = tasks.length();
+		try {
+			WorkSpace::forAll(workers.length(), [this, &workers, &next, n](int w) {
+				for(int i = next++; i < n; i = next++)
+					workers[w]->runTask(*tasks[i]);
+			});
+		}
+		catch(...) {
+			for(auto worker: workers) {
+				worker->releaseWorker();
+				delete worker;
+			}
+			throw;
+		}
+		for(auto worker: workers) {
+			worker->releaseWorker();
+			delete worker;
+		}
+	}
+
+	// generate the ILP in order
+	for(auto task: tasks) {
+		source = task->source;
+		edge = task->edge;
+		target = task->target;
+		if(!workers)
+			processEdge(ws, target->cfg());
+		else {
+			if(!task->error.isEmpty())
+				throw ProcessorException(*this, task->error);
+			for(const auto& r: task->results) {
+				all_events = r.events;
+				bool found = cache != nullptr && cache->get(r.key) != nullptr;
+				produce(r.confs, r.key, found);
+			}
+		}
+	}
+}
+
+
 /**
  */
 void EdgeTimeBuilder::processEdge(WorkSpace *ws, CFG *cfg) {
@@ -699,6 +1001,19 @@ void EdgeTimeBuilder::processSequence(void) {
 				<< " -> " << (*e).fst->name() << " (" << (*e).fst->detail() << ") "
 				<< (*e).snd << io::endl;
 
+	// look in the time cache
+	string key;
+	if(cache != nullptr) {
+		key = makeKey();
+		const TimeCache::config_list_t *confs = master != nullptr ? cache->find(key) : cache->get(key);
+		if(confs != nullptr) {
+			if(logFor(LOG_BB))
+				log << "\t\t\t\tfound in time cache\n";
+			produce(*confs, key, true);
+			return;
+		}
+	}
+
 	// build the graph
 	PropList props;
 	graph = make(seq);
@@ -753,7 +1068,10 @@ void EdgeTimeBuilder::processSequence(void) {
 
 		// analyze
 		ot::time cost = graph->analyze();
-		genForOneCost(cost, edge, events);
+		config_list_t confs;
+		confs.add(ConfigSet(cost));
+		confs[0].add(Config());
+		produce(confs, key, false);
 
 		// dump it if needed
 		if(_do_output_graphs) {
@@ -768,65 +1086,175 @@ void EdgeTimeBuilder::processSequence(void) {
 	}
 
 	// compute all cases
-	t::uint32 prev = 0;
 	Vector<ConfigSet> confs;
 	custom.clear();
-	for(event_mask = 0; event_mask < t::uint32(1 << events.count()); event_mask++) {
-
-		// adjust the graph
-		for(int i = 0; i < events.count(); i++) {
-			if((prev & (1 << i)) != (event_mask & (1 << i))) {
-				if(event_mask & (1 << i))
-					apply(events[i].fst, insts[i]);
-				else
-					rollback(events[i].fst, insts[i]);
+	if(incremental)
+		processIncremental(confs, insts);
+	else {
+		t::uint32 prev = 0;
+		for(event_mask = 0; event_mask < t::uint32(1 << events.count()); event_mask++) {
+
+			// adjust the graph
+			for(int i = 0; i < events.count(); i++) {
+				if((prev & (1 << i)) != (event_mask & (1 << i))) {
+					if(event_mask & (1 << i))
+						apply(events[i].fst, insts[i]);
+					else
+						rollback(events[i].fst, insts[i]);
+				}
 			}
-		}
-		prev = event_mask;
+			prev = event_mask;
 
-		// predump implementation
-		if(_do_output_graphs && predump)
-			outputGraph(graph, 666, 666, 666, _ << source << " -> " << target);
+			// predump implementation
+			if(_do_output_graphs && predump)
+				outputGraph(graph, 666, 666, 666, _ << source << " -> " << target);
 
-		// compute and store the new value
-		ot::time cost = graph->analyze();
+			// compute and store the new value
+			ot::time cost = graph->analyze();
 
-		// dump it if needed
-		if(_do_output_graphs) {
-			if (source)
-				outputGraph(graph, target->index(), source->index(), event_mask,
-						_ << source << " -> " << target << " (cost = " << cost << ")");
-			else
-				outputGraph(graph, target->index(), 0, event_mask, _ << target << " (cost = " << cost << ")");
-		}
+			// dump it if needed
+			if(_do_output_graphs)
+				dumpGraph(cost);
 
-		// add the new time
-		int j;
-		for(j = 0; j < confs.length(); j++)
-			if(cost == confs[j].time())
-				break;
-			else if(cost < confs[j].time()) {
-				confs.insert(j, ConfigSet(cost));
-				break;
-			}
-		if(j >= confs.length())
-			confs.add(ConfigSet(cost));
-		confs[j].add(Config(event_mask));
+			// add the new time
+			addTime(confs, cost, event_mask);
+		}
 	}
 
 	//if(isVerbose())
 	if(logFor(LOG_BB))
 		displayConfs(confs, events);
 	delete graph;
+	produce(confs, key, false);
+}
 
-	// trivial case: 1 time
-	if(confs.length() == 1) {
-		genForOneCost(confs[0].time(), edge, all_events);
+
+/**
+ * Called when the times of the current sequence are computed or found in the
+ * time cache. In sequential mode, they are stored in the cache and the ILP is
+ * generated. In a worker, they are only recorded to be later
+ * used by the master.
+ * @param confs		Configuration sets sorted by increasing time.
+ * @param key		Key of the sequence in the time cache.
+ * @param found		True if the times come from the time cache.
+ */
+void EdgeTimeBuilder::produce(const config_list_t& confs, const string& key, bool found) {
+	if(master != nullptr) {
+		results->add(result_t(all_events, confs, key));
 		return;
 	}
+	if(cache != nullptr && !found)
+		cache->put(key, confs);
+	genForTimes(confs);
+}
+
+
+/**
+ * Generate the ILP for the times of the current sequence whose events
+ * are in all_events.
+ * @param confs		Configuration sets sorted by increasing time.
+ */
+void EdgeTimeBuilder::genForTimes(const config_list_t& confs) {
+	events.clear();
+	for(event_list_t::Iter event(all_events); event(); event++)
+		if((*event).fst->occurrence() == SOMETIMES)
+			events.add(*event);
+
+	// trivial cases: no event or 1 time
+	if(events.isEmpty())
+		genForOneCost(confs[0].time(), edge, events);
+	else if(confs.length() == 1)
+		genForOneCost(confs[0].time(), edge, all_events);
 
 	// generate constraints
-	processTimes(confs);
+	else
+		processTimes(confs);
+}
+
+
+/**
+ * Compute the times of all event configurations in incremental way.
+ * The configurations are visited in Gray code order so that only one
+ * event is applied or rolled back at each step and only the part of the
+ * execution graph after the nodes changed by this event is re-computed.
+ * As the events are sorted in program order, the last events are changed
+ * the most often. The obtained times are the same as the ones computed
+ * with a full analysis of each configuration.
+ * @param confs		To store configuration times in.
+ * @param insts		Instructions matching the dynamic events.
+ */
+void EdgeTimeBuilder::processIncremental(config_list_t& confs, const Vector<ParExeInst *>& insts) {
+	int n = events.count();
+	AllocArray<ot::time> costs(1 << n);
+	event_mask = 0;
+	for(t::uint32 k = 0; k < t::uint32(1 << n); k++) {
+
+		// flip the event matching the lowest one bit of k
+		if(k != 0) {
+			int i = n - 1;
+			for(t::uint32 b = k; !(b & 1); b >>= 1)
+				i--;
+			touched.clear();
+			if(event_mask & (1 << i))
+				rollback(events[i].fst, insts[i]);
+			else
+				apply(events[i].fst, insts[i]);
+			event_mask ^= 1 << i;
+		}
+
+		// predump implementation
+		if(_do_output_graphs && predump)
+			outputGraph(graph, 666, 666, 666, _ << source << " -> " << target);
+
+		// compute the new value
+		if(k == 0)
+			costs[event_mask] = graph->analyzeIncremental();
+		else
+			costs[event_mask] = graph->reanalyze(touched);
+
+		// dump it if needed
+		if(_do_output_graphs)
+			dumpGraph(costs[event_mask]);
+	}
+
+	// store the times in configuration order
+	for(t::uint32 m = 0; m < t::uint32(1 << n); m++)
+		addTime(confs, costs[m], m);
+}
+
+
+/**
+ * Add the time of a configuration to the configuration list
+ * (sorted by increasing time).
+ * @param confs		Configuration list.
+ * @param cost		Time of the configuration.
+ * @param mask		Configuration mask.
+ */
+void EdgeTimeBuilder::addTime(config_list_t& confs, ot::time cost, t::uint32 mask) {
+	int j;
+	for(j = 0; j < confs.length(); j++)
+		if(cost == confs[j].time())
+			break;
+		else if(cost < confs[j].time()) {
+			confs.insert(j, ConfigSet(cost));
+			break;
+		}
+	if(j >= confs.length())
+		confs.add(ConfigSet(cost));
+	confs[j].add(Config(mask));
+}
+
+
+/**
+ * Dump the current execution graph for the current event mask.
+ * @param cost	Computed cost.
+ */
+void EdgeTimeBuilder::dumpGraph(ot::time cost) {
+	if (source)
+		outputGraph(graph, target->index(), source->index(), event_mask,
+				_ << source << " -> " << target << " (cost = " << cost << ")");
+	else
+		outputGraph(graph, target->index(), 0, event_mask, _ << target << " (cost = " << cost << ")");
 }
 
 
@@ -1006,6 +1434,7 @@ void EdgeTimeBuilder::apply(Event *event, ParExeInst *inst) {
 		switch (event->type()) {
 		case LOCAL:
 			inst->fetchNode()->setLatency(inst->fetchNode()->latency() + event->cost());
+			touch(inst->fetchNode());
 			break;
 
 		case AFTER:
@@ -1035,6 +1464,7 @@ void EdgeTimeBuilder::apply(Event *event, ParExeInst *inst) {
 					for (ParExeGraph::Successor succ(*rel_node); succ(); ++succ)
 						if (*succ == inst->fetchNode() && succ.edge()->type() == edge_type) {
 							succ.edge()->setLatency(succ.edge()->latency() + event->cost());
+							touch(*rel_node);
 							edge_found = true;
 							break;
 						}
@@ -1066,6 +1496,7 @@ void EdgeTimeBuilder::apply(Event *event, ParExeInst *inst) {
 					continue;
 				}
 				node->setLatency(node->latency() + event->cost() - 1);
+				touch(*node);
 				found = true;
 				break;
 			}
@@ -1090,6 +1521,7 @@ void EdgeTimeBuilder::apply(Event *event, ParExeInst *inst) {
 					for (ParExeGraph::Successor succ(*rel_node); succ(); ++succ) {
 						if (*succ == inst->execNode() && succ.edge()->type() == edge_type) {
 							succ.edge()->setLatency(succ.edge()->latency() + event->cost());
+							touch(*rel_node);
 							IN_ASSERT(edge_found = true);
 							break;
 						}
@@ -1101,6 +1533,7 @@ void EdgeTimeBuilder::apply(Event *event, ParExeInst *inst) {
 
 		if(!found && inst->execNode()) {
 			inst->execNode()->setLatency(inst->execNode()->latency() + event->cost() - 1);
+			touch(inst->execNode());
 			found = true;
 		}
 
@@ -1115,6 +1548,7 @@ void EdgeTimeBuilder::apply(Event *event, ParExeInst *inst) {
 			if(b != nullptr) {
 				bedge =  new ParExeEdge(getBranchNode(), inst->fetchNode(), ParExeEdge::SOLID, 0, pred_msg);
 				bedge->setLatency(event->cost());
+				touch(b);
 			}
 			else {
 				addLatency(inst->fetchNode(), event->cost());
@@ -1137,6 +1571,7 @@ void EdgeTimeBuilder::apply(Event *event, ParExeInst *inst) {
 				if(m != nullptr) {
 					ParExeEdge *e = new ParExeEdge(m, n, ParExeEdge::SOLID, event->cost(), event->name());
 					custom.put(event, e);
+					touch(m);
 				}
 			}
 			break;
@@ -1145,6 +1580,7 @@ void EdgeTimeBuilder::apply(Event *event, ParExeInst *inst) {
 				ParExeNode *m = findNode(event->related(), inst);
 				ParExeEdge *e = new ParExeEdge(m, n, ParExeEdge::SLASHED, event->cost(), event->name());
 				custom.put(event, e);
+				touch(m);
 			}
 			break;
 		}
@@ -1170,6 +1606,7 @@ void EdgeTimeBuilder::rollback(Event *event, ParExeInst *inst) {
 		switch (event->type()) {
 		case LOCAL:
 			inst->fetchNode()->setLatency(inst->fetchNode()->latency() - event->cost());
+			touch(inst->fetchNode());
 			break;
 
 		case AFTER:
@@ -1199,6 +1636,7 @@ void EdgeTimeBuilder::rollback(Event *event, ParExeInst *inst) {
 					for (ParExeGraph::Successor succ(*rel_node); succ(); ++succ)
 						if (*succ == inst->fetchNode() && succ.edge()->type() == edge_type) {
 							succ.edge()->setLatency(succ.edge()->latency() - event->cost());
+							touch(*rel_node);
 							edge_found = true;
 							break;
 						}
@@ -1229,6 +1667,7 @@ void EdgeTimeBuilder::rollback(Event *event, ParExeInst *inst) {
 					continue;
 				}
 				node->setLatency(node->latency() - event->cost() + 1);
+				touch(*node);
 				found = true;
 				break;
 			}
@@ -1253,6 +1692,7 @@ void EdgeTimeBuilder::rollback(Event *event, ParExeInst *inst) {
 					for (ParExeGraph::Successor succ(*rel_node); succ(); ++succ) {
 						if (*succ == inst->execNode() && succ.edge()->type() == edge_type) {
 							succ.edge()->setLatency(succ.edge()->latency() - event->cost());
+							touch(*rel_node);
 							IN_ASSERT(edge_found = true);
 							break;
 						}
@@ -1264,6 +1704,7 @@ void EdgeTimeBuilder::rollback(Event *event, ParExeInst *inst) {
 
 		if(!found && inst->execNode()) {
 			inst->execNode()->setLatency(inst->execNode()->latency() - event->cost() + 1);
+			touch(inst->execNode());
 			found = true;
 		}
 		break;
@@ -1271,6 +1712,7 @@ void EdgeTimeBuilder::rollback(Event *event, ParExeInst *inst) {
 
 	case BRANCH:
 		if(bedge != nullptr) {
+			touch(bedge->source());
 			graph->remove(bedge);
 			bedge = 0;
 		}
@@ -1287,8 +1729,13 @@ void EdgeTimeBuilder::rollback(Event *event, ParExeInst *inst) {
 			}
 			break;
 		case AFTER:
-		case NOT_BEFORE:
-			graph->remove(custom.get(event));
+		case NOT_BEFORE: {
+				ParExeEdge *e = custom.get(event, nullptr);
+				if(e != nullptr) {
+					touch(e->source());
+					graph->remove(e);
+				}
+			}
 			break;
 		}
 		break;
@@ -1358,6 +1805,7 @@ void EdgeTimeBuilder::addLatency(ParExeNode *n, int l) {
 		n->setLatency(l);
 	else
 		n->setLatency(n->latency() + l);
+	touch(n);
 }
 
 
@@ -1371,6 +1819,7 @@ void EdgeTimeBuilder::removeLatency(ParExeNode *n, int l) {
 		n->setLatency(1);
 	else
 		n->setLatency(n->latency() - l);
+	touch(n);
 }
 
 
@@ -1744,9 +2193,17 @@ void EdgeTimeBuilder::contributeConst(void) {
  * @p Configuration
  * @li @ref EVENT_THRESHOLD
  * @li @ref GRAPHS_OUTPUT_DIRECTORY
+ * @li @ref INCREMENTAL_ANALYSIS
  * @li @ref ONLY_START
+ * @li @ref PARALLEL_TIMING
  * @li @ref PREDUMP
  * @li @ref RECORD_TIME
+ * @li @ref TIME_CACHE
+ * @li @ref TIME_CACHE_PATH
+ *
+ * @p Statistics
+ * @li @ref TIME_CACHE_HITS
+ * @li @ref TIME_CACHE_MISSES
  *
  * @p Properties
  * @li @ref LTS_TIME
@@ -1806,4 +2263,70 @@ p::id<bool> PREDUMP("otawa::etime::PREDUMP", false);
  */
 p::id<int> EVENT_THRESHOLD("otawa::etime::EVENT_THRESHOLD", 15);
 
+
+/**
+ * This property is used to configure the @ref EDGE_TIME_FEATURE. If set to true,
+ * the 2^n event configurations of a block are computed incrementally: they are
+ * visited in Gray code order and, at each step, only the part of the execution graph
+ * depending on the changed event is re-computed. The produced times are the same
+ * as without this option.
+ * @ingroup etime
+ */
+p::id<bool> INCREMENTAL_ANALYSIS("otawa::etime::INCREMENTAL_ANALYSIS", false);
+
+
+/**
+ * This property is used to configure the @ref EDGE_TIME_FEATURE. If set to true,
+ * the times computed for an instruction sequence are stored in a cache and
+ * re-used, instead of building and analyzing the execution graph again,
+ * when the same instruction sequence is found with the same events
+ * (typically after inlining of functions by virtualization).
+ * The cache is not used when the execution graphs are dumped.
+ * @ingroup etime
+ */
+p::id<bool> TIME_CACHE("otawa::etime::TIME_CACHE", false);
+
+
+/**
+ * This property is used to configure the @ref EDGE_TIME_FEATURE. It gives
+ * the path of a file used to load the time cache before the analysis and
+ * to save it after. The file is only loaded if it has been produced for the same
+ * program and the same processor, memory and cache descriptions (checked by
+ * MD5 sums of the program file and of the serialized descriptions). Setting
+ * this property activates @ref TIME_CACHE.
+ * @ingroup etime
+ */
+p::id<sys::Path> TIME_CACHE_PATH("otawa::etime::TIME_CACHE_PATH", "");
+
+
+/**
+ * Statistics recorded by @ref EDGE_TIME_FEATURE in @ref Processor::STATS when
+ * the time cache is used: number of instruction sequences found in the cache.
+ * @ingroup etime
+ */
+p::id<int> TIME_CACHE_HITS("otawa::etime::TIME_CACHE_HITS", 0);
+
+
+/**
+ * Statistics recorded by @ref EDGE_TIME_FEATURE in @ref Processor::STATS when
+ * the time cache is used: number of instruction sequences not found in the cache
+ * (and therefore computed).
+ * @ingroup etime
+ */
+p::id<int> TIME_CACHE_MISSES("otawa::etime::TIME_CACHE_MISSES", 0);
+
+
+/**
+ * This property is used to configure the @ref EDGE_TIME_FEATURE. If set to true,
+ * the times of the edges are computed in parallel by the threads of the work space
+ * (see @ref WorkSpace::forAll()) and the ILP is generated afterwards in the order
+ * of the sequential computation: the produced ILP system is the same whatever
+ * the number of threads.
+ *
+ * The parallel computation is disabled if there is only one thread, if the execution
+ * graphs are output or if the log level is @ref Processor::LOG_BLOCK or more.
+ * @ingroup etime
+ */
+p::id<bool> PARALLEL_TIMING("otawa::etime::PARALLEL_TIMING", false);
+
 } }	// otawa::etime
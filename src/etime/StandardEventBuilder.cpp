@@ -404,7 +404,11 @@ public:
 
 				// compute access time
 				ot::time t;
-				if(i->isStore())
+				if(hard::ACCESS_TIME(i).exists()) {
+					Pair<ot::time, ot::time> r = hard::ACCESS_TIME(i);
+					t = n * r.snd;
+				}
+				else if(i->isStore())
 					t = n * memory()->worstWriteTime();
 				else
 					t = n * memory()->worstReadTime();
@@ -0,0 +1,273 @@
+/*
+ *	TimeCache class implementation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/io/FileInput.h>
+#include <elm/io/FileOutput.h>
+#include <elm/sys/System.h>
+#include <otawa/base.h>
+#include <otawa/prop/Identifier.h>
+#include <otawa/etime/TimeCache.h>
+
+namespace otawa { namespace etime {
+
+static cstring VERSION = "otawa-etime-cache 1";
+
+/**
+ * Free the configuration lists of a map.
+ * @param map	Map to free.
+ */
+static void freeAll(HashMap<string, TimeCache::config_list_t *>& map) {
+	for(HashMap<string, TimeCache::config_list_t *>::Iter confs(map); confs(); confs++)
+		delete *confs;
+	map.clear();
+}
+
+/**
+ * @class TimeCache
+ * Cache of the times computed for an instruction sequence with execution graphs.
+ * The cache is indexed by a textual key identifying the sequence and its events
+ * (see @ref EdgeTimeBuilder) and stores the list of configuration sets
+ * sorted by increasing time. When the same sequence with the same events
+ * is found again, for example after inlining of functions, the stored
+ * configuration list can be used instead of building and analyzing
+ * the execution graph again.
+ *
+ * The cache may be saved to and loaded from a file. The file is marked
+ * by a signature string, provided by the user, that must identify the
+ * program and the processor configuration the times have been computed for:
+ * a file with a different signature is ignored.
+ *
+ * @ingroup etime
+ */
+
+/**
+ */
+TimeCache::TimeCache(void): _hits(0), _misses(0), _modified(false) {
+}
+
+/**
+ */
+TimeCache::~TimeCache(void) {
+	clear();
+}
+
+/**
+ * Look for the times of the given key. Each call records
+ * a hit or a miss.
+ * @param key	Looked key.
+ * @return		Found configuration list or null.
+ */
+const TimeCache::config_list_t *TimeCache::get(const string& key) {
+	config_list_t *confs = _map.get(key, nullptr);
+	if(confs != nullptr)
+		_hits++;
+	else
+		_misses++;
+	return confs;
+}
+
+/**
+ * @fn const config_list_t *TimeCache::find(const string& key) const;
+ * Look for the times of the given key without recording hit or miss.
+ * As the cache is not modified, this function may be called concurrently
+ * as long as no @ref put() is performed.
+ * @param key	Looked key.
+ * @return		Found configuration list or null.
+ */
+
+/**
+ * Store the times for the given key.
+ * @param key		Key of the sequence.
+ * @param confs		Configuration sets sorted by increasing time.
+ */
+void TimeCache::put(const string& key, const config_list_t& confs) {
+	config_list_t *old = _map.get(key, nullptr);
+	if(old != nullptr)
+		delete old;
+	config_list_t *copy = new config_list_t();
+	for(int i = 0; i < confs.length(); i++)
+		copy->add(confs[i]);
+	_map.put(key, copy);
+	_modified = true;
+}
+
+/**
+ * Remove all entries of the cache.
+ */
+void TimeCache::clear(void) {
+	freeAll(_map);
+}
+
+/**
+ * Parse a decimal integer of a cache file.
+ * @param str	String to parse.
+ * @param v		Parsed value.
+ * @return		True if the string is a valid integer, false else.
+ */
+template <class T>
+static bool parse(const string& str, T& v) {
+	if(str == "" || str == "-")
+		return false;
+	for(int i = 0; i < str.length(); i++)
+		if((str[i] < '0' || str[i] > '9') && (i != 0 || str[i] != '-'))
+			return false;
+	try {
+		from_string(str, v);
+	}
+	catch(io::IOException& e) {
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Read the entries of a cache file.
+ * @param in	Input stream.
+ * @param sign	Expected signature.
+ * @param map	Map to store the entries in.
+ * @return		True if the file is valid, false else.
+ */
+static bool readEntries(io::FileInput& in, const string& sign, HashMap<string, TimeCache::config_list_t *>& map) {
+
+	// check the header
+	if(in.scanLine() != _ << VERSION << "\n")
+		return false;
+	if(in.scanLine() != _ << sign << "\n")
+		return false;
+
+	// read the entries: KEY \t TIME : MASK , MASK ... ; TIME : ...
+	while(true) {
+		string line = in.scanLine();
+		if(line == "")
+			break;
+		if(line[line.length() - 1] != '\n')
+			return false;
+		line = line.substring(0, line.length() - 1);
+		int p = line.indexOf('\t');
+		if(p < 0)
+			return false;
+		string key = line.substring(0, p);
+		string rest = line.substring(p + 1);
+		TimeCache::config_list_t *confs = new TimeCache::config_list_t();
+		TimeCache::config_list_t *old = map.get(key, nullptr);
+		if(old != nullptr)
+			delete old;
+		map.put(key, confs);
+		while(rest != "") {
+			p = rest.indexOf(';');
+			string set = p < 0 ? rest : rest.substring(0, p);
+			rest = p < 0 ? string() : rest.substring(p + 1);
+			int q = set.indexOf(':');
+			if(q < 0)
+				return false;
+			ot::time time;
+			if(!parse(set.substring(0, q), time))
+				return false;
+			ConfigSet cset(time);
+			set = set.substring(q + 1);
+			while(set != "") {
+				q = set.indexOf(',');
+				t::uint32 bits;
+				if(!parse(q < 0 ? set : set.substring(0, q), bits))
+					return false;
+				cset.add(Config(bits));
+				set = q < 0 ? string() : set.substring(q + 1);
+			}
+			confs->add(cset);
+		}
+	}
+	return true;
+}
+
+/**
+ * Load the cache from the given file. Invalid file or file with
+ * a different signature are ignored. The file is first read apart and its
+ * entries are only added to the cache if the whole file is valid.
+ * @param path	Path of the file.
+ * @param sign	Signature of the program and of the processor.
+ * @return		True if the file has been loaded, false else.
+ */
+bool TimeCache::load(const sys::Path& path, const string& sign) {
+	if(!path.exists())
+		return false;
+
+	// read the file apart
+	HashMap<string, config_list_t *> map;
+	bool ok;
+	try {
+		io::FileInput in(path);
+		ok = readEntries(in, sign, map);
+	}
+	catch(sys::SystemException& e) {
+		ok = false;
+	}
+	catch(io::IOException& e) {
+		ok = false;
+	}
+	if(!ok) {
+		freeAll(map);
+		return false;
+	}
+
+	// commit the entries
+	for(HashMap<string, config_list_t *>::PairIter e(map); e(); e++) {
+		config_list_t *old = _map.get((*e).fst, nullptr);
+		if(old != nullptr)
+			delete old;
+		_map.put((*e).fst, (*e).snd);
+	}
+	map.clear();
+	_modified = false;
+	return true;
+}
+
+/**
+ * Save the cache to the given file.
+ * @param path	Path of the file.
+ * @param sign	Signature of the program and of the processor.
+ * @throw sys::SystemException	If the file cannot be created.
+ */
+void TimeCache::save(const sys::Path& path, const string& sign) {
+	io::FileOutput out(path);
+	out << VERSION << io::endl;
+	out << sign << io::endl;
+	for(HashMap<string, config_list_t *>::PairIter e(_map); e(); e++) {
+		out << (*e).fst << '\t';
+		const config_list_t& confs = *(*e).snd;
+		for(int i = 0; i < confs.length(); i++) {
+			if(i != 0)
+				out << ';';
+			out << confs[i].time() << ':';
+			bool fst = true;
+			for(ConfigSet::Iter conf(confs[i]); conf(); conf++) {
+				if(fst)
+					fst = false;
+				else
+					out << ',';
+				out << (*conf).bits();
+			}
+		}
+		out << io::endl;
+	}
+	_modified = false;
+}
+
+} }	// otawa::etime
@@ -22,6 +22,7 @@
 #ifndef OTAWA_ICAT3_MAYDOMAIN_H_
 #define OTAWA_ICAT3_MAYDOMAIN_H_
 
+#include <otawa/cache/AgeKernels.h>
 #include <otawa/icat3/features.h>
 
 namespace otawa { namespace icat3 {
@@ -39,7 +40,7 @@ public:
 	inline bool contains(const t& a, int i) { return(a[i] != BOT_AGE); }
 	inline void copy(t& d, const t& s) { d.copy(s); }
 	inline bool equals(const t& a, const t& b)
-		{ for(int i = 0; i < n; i++) if(a[i] != b[i]) return false; return true; }
+		{ return cache::equalAges(&a[0], &b[0], n); }
 	void join(t& d, const t& s);
 	void fetch(t& a, const LBlock *lb);
 	void update(const icache::Access& access, t& a);
@@ -22,6 +22,8 @@
 #ifndef OTAWA_ICAT3_MUSTPERSDOMAIN_H_
 #define OTAWA_ICAT3_MUSTPERSDOMAIN_H_
 
+#include <elm/data/HashMap.h>
+#include <otawa/cache/AgeKernels.h>
 #include <otawa/cfg.h>
 #include <otawa/icat3/features.h>
 
@@ -124,12 +126,12 @@ public:
 	void leaveLoop(t& a);
 
 private:
-	static p::id<int> DEPTH;
 	MustDomain _must;
 	PersDomain _pers;
 	int n;
 	t _bot, _top;
 	t _init;
+	HashMap<Block *, int> _depth;
 };
 
 } }		// otawa::icat3
@@ -0,0 +1,44 @@
+/*
+ *	SetScheduler class interface
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	This file is part of OTAWA
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ *	02110-1301  USA
+ */
+#ifndef OTAWA_ICAT3_SETSCHEDULER_H_
+#define OTAWA_ICAT3_SETSCHEDULER_H_
+
+#include <functional>
+#include <elm/data/Vector.h>
+#include <otawa/icat3/features.h>
+
+namespace otawa { namespace icat3 {
+
+class SetScheduler {
+public:
+	typedef std::function<void(int)> fun_t;
+	SetScheduler(const LBlockCollection& coll);
+	void run(fun_t f, bool concurrent = true);
+	inline int count(void) const { return _sets.count(); }
+private:
+	const LBlockCollection& _coll;
+	Vector<int> _sets, _order;
+};
+
+} }		// otawa::icat3
+
+#endif /* OTAWA_ICAT3_SETSCHEDULER_H_ */
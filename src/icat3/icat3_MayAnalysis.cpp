@@ -28,6 +28,7 @@
 #include <otawa/icat3/features.h>
 #include "../../include/otawa/ai/RankingAI.h"
 #include "MayDomain.h"
+#include "SetScheduler.h"
 
 
 namespace otawa { namespace icat3 {
@@ -58,11 +59,8 @@ void MayDomain::join(t& d, const t& s) {
 	// J(a, a') = a" s.t.
 
 	// ∀ b ∈ B_s, a"[b] = min(a[b], a'[b])
-	for(int i = 0; i < n; i++)
-		if(d[i] == BOT_AGE)
-			d[i] = s[i];
-		else if(s[i] != BOT_AGE)
-			d[i] = min(d[i], s[i]);
+	// (⊥ = -1 is neutral as the biggest unsigned age)
+	cache::uminAges(&d[0], &s[0], n);
 }
 
 /**
@@ -71,11 +69,16 @@ void MayDomain::fetch(t& a, const LBlock *lb) {
 	int b = lb->index();
 
 	// U(a, b) = a' s.t. ∀ b' ∈ B_s
-	for(int i = 0; i < n; i++)
-		// a'[b'] = a[b'] + 1	if a[b'] < a[b] ∧ a[b'] ≠ ⊥
-		if(a[i] <= a[b] && a[i] != A)
-			a[i]++;
-		// a'[b'] = a[b']		else
+	// a'[b'] = a[b'] + 1	if a[b'] <= a[b] ∧ a[b'] ≠ A
+	// a'[b'] = a[b']		else
+	// (as a[b] is itself aged when it is not A, the blocks after b are
+	// compared with its aged value)
+	int ab = a[b];
+	cache::incAges(&a[0], b + 1, BOT_AGE - 1, ab + 1, A);
+	if(ab != A)
+		ab++;
+	if(b + 1 < n)
+		cache::incAges(&a[b + 1], n - b - 1, BOT_AGE - 1, ab + 1, A);
 
 	// a[b] = 0
 	a[b] = 0;
@@ -200,14 +203,13 @@ protected:
 		for(CFGCollection::BlockIter b(cfgs); b(); b++)
 			(*MAY_IN(*b)).configure(*coll);
 
-		// compute ACS
-		for(int i = 0; i < coll->cache()->setCount(); i++) {
-			if((*coll)[i].count()) {
-				if(logFor(LOG_FUN))
-					log << "\tanalyzing set " << i << io::endl;
-				processSet(i);
-			}
-		}
+		// compute ACS (sets are independent, concurrency disabled for logging)
+		SetScheduler sched(*coll);
+		sched.run([this](int i) {
+			if(logFor(LOG_FUN))
+				log << "\tanalyzing set " << i << io::endl;
+			processSet(i);
+		}, !logFor(LOG_FUN));
 	}
 
 	void destroy(WorkSpace *ws) override {
@@ -255,6 +257,9 @@ p::declare MayAnalysis::reg = p::init("otawa::icat3::MayAnalysis", Version(1, 0,
  * Perform the ACS analysis for the May domain, that is, computes for each cache
  * block the highest age it may have considering all execution paths.
  *
+ * When OTAWA is compiled with concurrency support, the cache sets are
+ * analyzed in parallel (except if logging is set to function level or more).
+ *
  * @par Properties
  * @li @ref MAY_IN
  *
@@ -62,8 +62,7 @@ void MustDomain::join(t& d, const t& s) {
 	// J(a, a') = a" s.t.
 
 	// ∀ b ∈ B_s, a"[b] = max(a[b], a'[b])
-	for(int i = 0; i < n; i++)
-		d[i] = max(d[i], s[i]);
+	cache::maxAges(&d[0], &s[0], n);
 }
 
 /**
@@ -75,11 +74,9 @@ void MustDomain::fetch(t& a, const LBlock *lb) {
 	int b = lb->index();
 
 	// U(a, b) = a' s.t. ∀ b' ∈ B_s
-	for(int i = 0; i < n; i++)
-		// a'[b'] = a[b'] + 1	if a[b'] < a[b] ∧ a[b'] ≠ ⊥
-		if(a[i] < a[b] && a[i] != BOT_AGE)
-			a[i]++;
-		// a'[b'] = a[b']		else
+	// a'[b'] = a[b'] + 1	if a[b'] < a[b] ∧ a[b'] ≠ ⊥
+	// a'[b'] = a[b']		else
+	cache::incAges(&a[0], n, BOT_AGE, a[b], BOT_AGE);
 
 	// a[b] = 0
 	a[b] = 0;
@@ -146,10 +143,7 @@ void MustDomain::update(Edge *e, ACS& a) {
  * @param b	Second ACS.
  */
 bool MustDomain::equals(const ACS& a, const ACS& b) {
-	for(int i = 0; i < n; i++)
-		if(a[i] != b[i])
-			return false;
-	return true;
+	return cache::equalAges(&a[0], &b[0], n);
 }
 
 } }		// otawa::icat3
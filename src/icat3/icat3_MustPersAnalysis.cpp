@@ -32,6 +32,7 @@
 #include <otawa/cfg/CompositeCFG.h>
 #include <otawa/ai/SimpleAI.h>
 #include "MustPersDomain.h"
+#include "SetScheduler.h"
 
 #define DEBUG(x)	// cerr << "DEBUG: " << x << io::endl
 
@@ -309,14 +310,13 @@ protected:
 			track(MUST_PERS_ANALYSIS_FEATURE, MUST_IN(*b));
 		}
 
-		// compute ACS
-		for(int i = 0; i < coll->cache()->setCount(); i++) {
-			if((*coll)[i].count()) {
-				if(logFor(LOG_FUN))
-					log << "\tanalyzing set " << i << io::endl;
-				processSet(i);
-			}
-		}
+		// compute ACS (sets are independent, concurrency disabled for logging)
+		SetScheduler sched(*coll);
+		sched.run([this](int i) {
+			if(logFor(LOG_FUN))
+				log << "\tanalyzing set " << i << io::endl;
+			processSet(i);
+		}, !logFor(LOG_FUN));
 	}
 
 	void processSet(int set) {
@@ -370,6 +370,9 @@ p::id<Container<ACS> > PERS_INIT("otawa::icat3::PERS_INIT");
  * Feature performing instruction cache analysis with combined
  * MUST and PERS analyzes.
  *
+ * When OTAWA is compiled with concurrency support, the cache sets are
+ * analyzed in parallel (except if logging is set to function level or more).
+ *
  * @par Configuration
  * @li @ref MUST_INIT
  * @li @ref PERS_INIT
@@ -120,8 +120,9 @@ bool MustPersDomain::equals(const t& a, const t& b) {
  * @param b		Returning block.
  */
 void MustPersDomain::doCall(t& a, Block *b) {
-	// TODO I dislike the way  is implemented: must be fixed in a different way!
-	DEPTH(b) = a.pers.depth();
+	// depth is recorded in the domain (and not as a block property)
+	// to let the different cache sets to be analyzed concurrently
+	_depth.put(b, a.pers.depth());
 }
 
 /**
@@ -130,7 +131,7 @@ void MustPersDomain::doCall(t& a, Block *b) {
  * @param b		Returning block.
  */
 void MustPersDomain::doReturn(t& a, Block *b) {
-	int d = DEPTH(b);
+	int d = _depth.get(b, -1);
 	while(a.pers.depth() > d)
 		_pers.leave(a.pers);
 }
@@ -153,6 +154,4 @@ void MustPersDomain::leaveLoop(t& a) {
 	_pers.leave(a.pers);
 }
 
-p::id<int> MustPersDomain::DEPTH("", -1);
-
 } }	// otawa::icat3
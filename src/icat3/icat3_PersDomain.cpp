@@ -70,17 +70,11 @@ void PersDomain::print(const t& a, io::Output& out) const {
 void PersDomain::join(ACS& d, const ACS& s) {
 
 	// J(a, a') = a" s.t. ∀ b ∈ B_s
-	for (int b = 0; b < n; b++)
-
-		// a"[b] = max(a[b], a'[b])	if a[b] ≠ ⊥ ∧ a'[b] ≠ ⊥
-		if(d[b] != BOT_AGE && s[b] != BOT_AGE)
-			d[b] = max(d[b], s[b]);
-
-		// a"[b] = a'[b]			if a[b] = ⊥
-		else if(d[b] == BOT_AGE)
-			d[b] = s[b];
-
-		// a"[b] = a[b]			else
+	// a"[b] = max(a[b], a'[b])	if a[b] ≠ ⊥ ∧ a'[b] ≠ ⊥
+	// a"[b] = a'[b]			if a[b] = ⊥
+	// a"[b] = a[b]			else
+	// that is the signed maximum as ⊥ = -1 is smaller than any age
+	cache::maxAges(&d[0], &s[0], n);
 }
 
 /**
@@ -94,21 +88,16 @@ void PersDomain::fetch(LBlock *lb, ACS& a) {
 	// U_p(a, b) = a' s.t. ∀ b' ∈ B_s
 
 	// if a[b] ∈  [0, A-1]
-	if(0 <= a[b] && a[b] < A) {
-		for(int b_ = 0; b_ < n; b_++)
-			//a'[b'] = a[b'] + 1	if a[b'] < a[b] ∧ a[b'] ∉ { ⊥,  A }
-			if(a[b_] < a[b] && a[b_] != BOT_AGE && a[b_] != A)
-				a[b_] = a[b_] + 1;
-			//a'[b'] = a[b']		else
-	}
+	//	a'[b'] = a[b'] + 1	if a[b'] < a[b] ∧ a[b'] ∉ { ⊥,  A }
+	//	a'[b'] = a[b']		else
+	if(0 <= a[b] && a[b] < A)
+		cache::incAges(&a[0], n, BOT_AGE, a[b], A);
 
 	// else
+	//	a'[b'] = a[b'] + 1	if a[b'] ∉ { ⊥,  A }
+	//	a'[b'] = a[b']		else
 	else
-		for(int b_ = 0; b_ < n; b_++)
-		// a'[b'] = a[b'] + 1	if a[b'] ∉ { ⊥,  A }
-			if(a[b_] != BOT_AGE && a[b_] != A)
-				a[b_] = a[b_] + 1;
-		// a'[b'] = a[b']		else
+		cache::incAges(&a[0], n, BOT_AGE, A + 1, A);
 
 	//	a'[b'] = 0			if b' = b
 	a[b] = 0;
@@ -245,10 +234,7 @@ void PersDomain::leave(t& a) {
  * @param a2	Second ACS.
  */
 bool PersDomain::equals(const ACS& a1, const ACS& a2) {
-	for(int b = 0; b < n; b++)
-		if(a1[b] != a2[b])
-			return false;
-	return true;
+	return cache::equalAges(&a1[0], &a2[0], n);
 }
 
 /**
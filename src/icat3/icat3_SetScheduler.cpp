@@ -0,0 +1,95 @@
+/*
+ *	icat3::SetScheduler class implementation
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	This file is part of OTAWA
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ *	02110-1301  USA
+ */
+
+#include "config.h"
+#include <elm/data/quicksort.h>
+#include <otawa/prog/WorkSpace.h>
+#include "SetScheduler.h"
+
+namespace otawa { namespace icat3 {
+
+/**
+ * @class SetScheduler
+ * Dispatch the analysis of the cache sets of an l-block collection
+ * over the threads provided by WorkSpace::forAll(). As the ACS
+ * fix-point of a cache set is independent of the other sets, each set
+ * is processed in isolation and the caller function is only
+ * allowed to write in the slot of the set it is processing.
+ *
+ * The sets are dispatched from the one with the most l-blocks to the one
+ * with the fewest and idle threads steal the sets not yet processed by
+ * the busy ones. Hence the biggest sets do not end up alone at the end
+ * of the analysis.
+ *
+ * Without concurrency support (OTAWA_CONC), or when concurrency is not
+ * requested, the sets are processed sequentially in index order.
+ *
+ * @ingroup icat3
+ */
+
+class SetComparator {
+public:
+	SetComparator(const LBlockCollection& coll): _coll(coll) { }
+	int doCompare(int s1, int s2) const {
+		int c = _coll[s2].count() - _coll[s1].count();
+		if(c != 0)
+			return c;
+		else
+			return s1 - s2;
+	}
+private:
+	const LBlockCollection& _coll;
+};
+
+/**
+ * Build a set scheduler.
+ * @param coll	L-block collection to schedule sets for
+ * 				(only non-empty sets are processed).
+ */
+SetScheduler::SetScheduler(const LBlockCollection& coll): _coll(coll) {
+	for(int i = 0; i < coll.sets(); i++)
+		if(coll[i].count() != 0)
+			_sets.add(i);
+}
+
+/**
+ * Call the given function for each non-empty set.
+ * @param f				Function to call with the set number.
+ * @param concurrent	If true and concurrency is supported, dispatch
+ * 						the sets over several threads.
+ */
+void SetScheduler::run(fun_t f, bool concurrent) {
+#	ifdef OTAWA_CONC
+		if(concurrent && _sets.count() > 1) {
+			_order.clear();
+			for(auto s: _sets)
+				_order.add(s);
+			quicksort(_order, SetComparator(_coll));
+			WorkSpace::forAll(_order.count(), [this, f](int i) { f(_order[i]); });
+			return;
+		}
+#	endif
+	for(auto s: _sets)
+		f(s);
+}
+
+} }		// otawa::icat3
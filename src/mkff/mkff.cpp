@@ -36,6 +36,7 @@
 #include <otawa/cfg.h>
 #include <otawa/cfg/CFGChecker.h>
 #include <otawa/cfg/CFGCollector.h>
+#include <otawa/cfg/CFGPatcher.h>
 #include <otawa/cfg/features.h>
 #include <otawa/cfgio/features.h>
 #include <otawa/flowfact/ContextualLoopBound.h>
@@ -935,6 +936,8 @@ void Command::analyzeBranches(PropList& props) {
 	do {
 		if(first)
 			first = false;
+		else if(!slicing && !lightSlicing)
+			workspace()->run<CFGPatcher>(props); // only rebuild the CFGs with new targets
 		else {
 			workspace()->invalidate(COLLECTED_CFG_FEATURE);
 
@@ -27,6 +27,7 @@
 #include <otawa/ilp/System.h>
 #include <otawa/ipet/IPET.h>
 #include <otawa/script/Script.h>
+#include <otawa/stats/ProcStats.h>
 #include <otawa/stats/StatInfo.h>
 #include <otawa/util/BBRatioDisplayer.h>
 #include <otawa/flowfact/FlowFactLoader.h>
@@ -75,7 +76,8 @@ using namespace elm::option;
  * to pass parameters to the script and the supported @i ID depends on the launched script (see its documentation
  * for more details).
  * * -s, --script PATH: use the given script to compute the WCET.
- * * -S, --display-stats: display statistics produced by the analysis.
+ * * -S, --display-stats: display statistics produced by the analysis, including the time,
+ * the memory and the properties used by each code processor.
  * * --stats: outputs available statistics in work directory.
  * * -t, --timed: display computation time.
  * * -v, --verbose: verbose display of the process (same as --log bb)
@@ -256,6 +258,12 @@ protected:
 			// no state message
 			if(!found)
 				cerr << "No statistics to display.\n";
+
+			// resources used by the processors
+			if(ProcStats::get(workspace())) {
+				cerr << io::endl;
+				ProcStats::print(workspace(), cerr);
+			}
 		}
 
 		// display detailed statistics about WCET
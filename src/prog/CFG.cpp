@@ -287,6 +287,17 @@ namespace otawa {
  * @return	True if it is back branch, false else.
  */
 
+/**
+ * @fn int Edge::id(void) const;
+ * Returns an edge identifier that is unique to the whole program.
+ * This number is positive or null and less than the countEdges() of the CFG
+ * collection containing the parent CFG of this edge. The edges of a same CFG
+ * are numbered contiguously from CFG::edgeOffset().
+ *
+ * An edge added after its CFG has been collected has a negative identifier.
+ * @return	Unique identifier.
+ */
+
 
 
 /**
@@ -673,6 +684,8 @@ void BasicBlock::basicPreds(basic_preds_t& preds) {
 CFG::CFG(Inst *first, type_t type)
 :	idx(0),
 	_offset(0),
+	_eoffset(0),
+	_ecount(0),
 	_type(type),
 	fst(first),
 	_entry(nullptr),
@@ -799,6 +812,19 @@ void CFG::clean(const AbstractIdentifier& id) {
  * @return	CFG index.
  */
 
+/**
+ * @fn int CFG::edgeOffset(void) const;
+ * Get the identifier of the first edge of the CFG in the CFG collection
+ * (see @ref Edge::id()).
+ * @return	First edge identifier.
+ */
+
+/**
+ * @fn int CFG::countEdges(void) const;
+ * Get the number of edges of the CFG, as numbered by the CFG collection.
+ * @return	Edge count.
+ */
+
 /**
  * @fn BasicBlock *CFG::exit(void);
  * Get the exit basic block of the CFG.
@@ -978,4 +1004,20 @@ void CFGMaker::fix(SynthBlock *v, CFG *g) {
 	v->_callee = g;
 }
 
+
+/**
+ * Change the callee of an already built synthetic block, updating the callers
+ * of the former and of the new callee. This is used to patch a CFG collection
+ * when a called CFG is rebuilt.
+ * @param v		Synthetic block to relink.
+ * @param g		New callee CFG (may be null).
+ */
+void CFGMaker::relink(SynthBlock *v, CFG *g) {
+	if(v->_callee != nullptr)
+		v->_callee->_callers.remove(v);
+	v->_callee = g;
+	if(g != nullptr)
+		g->_callers.add(v);
+}
+
 }	// otawa
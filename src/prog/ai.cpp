@@ -24,6 +24,7 @@
 #include <otawa/ai/FlowAwareRanking.h>
 #include <otawa/ai/RankingAI.h>
 #include <otawa/ai/SimpleWorkList.h>
+#include <otawa/ai/WTO.h>
 #include <otawa/dfa/ai.h>
 #include <otawa/ai/BlockAnalysis.h>
 
@@ -363,6 +364,161 @@ public:
  */
 
 
+/**
+ * @fn int RankingAI::updates(void) const;
+ * Get the number of calls to the update function of the adapter
+ * performed by the last analysis.
+ * @return	Number of updates.
+ */
+
+
+/**
+ * @fn int SimpleAI::updates(void) const;
+ * Get the number of calls to the update function of the adapter
+ * performed by the last analysis.
+ * @return	Number of updates.
+ */
+
+
+/**
+ * @class BucketQueue
+ * Priority queue whose priorities are small non-negative integers like
+ * the ranks provided by @ref CFGRanking. The items are stored in one bucket
+ * per rank and both put() and get() are performed in amortized constant time.
+ * Items of same rank are delivered in LIFO order.
+ *
+ * @param T		Type of items.
+ *
+ * @ingroup ai
+ */
+
+/**
+ * @fn void BucketQueue::put(const T& x, int rank);
+ * Put an item in the queue.
+ * @param x		Item to put.
+ * @param rank	Rank of the item (lower is delivered first).
+ */
+
+/**
+ * @fn T BucketQueue::get(void);
+ * Get and remove the item with the lowest rank. The queue must not be empty.
+ * @return	Item with lowest rank.
+ */
+
+
+/**
+ * @class WTO
+ * Weak Topological Order of a graph as defined in:
+ *
+ * F. Bourdoncle. Efficient chaotic iteration strategies with widenings.
+ * In Formal Methods in Programming and Their Applications, LNCS 735, 1993.
+ *
+ * The WTO is represented as a flat sequence of vertices where each
+ * component is made of its head followed by its body: for a head
+ * at position i, its component spans positions i to endOf(i) (exclusive).
+ * Only the vertices reachable from the graph entry are ordered.
+ *
+ * @param G		Type of graph (must provide succs(), sinkOf(), index() and count()).
+ *
+ * @ingroup ai
+ */
+
+/**
+ * @fn int WTO::count(void) const;
+ * Get the number of ordered vertices.
+ * @return	Vertex count.
+ */
+
+/**
+ * @fn vertex_t WTO::operator[](int i) const;
+ * Get the vertex at the given position in the WTO.
+ * @param i		Position of the vertex.
+ * @return		Vertex at position i.
+ */
+
+/**
+ * @fn bool WTO::isHead(int i) const;
+ * Test if the vertex at the given position is the head of a component.
+ * @param i		Vertex position.
+ * @return		True if it is a component head, false else.
+ */
+
+/**
+ * @fn int WTO::endOf(int i) const;
+ * Get the position following the component whose head is at position i.
+ * @param i		Head position.
+ * @return		Position after the component.
+ */
+
+
+/**
+ * @class WTODriver
+ * Driver of abstract interpretation following the recursive iteration
+ * strategy of Bourdoncle on the @ref WTO of the graph: the body of each
+ * component is iterated until its head stabilizes, inner components being
+ * stabilized at each iteration of the outer component. Widening, if any,
+ * is only applied on the component heads.
+ *
+ * This driver provides the same interface as @ref WorkListDriver.
+ *
+ * @param D		Current domain (must implement otawa::ai::Domain concept).
+ * @param G		Graph (must implement otawa::ai::Graph concept).
+ * @param S		Storage.
+ * @param W		Widening policy (one of @ref NoWidening or @ref DomainWidening).
+ *
+ * @ingroup ai
+ */
+
+/**
+ * @fn bool WTODriver::isHead(void) const;
+ * Test if the current vertex is a component head.
+ * @return	True if it is a head, false else.
+ */
+
+/**
+ * @fn void WTODriver::check(t s);
+ * Check if there is some change in the state of the current vertex.
+ * If any, store the new state. For a re-iterated head, the new state
+ * is first widened with the old one.
+ * @param s		New state of the current vertex.
+ */
+
+
+/**
+ * @class NoWidening
+ * Widening policy of @ref WTODriver that does not perform any widening
+ * (convenient for domains of finite height).
+ * @ingroup ai
+ */
+
+/**
+ * @class DomainWidening
+ * Widening policy of @ref WTODriver calling the widen(old, new)
+ * function of the domain.
+ * @ingroup ai
+ */
+
+
+/**
+ * @class WTOAI
+ * Abstract interpretation, as @ref SimpleAI, but driven by the @ref WTODriver.
+ * For graphs with nested loops, it generally requires much less updates
+ * to reach the fix-point than the work list based analyzers.
+ *
+ * @param A		Type of the adapter (must implement @ref AdapterConcept).
+ * @param W		Widening policy.
+ *
+ * @ingroup ai
+ */
+
+/**
+ * @fn int WTOAI::updates(void) const;
+ * Get the number of calls to the update function of the adapter
+ * performed by the last analysis.
+ * @return	Number of updates.
+ */
+
+
 /**
  * @class PropertyRanking
  * This class may be used with @ref RankingAI to organize the list of vertices to process
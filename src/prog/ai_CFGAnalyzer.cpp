@@ -19,9 +19,15 @@
  *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <elm/checksum/Fletcher.h>
 #include <elm/data/ListQueue.h>
+#include <elm/sys/System.h>
 #include <otawa/ai/CFGAnalyzer.h>
 #include <otawa/ai/RankedQueue.h>
+#include <otawa/stats/ProcStats.h>
 
 namespace otawa { namespace ai {
 
@@ -186,6 +192,16 @@ State *Domain::load(io::InStream *in) {
 	return nullptr;
 }
 
+/**
+ * Called when a state read by load() is no more used, for example when
+ * a cached state file does not match the current analysis. The default
+ * implementation does nothing, which fits domains whose states are
+ * garbage-collected (see CFGAnalyzer::collect()).
+ * @param s		State to discard.
+ */
+void Domain::discard(State *s) {
+}
+
 /**
  * Test if the current domain supports the printing of the underlying code.
  * @return	True if the domain prints code (default to false).
@@ -253,6 +269,17 @@ void Domain::printTrace(State *s, io::StructuredOutput& out) {
  * * s^before_w->v = s[w]
  * * s^after_w->v = U(w->v, s[w])
  * 
+ * The fix-point states may be stored in an on-disk cache directory (see
+ * @ref CFGAnalyzer::STATE_CACHE and @ref CFGAnalyzer::setCache()) and
+ * reloaded by the next analysis of the same CFGs, with the same
+ * configuration, instead of being computed again.
+ *
+ * @par Configuration
+ * The configuration is read by configure(), usually called with the
+ * configuration of the processor using the analyzer:
+ * @li @ref CFGAnalyzer::STATE_CACHE
+ * @li @ref CFGAnalyzer::STATE_SIGN
+ *
  * @ingroup ai
  */
 
@@ -271,7 +298,8 @@ CFGAnalyzer::CFGAnalyzer(Monitor& monitor, Domain& domain, State *entry):
 	s0(entry == nullptr ? dom.entry() : entry),
 	verbose(false),
 	verbose_inst(false),
-	trace(nullptr)
+	trace(nullptr),
+	cache_hit(false)
 {
 }
 
@@ -280,6 +308,31 @@ CFGAnalyzer::~CFGAnalyzer() {
 }
 
 
+/**
+ * Directory used to cache the fix-point states of the analysis
+ * (see CFGAnalyzer::setCache()). If empty (default), no cache is used.
+ */
+p::id<sys::Path> CFGAnalyzer::STATE_CACHE("otawa::ai::CFGAnalyzer::STATE_CACHE", "");
+
+
+/**
+ * Signature of the domain configuration used to identify the cached
+ * fix-point states (see CFGAnalyzer::setCache()).
+ */
+p::id<string> CFGAnalyzer::STATE_SIGN("otawa::ai::CFGAnalyzer::STATE_SIGN", "");
+
+
+/**
+ * Configure the analyzer from the given properties.
+ * @param props	Configuration properties.
+ */
+void CFGAnalyzer::configure(const PropList& props) {
+	sys::Path dir = STATE_CACHE(props);
+	if(!dir.isEmpty())
+		setCache(dir, STATE_SIGN(props));
+}
+
+
 /**
  * Enable tracing of the computation on the given structured output.
  * Notice that tracing will only enabled if the current domain supports it.
@@ -291,6 +344,39 @@ void CFGAnalyzer::setTrace(io::StructuredOutput& t) {
 }
 
 
+/**
+ * Enable the cache of fix-point states in the given directory. Before the
+ * analysis, the states are looked in the cache and, if they are found,
+ * are used without iterating again. After the analysis, the computed states
+ * are stored in the cache.
+ *
+ * The states are identified by the checksums of the analyzed CFGs
+ * (@ref CFG_CHECKSUM_FEATURE has to be required before the analysis, else
+ * the cache is not used), by the entry state and by the given signature.
+ * The signature has to identify the domain and its configuration: the caller
+ * is responsible to change it when the configuration of the domain makes
+ * the states incompatible.
+ *
+ * The cache is only used if the domain implements input/output
+ * (@ref Domain::implementsIO()) and if the tracing is disabled.
+ *
+ * @param dir	Directory containing the cache files.
+ * @param sign	Signature of the analysis configuration.
+ */
+void CFGAnalyzer::setCache(const sys::Path& dir, const string& sign) {
+	cache_dir = dir;
+	cache_sign = sign;
+}
+
+
+/**
+ * @fn bool CFGAnalyzer::isCached() const;
+ * Test if the states of the last call to process() has been loaded from the
+ * state cache.
+ * @return	True if the states come from the cache, false else.
+ */
+
+
 /**
  * Perform the analysis.
  */
@@ -315,12 +401,26 @@ void CFGAnalyzer::process() {
 	for(int i = 0; i < states.length(); i++)
 		states[i] = bot;
 
+	// look in the state cache
+	sys::Path cache_path;
+	cache_hit = false;
+	if(!cache_dir.isEmpty() && trace == nullptr && dom.implementsIO()) {
+		cache_path = cachePath();
+		if(!cache_path.isEmpty() && loadCache(cache_path)) {
+			cache_hit = true;
+			if(mon.logFor(Monitor::LOG_PROC))
+				mon.log << "\tstates loaded from " << cache_path << io::endl;
+			return;
+		}
+	}
+
 	// prepare the queue
 	//ListQueue<Block *> todo;
 	Queue todo(cfgs);
 	todo.put(cfgs->entry()->entry());
 	while(todo) {
 		auto v = todo.get();
+		ProcStats::iterate();
 		if(verbose) {
 			mon.log << "\tprocessing " << v << " (" << v->cfg()->label() << ")\n";
 			if(verbose_inst)
@@ -416,6 +516,207 @@ void CFGAnalyzer::process() {
 		endTrace();
 		trace = nullptr;
 	}
+
+	// store in the state cache
+	if(!cache_path.isEmpty()) {
+		try {
+			saveCache(cache_path);
+			if(mon.logFor(Monitor::LOG_PROC))
+				mon.log << "\tstates saved to " << cache_path << io::endl;
+		}
+		catch(sys::SystemException& e) {
+			mon.log << "WARNING: cannot save states to " << cache_path << ": " << e.message() << io::endl;
+		}
+		catch(io::IOException& e) {
+			mon.log << "WARNING: cannot save states to " << cache_path << ": " << e.message() << io::endl;
+		}
+	}
+}
+
+
+// state cache file format
+static const char CACHE_MAGIC[8] = { 'O', 'T', 'A', 'I', 'S', 'T', '0', '1' };
+static const t::uint8
+	CACHE_BOT = 0,
+	CACHE_TOP = 1,
+	CACHE_STATE = 2;
+
+static void write(io::OutStream *out, const void *p, int size) {
+	if(out->write(static_cast<const char *>(p), size) != size)
+		throw io::IOException(out->lastErrorMessage());
+}
+
+static void read(io::InStream *in, void *p, int size) {
+	if(in->read(p, size) != size)
+		throw io::IOException("truncated state cache");
+}
+
+
+/**
+ * Compute the path of the cache file for the current CFG collection.
+ * @return	Path of the cache file or an empty path if the CFGs
+ * 			have no checksum.
+ */
+sys::Path CFGAnalyzer::cachePath() {
+	checksum::Fletcher sum;
+	sum.put(cache_sign.chars(), cache_sign.length());
+	for(auto g: *cfgs) {
+		if(!g->hasProp(CHECKSUM))
+			return sys::Path();
+		t::uint64 c = CHECKSUM(g);
+		t::uint32 n = g->count();
+		sum.put(&c, sizeof(c));
+		sum.put(&n, sizeof(n));
+	}
+	return cache_dir / (_ << io::hex(sum.sum()) << ".ais");
+}
+
+
+/**
+ * Load the states from the given cache file. The file is checked against
+ * the current CFGs, signature and entry state: if one of them does not match,
+ * the file is ignored.
+ * @param path	Path of the cache file.
+ * @return		True if the states have been loaded, false else.
+ */
+bool CFGAnalyzer::loadCache(const sys::Path& path) {
+	if(!path.exists())
+		return false;
+	io::InStream *in = nullptr;
+	try {
+		in = sys::System::readFile(path);
+
+		// check the header
+		char magic[sizeof(CACHE_MAGIC)];
+		read(in, magic, sizeof(magic));
+		bool valid = memcmp(magic, CACHE_MAGIC, sizeof(magic)) == 0;
+		t::uint32 n = 0;
+		if(valid) {
+			read(in, &n, sizeof(n));
+			valid = n == t::uint32(cache_sign.length());
+		}
+		for(t::uint32 i = 0; valid && i < n;) {
+			char buf[64];
+			t::uint32 k = min(n - i, t::uint32(sizeof(buf)));
+			read(in, buf, k);
+			valid = memcmp(buf, cache_sign.chars() + i, k) == 0;
+			i += k;
+		}
+		if(valid) {
+			read(in, &n, sizeof(n));
+			valid = n == t::uint32(cfgs->count());
+		}
+		for(int i = 0; valid && i < cfgs->count(); i++) {
+			t::uint64 c;
+			read(in, &c, sizeof(c));
+			read(in, &n, sizeof(n));
+			valid = c == t::uint64(CHECKSUM(cfgs->get(i))) && n == t::uint32(cfgs->get(i)->count());
+		}
+		if(valid) {
+			State *s = dom.load(in);
+			valid = dom.equals(s, s0);
+			dom.discard(s);
+		}
+
+		// read the states
+		for(int i = 0; valid && i < states.length(); i++) {
+			t::uint8 k;
+			read(in, &k, sizeof(k));
+			switch(k) {
+			case CACHE_BOT:		states[i] = bot; break;
+			case CACHE_TOP:		states[i] = top; break;
+			case CACHE_STATE:	states[i] = dom.load(in); break;
+			default:			valid = false; break;
+			}
+		}
+		if(valid) {
+			char end[sizeof(CACHE_MAGIC)];
+			read(in, end, sizeof(end));
+			valid = memcmp(end, CACHE_MAGIC, sizeof(end)) == 0;
+		}
+		delete in;
+
+		// reset the states if not valid
+		if(!valid)
+			resetStates();
+		return valid;
+	}
+	catch(sys::SystemException& e) {
+	}
+	catch(io::IOException& e) {
+	}
+	if(in != nullptr)
+		delete in;
+	resetStates();
+	return false;
+}
+
+
+/**
+ * Discard the states read from an invalid cache file and reset them to bottom.
+ */
+void CFGAnalyzer::resetStates() {
+	for(int i = 0; i < states.length(); i++) {
+		if(states[i] != bot && states[i] != top)
+			dom.discard(states[i]);
+		states[i] = bot;
+	}
+}
+
+
+/**
+ * Save the states to the given cache file. The states are first written
+ * to a temporary file of the cache directory that is then renamed: a
+ * concurrent analysis never reads a partial file.
+ * @param path					Path of the cache file.
+ * @throw sys::SystemException	If the file cannot be created.
+ * @throw io::IOException		If there is an error during the write.
+ */
+void CFGAnalyzer::saveCache(const sys::Path& path) {
+	if(!cache_dir.exists())
+		cache_dir.makeDirs();
+	std::random_device rand;
+	sys::Path tmp = _ << path << "." << io::hex(t::uint32(rand())) << ".tmp";
+	io::OutStream *out = sys::System::createFile(tmp);
+	try {
+
+		// write the header
+		write(out, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+		t::uint32 n = cache_sign.length();
+		write(out, &n, sizeof(n));
+		write(out, cache_sign.chars(), n);
+		n = cfgs->count();
+		write(out, &n, sizeof(n));
+		for(auto g: *cfgs) {
+			t::uint64 c = CHECKSUM(g);
+			n = g->count();
+			write(out, &c, sizeof(c));
+			write(out, &n, sizeof(n));
+		}
+		dom.save(s0, out);
+
+		// write the states
+		for(int i = 0; i < states.length(); i++) {
+			t::uint8 k = states[i] == bot ? CACHE_BOT
+					   : states[i] == top ? CACHE_TOP
+					   : CACHE_STATE;
+			write(out, &k, sizeof(k));
+			if(k == CACHE_STATE)
+				dom.save(states[i], out);
+		}
+		write(out, CACHE_MAGIC, sizeof(CACHE_MAGIC));	// end marker: an incomplete file is ignored
+		out->flush();
+	}
+	catch(io::IOException& e) {
+		delete out;
+		tmp.remove();
+		throw;
+	}
+	delete out;
+	if(std::rename(tmp.toString().toCString(), path.toString().toCString()) != 0) {
+		tmp.remove();
+		throw io::IOException(_ << "cannot rename " << tmp << " to " << path);
+	}
 }
 
 
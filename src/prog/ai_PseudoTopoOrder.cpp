@@ -23,19 +23,18 @@ void PseudoTopoOrder::_topoLoopHelper(const CFGGraph &graph, Block *start, int c
 }
 
 bool PseudoTopoOrder::isBefore(const Block *b1, const Block *b2) const {
-	if (_belongsToLoop.hasKey(b1->index()) && !_belongsToLoop.hasKey(b2->index()))
+	int l1 = _belongsToLoop[b1->index()], l2 = _belongsToLoop[b2->index()];
+	if (l1 >= 0 && l2 < 0)
 		return true;
 
-	if (!_belongsToLoop.hasKey(b1->index()) && _belongsToLoop.hasKey(b2->index()))
+	if (l1 < 0 && l2 >= 0)
 		return false;
 
-	if (_belongsToLoop.hasKey(b1->index())) {
-		int loopId = _belongsToLoop[b1->index()];
-
-		if (_loopOrder[loopId] < _loopOrder[loopId]) 
+	if (l1 >= 0) {
+		if (_loopOrder[l1] < _loopOrder[l2])
 			return true;
 
-		if (_loopOrder[loopId] > _loopOrder[loopId]) 
+		if (_loopOrder[l1] > _loopOrder[l2])
 			return false;
 	}
 
@@ -63,6 +62,11 @@ void PseudoTopoOrder::_topoNodeHelper(const CFGGraph &graph, Block *end) {
 
 void PseudoTopoOrder::_getPseudoTopo(const CFGGraph &graph) {
 	_visited = new BitVector(graph.count());
+	for (int i = 0; i < graph.count(); i++) {
+		_loopOrder.add(-1);
+		_blockOrder.add(-1);
+		_belongsToLoop.add(-1);
+	}
 
 	_current = 0;
 	_topoLoopHelper(graph, graph.entry(), -1);
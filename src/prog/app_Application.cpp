@@ -514,7 +514,9 @@ void Application::completeTask() {
 
 
 /**
- * Generate statistics for the current workspace.
+ * Generate statistics for the current workspace: statistics of the analyses
+ * as .csv files and resources used by each code processor as JSON
+ * (see @ref StatsDumper).
  */
 void Application::stats() {
 	workspace()->require(CFG_DUMP_FEATURE, props);
@@ -33,6 +33,7 @@ namespace otawa {
 
 static Identifier<int> CFG_INDEX("", -1);
 static Identifier<BasicBlock *> BB("", 0);
+static Identifier<CFG *> REUSED_CFG("", nullptr);
 
 /**
  * @class AbstractCFGBuilder
@@ -355,8 +356,13 @@ void AbstractCFGBuilder::buildEdges(CFGMaker& m) {
 								}
 								else if(!NO_CALL(*c)) {
 									SynthBlock *cb = new SynthBlock();
-									CFGMaker& cm = maker(*c);
-									m.call(cb, cm);
+									CFG *rg = REUSED_CFG(*c);
+									if(rg != nullptr)
+										m.call(cb, rg);
+									else {
+										CFGMaker& cm = maker(*c);
+										m.call(cb, cm);
+									}
 									m.add(bb, cb, new Edge(Edge::TAKEN | Edge::CALL));
 									seq(m, bb, cb, Edge::NOT_TAKEN | Edge::RETURN);
 									one = true;
@@ -382,6 +388,17 @@ void AbstractCFGBuilder::cleanBBs(const FragTable<Inst *>& bbs) {
 }
 
 
+/**
+ * Record an already built CFG: the calls to its first instruction
+ * will be linked to it instead of building a new CFG.
+ * @param g		Reused CFG.
+ */
+void AbstractCFGBuilder::reuse(CFG *g) {
+	REUSED_CFG(g->first()) = g;
+	reused.add(g);
+}
+
+
 /**
  * Get maker for the given instruction as function entry.
  * @param i		First instruction of CFG.
@@ -434,6 +451,8 @@ AbstractCFGBuilder::~AbstractCFGBuilder() {
 		delete makers[i].snd;
 	}
 	makers.clear();	
+	for(auto g: reused)
+		REUSED_CFG(g->first()).remove();
 }
 
 
@@ -131,28 +131,117 @@ const CFGCollection *CFGCollection::get(WorkSpace *ws) {
 }
 
 /**
- * Add a CFG to the collection.
+ * Add a CFG to the collection. Its blocks and edges are numbered
+ * after the blocks and edges already in the collection.
  * @param cfg	Added CFG.
  */
 void CFGCollection::add(CFG *cfg) {
 	cfg->idx = cfgs.count();
-	cfg->_offset = cfgs.isEmpty() ? 0 : cfgs[cfgs.length()-1]->offset() + cfgs[cfgs.length()-1]->count();
-	cfg->_offset = cfgs.isEmpty() ? 0 : cfgs[cfgs.length()-1]->offset() + cfgs[cfgs.length()-1]->count();
+	cfg->_offset = _bcount;
+
+	// number the edges
+	cfg->_eoffset = _ecount;
+	int id = cfg->_eoffset;
+	for(auto v: *cfg)
+		for(auto e: v->outEdges())
+			e->_id = id++;
+	cfg->_ecount = id - cfg->_eoffset;
+
+	cfgs.add(cfg);
+	_bcount = cfg->offset() + cfg->count();
+	_ecount = id;
+}
+
+/**
+ * Add a CFG coming from another collection, keeping the identifiers of its
+ * blocks and edges (only its index is changed). This is used to patch
+ * a collection while preserving the identifiers of the untouched CFGs:
+ * @ref numberAfter() must be called before to avoid conflicts with the
+ * identifiers of the CFGs added with @ref add().
+ * @param cfg	Kept CFG.
+ */
+void CFGCollection::keep(CFG *cfg) {
+	cfg->idx = cfgs.count();
 	cfgs.add(cfg);
+	_bcount = max(_bcount, cfg->offset() + cfg->count());
+	_ecount = max(_ecount, cfg->edgeOffset() + cfg->countEdges());
 }
 
 /**
- * Count the number of BB in the CFG collection
- * (sum of BB count of each CFG).
+ * Ensure that the blocks and edges of the CFGs added with @ref add()
+ * get identifiers greater than the ones of the given collection.
+ * @param coll	Collection to number after.
+ */
+void CFGCollection::numberAfter(const CFGCollection& coll) {
+	_bcount = max(_bcount, coll.countBlocks());
+	_ecount = max(_ecount, coll.countEdges());
+}
+
+/**
+ * Count the number of block identifiers used in the CFG collection:
+ * this is the sum of BB count of each CFG except if the collection
+ * has been patched (see @ref keep()). In any case, it is greater than
+ * the identifiers of the blocks of the collection.
  * @return	Collection BB number.
  */
 int CFGCollection::countBlocks(void) const {
-	if(!cfgs)
-		return 0;
-	else
-		return cfgs[count() - 1]->offset() + cfgs[count() - 1]->count();
+	return _bcount;
 }
 
+/**
+ * Count the number of edge identifiers used in the CFG collection:
+ * this is the sum of edge count of each CFG except if the collection
+ * has been patched (see @ref keep()).
+ * @return	Collection edge number.
+ */
+int CFGCollection::countEdges(void) const {
+	return _ecount;
+}
+
+
+/**
+ * @class IdArrayStore
+ * Contiguous array of values indexed by dense identifiers. It is the common
+ * implementation of @ref BlockArrayStore and @ref EdgeArrayStore.
+ * The values are built by copy of the initial value and the type
+ * T does not need a default constructor.
+ * @param T		Type of stored values.
+ * @ingroup cfg
+ */
+
+/**
+ * @fn void IdArrayStore::init(int size, const T& x);
+ * Allocate the array, releasing the previous one.
+ * @param size	Number of values.
+ * @param x		Initial value.
+ */
+
+/**
+ * @fn void IdArrayStore::fill(const T& x);
+ * Set all values of the array.
+ * @param x		Value to set.
+ */
+
+
+/**
+ * @class BlockArrayStore
+ * Contiguous storage of one value per block of a CFG collection,
+ * indexed by @ref Block::id(). It is an efficient alternative
+ * to properties or hash tables in the inner loops of analyses.
+ * @param T		Type of stored values.
+ * @ingroup cfg
+ */
+
+
+/**
+ * @class EdgeArrayStore
+ * Contiguous storage of one value per edge of a CFG collection,
+ * indexed by @ref Edge::id(). It is an efficient alternative
+ * to properties or hash tables in the inner loops of analyses.
+ * @param T		Type of stored values.
+ * @ingroup cfg
+ */
+
 
 /**
  * @class CFGCollector
@@ -0,0 +1,193 @@
+/*
+ *	CFGPatcher processor implementation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/data/Array.h>
+#include <otawa/cfg/CFGPatcher.h>
+#include <otawa/cfg/features.h>
+#include <otawa/prog/WorkSpace.h>
+#include <otawa/flowfact/features.h>
+
+namespace otawa {
+
+/**
+ * @class CFGPatcher
+ * This processor rebuilds the CFG collection after new targets of indirect
+ * branches or calls have been found (@ref BRANCH_TARGET, @ref CALL_TARGET),
+ * typically by an iterative resolution of indirect branches. Instead of
+ * rebuilding all CFGs as @ref CFGCollector, only the CFGs containing
+ * an indirect control with a target not represented by an edge are
+ * rebuilt, as the newly reached functions. The other CFGs are kept
+ * as is in the new collection and their blocks and edges keep their
+ * identifiers (see @ref CFGCollection::keep()).
+ *
+ * The patched collection must have been built from the raw code (by
+ * @ref CFGCollector or by a previous CFGPatcher) and not transformed.
+ * As the new collection replaces the previous one, the analyses depending
+ * on it are invalidated.
+ *
+ * @par Configuration
+ * @li @ref BB_BOUNDS
+ *
+ * @par Required Features
+ * @li @ref COLLECTED_CFG_FEATURE
+ *
+ * @par Invalidated Features
+ * @li @ref COLLECTED_CFG_FEATURE
+ *
+ * @par Provided Features
+ * @li @ref COLLECTED_CFG_FEATURE
+ *
+ * @ingroup cfg
+ */
+
+
+/**
+ */
+CFGPatcher::CFGPatcher(p::declare& r):
+	CFGProvider(r),
+	builder(new AbstractCFGBuilder(*this))
+{ }
+
+
+/**
+ * CFGPatcher registration.
+ */
+p::declare CFGPatcher::reg = p::init("otawa::CFGPatcher", Version(1, 0, 0))
+	.require(COLLECTED_CFG_FEATURE)
+	.invalidate(COLLECTED_CFG_FEATURE)
+	.extend<CFGProvider>()
+	.make<CFGPatcher>();
+
+
+///
+void CFGPatcher::configure(const PropList& props) {
+	CFGProvider::configure(props);
+	builder->configure(props);
+}
+
+
+/**
+ * Test if a CFG does not match the current targets of its indirect branches
+ * and calls, that is, if one of the targets is not represented by an edge.
+ * @param ws	Current workspace.
+ * @param g		CFG to test.
+ * @return		True if the CFG needs to be rebuilt, false else.
+ */
+bool CFGPatcher::isStale(WorkSpace *ws, CFG *g) {
+	for(auto v: *g) {
+		if(!v->isBasic())
+			continue;
+		BasicBlock *bb = v->toBasic();
+		Inst *i = bb->control();
+		if(i == nullptr || i->target() != nullptr || IGNORE_CONTROL(i)
+		|| i->isReturn() || IS_RETURN(i))
+			continue;
+		bool call = i->isCall();
+		for(Identifier<Address>::Getter a(i, call ? CALL_TARGET : BRANCH_TARGET); a(); a++) {
+
+			// target producing an edge?
+			Inst *t = ws->findInstAt(*a);
+			if(t == nullptr || NO_BLOCK(t) || (call && (NO_CALL(t) || NO_RETURN(t))))
+				continue;
+
+			// look for the edge
+			bool found = false;
+			for(auto e: bb->outEdges()) {
+				Block *w = e->sink();
+				if(call
+				? w->isCall() && w->toSynth()->callee() != nullptr && w->toSynth()->callee()->address() == *a
+				: w->isBasic() && w->address() == *a) {
+					found = true;
+					break;
+				}
+			}
+			if(!found)
+				return true;
+		}
+	}
+	return false;
+}
+
+
+///
+void CFGPatcher::processWorkSpace(WorkSpace *ws) {
+	const CFGCollection *old = COLLECTED_CFG_FEATURE.get(ws);
+
+	// find the stale CFGs
+	AllocArray<bool> stale(old->count());
+	int cnt = 0;
+	for(auto g: *old) {
+		stale[g->index()] = isStale(ws, g);
+		if(stale[g->index()]) {
+			cnt++;
+			if(logFor(LOG_FUN))
+				log << "\trebuilding " << g << io::endl;
+		}
+	}
+
+	// rebuild them
+	for(auto g: *old)
+		if(stale[g->index()])
+			builder->maker(g->first());
+		else
+			builder->reuse(g);
+	builder->process(ws);
+	Vector<CFG *> built;
+	for(AbstractCFGBuilder::Iter m(*builder); m(); m++)
+		built.add(m->build());
+
+	// build the new collection
+	auto coll = new CFGCollection();
+	coll->numberAfter(*old);
+	AllocArray<CFG *> map(old->count());
+	int j = 0;
+	for(auto g: *old)
+		if(!stale[g->index()]) {
+			map[g->index()] = g;
+			coll->keep(g);
+		}
+		else {
+			map[g->index()] = built[j++];
+			coll->add(map[g->index()]);
+		}
+	for(; j < built.count(); j++)
+		coll->add(built[j]);
+
+	// link the kept calls to the rebuilt CFGs and unlink the stale ones
+	for(auto g: *old)
+		for(auto v: *g)
+			if(v->isCall() && v->toSynth()->callee() != nullptr) {
+				SynthBlock *sb = v->toSynth();
+				if(stale[g->index()])
+					CFGMaker::relink(sb, nullptr);
+				else if(stale[sb->callee()->index()])
+					CFGMaker::relink(sb, map[sb->callee()->index()]);
+			}
+
+	if(logFor(LOG_PROC))
+		log << "\t" << cnt << " CFG(s) rebuilt, " << (built.count() - cnt)
+			<< " added, " << (old->count() - cnt) << " kept" << io::endl;
+	setCollection(coll);
+	delete builder;
+	builder = nullptr;
+}
+
+} // otawa
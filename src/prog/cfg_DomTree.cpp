@@ -0,0 +1,231 @@
+/*
+ *	DomTree class implementation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/data/Vector.h>
+#include <otawa/cfg/DomTree.h>
+
+namespace otawa {
+
+/**
+ * @class DomTree
+ * Immediate dominator tree of a CFG, or immediate post-dominator
+ * tree if built in post mode (the root is then the exit block).
+ *
+ * The immediate dominators are computed with the algorithm of
+ * K. D. Cooper, T. J. Harvey and K. Kennedy ("A Simple, Fast Dominance
+ * Algorithm") that is close to linear on CFGs. Then the tree is numbered
+ * in pre-order and post-order so that the dominance test is a constant-time
+ * interval inclusion test.
+ *
+ * As with the previous data-flow computation of the dominance, a block
+ * that is not reachable from the root is dominated by any block.
+ *
+ * @ingroup cfg
+ */
+
+
+/**
+ * Build the dominator tree.
+ * @param cfg	CFG to work on.
+ * @param post	If true, build the post-dominator tree.
+ */
+DomTree::DomTree(CFG *cfg, bool post): _cfg(cfg), _post_dom(post) {
+	int n = cfg->count();
+	_idom = AllocArray<int>(n);
+	_pre = AllocArray<int>(n);
+	_post = AllocArray<int>(n);
+	for(int i = 0; i < n; i++) {
+		_idom[i] = -1;
+		_pre[i] = -1;
+		_post[i] = -1;
+	}
+	computeIDom();
+	computeOrders();
+}
+
+
+/**
+ * Compute the immediate dominators.
+ */
+void DomTree::computeIDom(void) {
+	int n = _cfg->count();
+	Block *r = root();
+
+	// compute post-order of the CFG (in _post, temporarily)
+	Vector<Block *> order;
+	Vector<Pair<Block *, Block::EdgeIter> > stack;
+	_post[r->index()] = -2;
+	stack.push(pair(r, _post_dom ? r->ins() : r->outs()));
+	while(stack) {
+		Block::EdgeIter& e = stack.top().snd;
+		if(!e()) {
+			Block *b = stack.pop().fst;
+			_post[b->index()] = order.count();
+			order.add(b);
+		}
+		else {
+			Block *s = _post_dom ? e->source() : e->sink();
+			e++;
+			if(_post[s->index()] == -1) {
+				_post[s->index()] = -2;
+				stack.push(pair(s, _post_dom ? s->ins() : s->outs()));
+			}
+		}
+	}
+
+	// iterate in reverse post-order until fix-point
+	_idom[r->index()] = r->index();
+	bool changed = true;
+	while(changed) {
+		changed = false;
+		for(int i = order.count() - 2; i >= 0; i--) {
+			Block *b = order[i];
+			int nidom = -1;
+			for(Block::EdgeIter e = _post_dom ? b->outs() : b->ins(); e(); e++) {
+				int p = (_post_dom ? e->sink() : e->source())->index();
+				if(_idom[p] < 0)
+					continue;
+				if(nidom < 0)
+					nidom = p;
+				else {
+					int f1 = p, f2 = nidom;
+					while(f1 != f2) {
+						while(_post[f1] < _post[f2])
+							f1 = _idom[f1];
+						while(_post[f2] < _post[f1])
+							f2 = _idom[f2];
+					}
+					nidom = f1;
+				}
+			}
+			if(_idom[b->index()] != nidom) {
+				_idom[b->index()] = nidom;
+				changed = true;
+			}
+		}
+	}
+
+	// reset post-order
+	for(int i = 0; i < n; i++)
+		_post[i] = -1;
+}
+
+
+/**
+ * Number the dominator tree in pre-order and post-order.
+ */
+void DomTree::computeOrders(void) {
+	int n = _cfg->count();
+
+	// build the children lists (as first-child, next-sibling)
+	AllocArray<int> child(n), sibling(n);
+	for(int i = 0; i < n; i++) {
+		child[i] = -1;
+		sibling[i] = -1;
+	}
+	for(int i = 0; i < n; i++)
+		if(_idom[i] >= 0 && _idom[i] != i) {
+			sibling[i] = child[_idom[i]];
+			child[_idom[i]] = i;
+		}
+
+	// traverse the tree
+	int pre = 0, post = 0;
+	Vector<int> stack;
+	int r = root()->index();
+	_pre[r] = pre++;
+	stack.push(r);
+	while(stack) {
+		int c = child[stack.top()];
+		if(c < 0)
+			_post[stack.pop()] = post++;
+		else {
+			child[stack.top()] = sibling[c];
+			_pre[c] = pre++;
+			stack.push(c);
+		}
+	}
+}
+
+
+/**
+ * @fn CFG *DomTree::cfg(void) const;
+ * Get the CFG of the tree.
+ * @return	Tree CFG.
+ */
+
+
+/**
+ * @fn bool DomTree::isPost(void) const;
+ * Test if the tree is a post-dominator tree.
+ * @return	True if it is a post-dominator tree, false else.
+ */
+
+
+/**
+ * @fn Block *DomTree::root(void) const;
+ * Get the root of the tree: entry block for dominance, exit block
+ * for post-dominance.
+ * @return	Tree root.
+ */
+
+
+/**
+ * @fn bool DomTree::isReachable(Block *b) const;
+ * Test if the block is reachable from the root (in the direction of the tree).
+ * @param b		Block to test.
+ * @return		True if the block is reachable, false else.
+ */
+
+
+/**
+ * @fn int DomTree::preorder(Block *b) const;
+ * Get the pre-order number of the block in the tree.
+ * @param b		Block to look for.
+ * @return		Pre-order number or -1 if the block is not reachable.
+ */
+
+
+/**
+ * @fn int DomTree::postorder(Block *b) const;
+ * Get the post-order number of the block in the tree.
+ * @param b		Block to look for.
+ * @return		Post-order number or -1 if the block is not reachable.
+ */
+
+
+/**
+ * @fn Block *DomTree::idom(Block *b) const;
+ * Get the immediate dominator of a block.
+ * @param b		Block to look for.
+ * @return		Immediate dominator or null for the root or a non-reachable block.
+ */
+
+
+/**
+ * @fn bool DomTree::dominates(Block *b1, Block *b2) const;
+ * Test if b1 dominates (or post-dominates) b2.
+ * @param b1	Dominating block.
+ * @param b2	Dominated block.
+ * @return		True if b1 dominates b2, false else.
+ */
+
+} // otawa
@@ -22,10 +22,9 @@
 #include <elm/deprecated.h>
 #include <otawa/cfg.h>
 #include <otawa/cfg/Dominance.h>
+#include <otawa/cfg/DomTree.h>
 #include <otawa/cfg/features.h>
 #include <otawa/dfa/BitSet.h>
-//#define OTAWA_IDFA_DEBUG
-#include <otawa/dfa/IterativeDFA.h>
 #include <otawa/proc/BBProcessor.h>
 #include <otawa/prog/WorkSpace.h>
 
@@ -39,9 +38,9 @@ public:
 
 protected:
 	virtual void clean(WorkSpace *ws, CFG *cfg, Block *bb) {
-		if(REVERSE_DOM(bb).exists()) {
-			delete REVERSE_DOM(bb);
-			bb->removeProp(REVERSE_DOM);
+		if(bb == cfg->entry() && DOM_TREE(cfg).exists()) {
+			delete DOM_TREE(cfg);
+			cfg->removeProp(DOM_TREE);
 		}
 		if(LOOP_HEADER(bb)) {
 			bb->removeProp(LOOP_HEADER);
@@ -56,10 +55,21 @@ protected:
  *
  * @par Hooks
  * @li @ref BasicBlock
+ * @deprecated	No more computed: use @ref DOM_TREE or @ref DomInfo.
  */
 Identifier<const BitSet *> REVERSE_DOM("otawa::REVERSE_DOM", 0);
 
 
+/**
+ * Dominator tree of a CFG, computed by @ref Dominance.
+ *
+ * @par Hooks
+ * @li @ref CFG
+ * @ingroup cfg
+ */
+Identifier<DomTree *> DOM_TREE("otawa::DOM_TREE", nullptr);
+
+
 /**
  * Identifier for marking basic blocks that are entries of loops.
  *
@@ -107,80 +117,12 @@ DomInfo::~DomInfo(void) {
  */
 
 
-/**
- * This is the Problem used to instanciate DFAEngine for computing the
- * reverse domination relation. For each basic block, the set of dominators
- * is computed and hooked to the basic block. Then, a simple bit test is
- * used for testing the relation.
- */
-
-class DominanceProblem {
-	CFG *cfg;
-	int size;
-public:
-	DominanceProblem(CFG *_cfg) {
-		cfg = _cfg;
-		size = _cfg->count();
-	}
-
-	BitSet *empty(void) {
-		BitSet *result = new BitSet(size);
-		result->fill();
-		return result;
-	}
-
-	BitSet *gen(Block *bb) {
-		BitSet *result = new BitSet(size);
-		result->add(bb->index());
-		return result;
-	}
-
-	BitSet *kill(Block *bb) {
-		BitSet *result = new BitSet(size);
-		if(bb->isEntry())
-			result->fill();
-		return(result);
-	}
-	bool equals(BitSet *set1, BitSet *set2) {
-		return(set1->equals(*set2));
-	}
-	void reset(BitSet *set) {
-		set->fill();
-	}
-	void merge(BitSet *set1, BitSet *set2) {
-		set1->mask(*set2);
-	}
-	void set(BitSet *dset, BitSet *tset) {
-		*dset = *tset;
-	}
-	void add(BitSet *dset, BitSet *tset) {
-		dset->add(*tset);
-	}
-	void diff(BitSet *dset, BitSet *tset) {
-		dset->remove(*tset);
-	}
-	void free(BitSet *set) { delete set; }
-
-	void dump(Output& out, BitSet *set) const {
-		bool fst = true;
-		out << "{ ";
-		for(auto v: *cfg)
-			if(set->contains(v->index())) {
-				if(fst)
-					fst = false;
-				else
-					out << ", ";
-				out << v;
-			}
-		out << " }";
-	}
-};
-
-
 /**
  * @class Dominance
  * This CFG processor computes and hook to the CFG the dominance relation
  * that, then, may be tested with @ref Dominance::dominate() function.
+ * The relation is represented by the dominator tree (@ref DomTree)
+ * and the test is performed in constant time.
  *
  * @p Provided Features
  * @li @ref DOMINANCE_FEATURE
@@ -196,6 +138,7 @@ p::declare Dominance::reg = p::init("otawa::Dominance", Version(1, 2, 0))
 	.provide(DOMINANCE_FEATURE)
 	.provide(LOOP_HEADERS_FEATURE)
 	.base(ConcurrentCFGProcessor::reg)
+	.concurrent()
 	.maker<Dominance>();
 
 /**
@@ -215,16 +158,13 @@ Dominance::Dominance(void): ConcurrentCFGProcessor(reg) {
 bool Dominance::dominates(Block *bb1, Block *bb2) {
 	ASSERTP(bb1, "null BB 1");
 	ASSERTP(bb2, "null BB 2");
-	//ASSERTP(bb1->cfg() == bb2->cfg(), "both BB are not owned by the same CFG");
-	int index = bb1->index();
-	ASSERTP(index >= 0, "no index for BB 1");
-	const BitSet *set = REVERSE_DOM(bb2);
-	ASSERTP(set, "no index for BB 2");
+	ASSERTP(bb1->index() >= 0, "no index for BB 1");
+	const DomTree *tree = DOM_TREE(bb2->cfg());
+	ASSERTP(tree, "no dominance for CFG of BB 2");
 	ASSERTP(bb1 == bb2
-	||	!REVERSE_DOM(bb1)->contains(bb2->index())
-	||  !REVERSE_DOM(bb2)->contains(bb1->index()),
+	||	tree->isReachable(bb1) || tree->isReachable(bb2),
 		"CFG with disconnected nodes for CFG " << bb1->cfg()->index() << ": " << bb1->cfg()->name() << "(" << bb1 << ", " << bb2 << ")");
-	return set->contains(index);
+	return tree->dominates(bb1, bb2);
 }
 
 
@@ -242,14 +182,7 @@ bool Dominance::dominates(Block *bb1, Block *bb2) {
  */
 void Dominance::processCFG(WorkSpace *ws, CFG *cfg) {
 	ASSERT(cfg);
-	DominanceProblem dp(cfg);
-	dfa::IterativeDFA<DominanceProblem, BitSet, CFG> engine(dp, cfg, cfg->entry());
-	engine.compute();
-	for (CFG::VertexIter bb(cfg->vertices()); bb(); bb++) {
-	  BitSet *b = engine.outSet(*bb);
-	  b = new BitSet(*b);
-	  REVERSE_DOM(*bb) = b;
-	}
+	DOM_TREE(cfg) = new DomTree(cfg);
 	markLoopHeaders(cfg);
 	addCleaner(DOMINANCE_FEATURE, new DominanceCleaner(ws));
 }
@@ -285,17 +218,19 @@ void Dominance::dumpCFG(CFG *g, Output& out) {
 bool Dominance::dom(Block *b1, Block *b2) {
 	ASSERT(b1);
 	ASSERT(b2);
-	const BitSet *set = REVERSE_DOM(b2);
-	ASSERT(set);
-	return set->contains(b1->index());
+	const DomTree *tree = DOM_TREE(b2->cfg());
+	ASSERT(tree);
+	return tree->dominates(b1, b2);
 }
 
 
 /**
  */
 Block *Dominance::idom(Block* b) {
-	ASSERTP(false, "idom not yet implemented"); // TODO
-	return NULL;
+	ASSERT(b);
+	const DomTree *tree = DOM_TREE(b->cfg());
+	ASSERT(tree);
+	return tree->idom(b);
 }
 
 
@@ -359,7 +294,7 @@ bool Dominance::isLoopHeader(Block *bb) {
  * @param cfg	CFG to look at.
  */
 void Dominance::ensure(CFG *cfg) {
-	if(!REVERSE_DOM(cfg->entry())) {
+	if(!DOM_TREE(cfg)) {
 		Dominance dom;
 		dom.processCFG(0, cfg);
 	}
@@ -378,6 +313,7 @@ void Dominance::ensure(CFG *cfg) {
  * @par Properties
  * @li @ref BACK_EDGE
  * @li @ref DOM_INFO
+ * @li @ref DOM_TREE
  *
  * @ingroup cfg
  */
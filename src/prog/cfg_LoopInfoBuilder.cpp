@@ -20,19 +20,15 @@
  *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
-//#define OTAWA_IDFA_DEBUG
+#include <elm/data/Array.h>
 #include <elm/data/Vector.h>
-#include <elm/data/SortedList.h>
 #include <otawa/cfg.h>
 #include <otawa/cfg/features.h>
-#include <otawa/dfa/BitSet.h>
-#include <otawa/dfa/IterativeDFA.h>
 #include <otawa/prog/WorkSpace.h>
-#include <otawa/proc/BBProcessor.h>
+#include <otawa/proc/CFGProcessor.h>
 
 using namespace elm;
 using namespace otawa;
-using namespace otawa::dfa;
 
 namespace otawa {
 
@@ -49,15 +45,14 @@ protected:
 		const CFGCollection* cfgc = INVOLVED_CFGS(ws);
 		for(CFGCollection::Iter cfg(cfgc); cfg(); cfg++) {
 			for(CFG::BlockIter bb = cfg->blocks(); bb(); bb++) {
-				for (BasicBlock::EdgeIter outedge = bb->outs(); outedge(); outedge++) {
-					if (LOOP_EXIT_EDGE(*outedge)) {
-						if (EXIT_LIST(LOOP_EXIT_EDGE(*outedge))) {
-							delete EXIT_LIST(LOOP_EXIT_EDGE(*outedge));
-							EXIT_LIST(LOOP_EXIT_EDGE(*outedge)).remove();
-						}
-						LOOP_EXIT_EDGE(*outedge).remove();
-					}
-				} // for each outedge
+				for(BasicBlock::EdgeIter outedge = bb->outs(); outedge(); outedge++) {
+					LOOP_EXIT(*outedge).remove();
+					LOOP_ENTRY(*outedge).remove();
+				}
+				if(EXIT_LIST(*bb)) {
+					delete EXIT_LIST(*bb);
+					EXIT_LIST(*bb).remove();
+				}
 				if(ENCLOSING_LOOP_HEADER(*bb).exists())
 					ENCLOSING_LOOP_HEADER(*bb).remove();
 			} // for each bb
@@ -72,11 +67,24 @@ private:
  * For each basic block, provides the loop which the basicblock belongs to.
  * For each edge exiting from a loop, provides the header of the exited loop.
  *
+ * The loop-nesting forest is built in the way of P. Havlak ("Nesting of
+ * Reducible and Irreducible Loops", TOPLAS 1997): the blocks are numbered
+ * in depth-first pre-order and the headers are processed from the innermost
+ * to the outermost, the body of each loop being collected backward from
+ * its back edges while the already built inner loops are collapsed
+ * with a union-find structure. This makes the computation close to linear
+ * in the size of the CFG whatever the number of loops.
+ *
+ * The headers and back edges are the ones of the @ref LOOP_HEADERS_FEATURE.
+ * When a loop body is entered by an edge not targeting its header
+ * (irreducible loop), the loop is made of the blocks of the depth-first
+ * sub-tree of the header that reach its back edges, and the foreign
+ * entries are passed to the enclosing loops.
+ *
  * @par Configuration
  * none
  *
  * @par Required Features
- * @li @ref DOMINANCE_FEATURE
  * @li @ref LOOP_HEADERS_FEATURE
  *
  * @par Provided Features
@@ -92,27 +100,19 @@ public:
 protected:
 	void processCFG(otawa::WorkSpace*, otawa::CFG*) override;
 private:
-	void buildLoopExitList(otawa::CFG* cfg);
+	void number(CFG *cfg);
+	void buildForest(void);
+	int exited(int v, int w) const;
+	int find(int i);
+	inline bool isAncestor(int h, int v) const { return h <= v && v <= last[h]; }
+	inline int loopOf(int v) const { return depth[v] ? v : enc[v]; }
+
 	bool fst;
+	Vector<Block *> order;
+	AllocArray<int> pre, last, enc, depth, uf;
 };
 
 
-/**
- * @class LoopInfoProblem
- *
- * This class defines an Iterative DFA problem for detecting which loop
- * contains a BB.
- * @par
- * Let a CFG, in OTAWA meaning, is <V, E, e>, tuple made of block vertices, edges
- * and entry point. The iterative DFA problem is defined by:
- * @li OUT(v) = { } initially
- * @li GEN(v) = { } if exist (w, v) in E /\ v dom w
- * @li GEN(v) = { w / (v, w) in E /\ w dom v } else
- * @li KILL(v) = { v / exists (w, v) in E /\ v dom w }
- *
- * And represents the set of
- */
-
 /**
  * This feature asserts that the loop info of the task is available in
  * the framework.
@@ -176,234 +176,192 @@ p::id<Block*>& LOOP_EXIT_EDGE = LOOP_EXIT;
 p::id<elm::Vector<Edge *> *> EXIT_LIST("otawa::EXIT_LIST", 0);
 
 
-// LoopInfoProblem class
-class LoopInfoProblem {
-
-	class DominanceOrder {
- 	public:
-		typedef Block *t;
-
-		DominanceOrder(void): _info(0) { }
-		DominanceOrder(DomInfo& info): _info(&info) { }
-		void set(DomInfo& info) { _info = &info; }
-
- 		inline int doCompare(Block *bb1, Block *bb2) const {
- 			if(_info->dom(bb1, bb2))
- 				return +1;
- 			else if(_info->dom(bb2, bb1))
- 				return -1;
- 			else
- 				return 0;
- 		}
- 	private:
- 		DomInfo *_info;
- 	};
-
-public:
-
-	LoopInfoProblem(CFG& cfg, DomInfo& info);
- 	inline dfa::BitSet *empty(void) const;
- 	dfa::BitSet *gen(Block *bb) const;
- 	dfa::BitSet *kill(Block *bb) const;
- 	bool equals(dfa::BitSet *set1, dfa::BitSet *set2) const;
- 	void reset(dfa::BitSet *set) const;
- 	void merge(dfa::BitSet *dst, dfa::BitSet *src) const;
- 	void set(dfa::BitSet *dst, dfa::BitSet *src) const;
- 	void add(dfa::BitSet *dst, dfa::BitSet *src) const;
- 	void diff(dfa::BitSet *dst, dfa::BitSet *src);
- 	inline int count(void) const;
- 	inline Block *get(int index) const;
- 	inline void free(dfa::BitSet *set) { delete set; }
-#ifndef NDEBUG
- 	void dump(elm::io::Output& out, dfa::BitSet *set);
-#endif
-
-private:
-	DomInfo& d;
-	/*DominanceOrder dorder;
-	CompareManager<Block *, DominanceOrder> dman;*/
-	SortedList<Block *, DominanceOrder > headersLList;
-	Vector<Block *> hdrs;
-
-};
-
-/* Constructors/Methods for LoopInfoProblem */
-LoopInfoProblem::LoopInfoProblem(CFG& cfg, DomInfo& info): d(info) {
-	headersLList.comparator().set(info);
-
-	/*
-	 * Find all the headers of the CFG
-	 * Adds them in a SORTED list
-	 */
-	for (CFG::BlockIter bb = cfg.blocks(); bb(); bb++)
-		if(!bb->isEntry() && LOOP_HEADER(*bb))
-			headersLList.add(*bb);
-
-	/* Converting to Vector, because a linked list is not very practical ... */
-	for(const auto h: headersLList)
-		hdrs.add(h);
-}
-
-inline dfa::BitSet* LoopInfoProblem::empty(void) const {
-		return new dfa::BitSet(hdrs.length());
-}
-
-dfa::BitSet* LoopInfoProblem::gen(Block *bb) const {
-		dfa::BitSet *result = empty();
-		for(Block::EdgeIter edge = bb->outs(); edge(); edge++)
-			if(bb != edge->target()			// not for single BB loop
-			&& d.dom(edge->target(), bb))
-				result->add(hdrs.indexOf(edge->target()));
-		return result;
-}
+p::declare LoopInfoBuilder::reg =
+	p::init("otawa::LoopInfoBuilder", Version(3, 0, 0))
+	.extend<CFGProcessor>()
+	.require(LOOP_HEADERS_FEATURE)
+	.provide(LOOP_INFO_FEATURE)
+	.make<LoopInfoBuilder>();
 
-dfa::BitSet* LoopInfoProblem::kill(Block *bb) const {
-		dfa::BitSet *result = empty();
-		if(LOOP_HEADER(bb))
-			result->add(hdrs.indexOf(bb));
-		return result;
-}
 
-bool LoopInfoProblem::equals(dfa::BitSet *set1, dfa::BitSet *set2) const {
-		return set1->equals(*set2);
-}
+/* Constructors/Methods for LoopInfoBuilder */
 
-void LoopInfoProblem::reset(dfa::BitSet *set) const {
-		set->empty();
+LoopInfoBuilder::LoopInfoBuilder(): CFGProcessor(reg), fst(true) {
 }
 
-void LoopInfoProblem::merge(dfa::BitSet *dst, dfa::BitSet *src) const {
-		*dst += *src;
-}
 
-void LoopInfoProblem::set(dfa::BitSet *dst, dfa::BitSet *src) const {
-		*dst = *src;
-}
-
-void LoopInfoProblem::add(dfa::BitSet *dst, dfa::BitSet *src) const {
-		*dst += *src;
+/*
+ * Number the blocks reachable from the entry in depth-first pre-order.
+ * pre[] is indexed by block index, last[] by pre-order number and gives
+ * the greatest number of the depth-first sub-tree.
+ */
+void LoopInfoBuilder::number(CFG *cfg) {
+	int n = cfg->count();
+	pre = AllocArray<int>(n);
+	for(int i = 0; i < n; i++)
+		pre[i] = -1;
+	order.clear();
+
+	Vector<Pair<Block *, Block::EdgeIter> > stack;
+	pre[cfg->entry()->index()] = 0;
+	order.add(cfg->entry());
+	stack.push(pair(cfg->entry(), cfg->entry()->outs()));
+	last = AllocArray<int>(n);
+	while(stack) {
+		Block::EdgeIter& e = stack.top().snd;
+		if(!e()) {
+			Block *b = stack.pop().fst;
+			last[pre[b->index()]] = order.count() - 1;
+		}
+		else {
+			Block *s = e->sink();
+			e++;
+			if(pre[s->index()] < 0) {
+				pre[s->index()] = order.count();
+				order.add(s);
+				stack.push(pair(s, s->outs()));
+			}
+		}
+	}
 }
 
-void LoopInfoProblem::diff(dfa::BitSet *dst, dfa::BitSet *src) {
-		*dst -= *src;
-}
 
-inline int LoopInfoProblem::count(void) const {
-		return hdrs.length();
+/*
+ * Find the representative of a block, that is, the header of the outermost
+ * loop already built that contains it (or the block itself).
+ */
+int LoopInfoBuilder::find(int i) {
+	while(uf[i] != i) {
+		uf[i] = uf[uf[i]];
+		i = uf[i];
+	}
+	return i;
 }
 
-inline Block* LoopInfoProblem::get(int index) const {
-		return hdrs[index];
-}
 
-#ifndef NDEBUG
-/* Dump the content of a bit set.
-*/
-	void LoopInfoProblem::dump(elm::io::Output& out, dfa::BitSet *set) {
-			bool first = true;
-			out << "{ ";
-			for(int i = 0; i < hdrs.length(); i++)
-				if(set->contains(i)) {
-					if(first)
-						first = false;
-					else
-						out << ", ";
-					out << hdrs[i]->index();
-				}
-			out << " }";
+/*
+ * Build the loop-nesting forest: enc[] receives the immediately enclosing
+ * header and depth[] the nesting depth of headers (0 for other blocks).
+ */
+void LoopInfoBuilder::buildForest(void) {
+	int m = order.count();
+	enc = AllocArray<int>(m);
+	depth = AllocArray<int>(m);
+	uf = AllocArray<int>(m);
+	AllocArray<int> mark(m);
+	for(int i = 0; i < m; i++) {
+		enc[i] = -1;
+		depth[i] = 0;
+		uf[i] = i;
+		mark[i] = -1;
 	}
-#endif
-
-
-p::declare LoopInfoBuilder::reg =
-	p::init("otawa::LoopInfoBuilder", Version(2, 0, 0))
-	.extend<CFGProcessor>()
-	.require(DOMINANCE_FEATURE)
-	.require(LOOP_HEADERS_FEATURE)
-	.provide(LOOP_INFO_FEATURE)
-	.make<LoopInfoBuilder>();
 
+	// process headers from the innermost to the outermost
+	Vector<Vector<int> > foreign;
+	for(int i = 0; i < m; i++)
+		foreign.add(Vector<int>());
+	Vector<int> body, todo;
+	for(int h = m - 1; h >= 0; h--) {
+		if(!LOOP_HEADER(order[h]))
+			continue;
+		depth[h] = 1;
+		body.clear();
+
+		// add a predecessor to the loop body
+		auto reach = [&](int y) {
+			y = find(y);
+			if(y == h || mark[y] == h)
+				return;
+			if(isAncestor(h, y)) {
+				mark[y] = h;
+				body.add(y);
+				todo.push(y);
+			}
+			else
+				foreign[h].add(y);
+		};
+
+		// collect the body backward from the back edges
+		for(auto e: order[h]->inEdges())
+			if(BACK_EDGE(e) && pre[e->source()->index()] >= 0)
+				reach(pre[e->source()->index()]);
+		while(todo) {
+			int x = todo.pop();
+			for(auto e: order[x]->inEdges())
+				if(pre[e->source()->index()] >= 0)
+					reach(pre[e->source()->index()]);
+			for(auto y: foreign[x])
+				reach(y);
+		}
 
-/* Constructors/Methods for LoopInfoBuilder */
+		// collapse the loop
+		for(auto x: body) {
+			enc[x] = h;
+			uf[x] = h;
+		}
+		if(foreign[h] && logFor(LOG_BLOCK))
+			log << "\t\t\tirreducible loop at " << order[h] << io::endl;
+	}
 
-LoopInfoBuilder::LoopInfoBuilder(): CFGProcessor(reg), fst(true) {
+	// compute depths (enclosing headers come first in pre-order)
+	for(int i = 0; i < m; i++)
+		if(depth[i] && enc[i] >= 0)
+			depth[i] = depth[enc[i]] + 1;
 }
 
 
 /*
- * Annotate each loop-header with the list of edges exiting the loop.
+ * Get the outermost loop containing v but not w.
+ * @return	Pre-order number of the loop header or -1.
  */
- void LoopInfoBuilder::buildLoopExitList(otawa::CFG* cfg) {
- 	for(CFG::BlockIter bb = cfg->blocks(); bb(); bb++) {
- 		for (BasicBlock::EdgeIter outedge = bb->outs(); outedge(); outedge++) {
- 			if (LOOP_EXIT_EDGE(*outedge)) {
- 				if (!EXIT_LIST(LOOP_EXIT_EDGE(*outedge))) {
- 					EXIT_LIST(LOOP_EXIT_EDGE(*outedge)) = new elm::Vector<Edge*>();
- 				}
-				EXIT_LIST(LOOP_EXIT_EDGE(*outedge))->add(*outedge);
- 			}
- 		}
- 	}
- }
+int LoopInfoBuilder::exited(int v, int w) const {
+	int a = loopOf(v), b = loopOf(w), r = -1;
+	int da = a < 0 ? 0 : depth[a], db = b < 0 ? 0 : depth[b];
+	for(; da > db; da--) {
+		r = a;
+		a = enc[a];
+	}
+	for(; db > da; db--)
+		b = enc[b];
+	while(a != b) {
+		r = a;
+		a = enc[a];
+		b = enc[b];
+	}
+	return r;
+}
+
 
 void LoopInfoBuilder::processCFG(otawa::WorkSpace* fw, otawa::CFG* cfg) {
-	int i;
-
-	// computes set of headers
-	LoopInfoProblem prob(*cfg, *DOMINANCE_FEATURE.get(fw));
-	if (prob.count() == 0)
-		return;
-	IterativeDFA<LoopInfoProblem, dfa::BitSet, CFG, Successor> dfa(prob, cfg, cfg->exit());
-	dfa.compute();
-
-	// compute enclosing loop header for each BB
-	for(CFG::BlockIter bb = cfg->blocks(); bb(); bb++) {
-
-		// enclosing loop header is the first element of set
-		// (headers are sorted according by increasing domination)
-		dfa::BitSet::Iterator bit(*dfa.outSet(*bb));
-		if (bit()) {
-			ENCLOSING_LOOP_HEADER(*bb) = prob.get(*bit);
+	number(cfg);
+	buildForest();
+
+	// record enclosing headers and loop entries
+	for(int i = 0; i < order.count(); i++) {
+		Block *bb = order[i];
+		if(enc[i] >= 0) {
+			ENCLOSING_LOOP_HEADER(bb) = order[enc[i]];
 			if (logFor(LOG_BLOCK))
-				cerr << "\t\t\tloop of " << *bb << " is " << ENCLOSING_LOOP_HEADER(*bb) << io::endl;
+				log << "\t\t\tloop of " << bb << " is " << order[enc[i]] << io::endl;
+		}
+		if(depth[i]) {
+			EXIT_LIST(bb) = new elm::Vector<Edge*>();
+			for (auto e: bb->inEdges())
+				if (!BACK_EDGE(e))
+					LOOP_ENTRY(e) = bb;
 		}
 	}
 
-	// add blocks themselves to the outing sets
-	for (i = 0; i < prob.count(); i++)
-		dfa.outSet(prob.get(i))->add(i);
-
-	// compute loop exit edges
-	for (CFG::BlockIter bb = cfg->blocks(); bb(); bb++) {
-
-		// compute loop entry
-		if(LOOP_HEADER(*bb)) {
-            EXIT_LIST(*bb) = new elm::Vector<Edge*>();
-            for (auto e: bb->inEdges())
-                if (!BACK_EDGE(e))
-                    LOOP_ENTRY(e) = *bb;
-        }
-
-		// process block in loops
-		if (ENCLOSING_LOOP_HEADER(*bb) || LOOP_HEADER(*bb))
-			for(Block::EdgeIter outedge = bb->outs(); outedge(); outedge++) {
-				// result = out set of edge source - out set of edge target
-				// result = { headers dominating source but not target }
-				dfa::BitSet *targetSet = dfa.outSet(outedge->target());
-				dfa::BitSet result(*dfa.outSet(*bb));
-				result.remove(*targetSet);
-
-				// last bit is the left outermost header
-				int h = -1;
-				for(dfa::BitSet::Iterator bit(result); bit(); bit++)
-					h = *bit;
-				if(h >= 0)
-					LOOP_EXIT_EDGE(*outedge) = prob.get(h);
+	// compute loop exit edges and lists
+	for(int i = 0; i < order.count(); i++)
+		if(loopOf(i) >= 0)
+			for(Block::EdgeIter outedge = order[i]->outs(); outedge(); outedge++) {
+				int h = exited(i, pre[outedge->sink()->index()]);
+				if(h >= 0) {
+					LOOP_EXIT(*outedge) = order[h];
+					EXIT_LIST(order[h])->add(*outedge);
+				}
 			}
-	}
-
-	// build loop exit lists
-	buildLoopExitList(cfg);
 
 	if(fst) { // only add the cleaner for the first time
 		addCleaner(LOOP_INFO_FEATURE, new LoopInfoCleaner(fw));
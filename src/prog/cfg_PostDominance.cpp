@@ -21,23 +21,19 @@
  */
 
 #include <otawa/cfg.h>
+#include <otawa/cfg/DomTree.h>
 #include <otawa/cfg/PostDominance.h>
-#include <otawa/dfa/BitSet.h>
-#include <otawa/dfa/IterativeDFA.h>
-#include <otawa/prop/DeletableProperty.h>
-
-using namespace otawa::dfa;
 
 namespace otawa {
 
 
 /**
- * Identifier of annotation containing reverse-post-dominance information.
+ * Identifier of annotation containing the post-dominator tree.
  *
  * @par Hooks
- * @li @ref BasicBlock
+ * @li @ref CFG
  */
-Identifier<BitSet *> REVERSE_POSTDOM("otawa::REVERSE_POSTDOM", 0);
+Identifier<DomTree *> POSTDOM_TREE("otawa::POSTDOM_TREE", nullptr);
 
 
 // default post-dominance
@@ -47,74 +43,19 @@ public:
 		ASSERT(b1);
 		ASSERT(b2);
 		ASSERTP(b1->cfg() == b2->cfg(), "both BB are not owned by the same CFG");
-		BitSet *set = REVERSE_POSTDOM(b2);
-		ASSERT(set);
-		return set->contains(b1->index());
-
+		const DomTree *tree = POSTDOM_TREE(b2->cfg());
+		ASSERT(tree);
+		return tree->dominates(b1, b2);
 	}
 };
 
 
-/**
- * This is the Problem used to instantiate DFAEngine for computing the
- * reverse post-domination relation. For each basic block, the set of post-dominators
- * is computed and hooked to the basic block. Then, a simple bit test is
- * used for testing the relation.
- */
-class PostDominanceProblem {
-	CFG *cfg;
-	int size;
-public:
-	PostDominanceProblem(CFG *_cfg) {
-		cfg = _cfg;
-		size = _cfg->count();
-	}
-
-	BitSet *empty(void) {
-		BitSet *result = new BitSet(size);
-		result->fill();
-		return result;
-	}
-
-	BitSet *gen(Block *bb) {
-		BitSet *result = new BitSet(size);
-		result->add(bb->index());
-		return result;
-	}
-
-	BitSet *kill(Block *bb) {
-		BitSet *result = new BitSet(size);
-		if(bb->isExit())
-			result->fill();
-		return(result);
-	}
-	bool equals(BitSet *set1, BitSet *set2) {
-		return(set1->equals(*set2));
-	}
-	void reset(BitSet *set) {
-		set->fill();
-	}
-	void merge(BitSet *set1, BitSet *set2) {
-		set1->mask(*set2);
-	}
-	void set(BitSet *dset, BitSet *tset) {
-		*dset = *tset;
-	}
-	void add(BitSet *dset, BitSet *tset) {
-		dset->add(*tset);
-	}
-	void diff(BitSet *dset, BitSet *tset) {
-		dset->remove(*tset);
-	}
-	void free(BitSet *set) { delete set; }
-};
-
-
-
 /**
  * @class PostDominance
  * @ingroup CFG
  * This CFG processor implements @ref POSTDOMINANCE_FEATURE.
+ * The relation is represented by the post-dominator tree (@ref DomTree)
+ * and the test is performed in constant time.
  *
  * @par Used Features
  *
@@ -127,24 +68,16 @@ public:
  */
 void PostDominance::processCFG(WorkSpace *fw, CFG *cfg) {
 	ASSERT(cfg);
-	PostDominanceProblem dp(cfg);
-	dfa::IterativeDFA<PostDominanceProblem, BitSet, CFG, Successor> engine(dp, cfg, cfg->exit());
-	engine.compute();
-	for (CFG::BlockIter blocks = cfg->blocks(); blocks(); blocks++) {
-	  BitSet *b = engine.outSet(blocks.item());
-	  b = new BitSet(*b);
-	  //blocks->addDeletable<BitSet *>(REVERSE_POSTDOM, b);
-	  blocks->addProp(new DeletableProperty<BitSet *>(REVERSE_POSTDOM, b));
-	}
+	POSTDOM_TREE(cfg) = new DomTree(cfg, true);
 }
 
 ///
 bool PostDominance::pdom(Block *b1, Block *b2) {
 	ASSERT(b1);
 	ASSERT(b2);
-	const BitSet *set = REVERSE_POSTDOM(b2);
-	ASSERT(set);
-	return set->contains(b1->index());
+	const DomTree *tree = POSTDOM_TREE(b2->cfg());
+	ASSERT(tree);
+	return tree->dominates(b1, b2);
 }
 
 ///
@@ -157,7 +90,8 @@ void *PostDominance::interfaceFor(const AbstractFeature& feature) {
 
 ///
 void PostDominance::destroyCFG(WorkSpace *ws, CFG *g) {
-	g->clean(REVERSE_POSTDOM);
+	delete POSTDOM_TREE(g);
+	g->removeProp(POSTDOM_TREE);
 }
 
 /**
@@ -187,7 +121,7 @@ PostDominance::PostDominance(p::declare& r): CFGProcessor(reg) {
  * @ingroup cfg
  *
  * @par Properties
- * @li @ref REVERSE_DOM (BasicBlock)
+ * @li @ref POSTDOM_TREE (CFG)
  */
 p::interfaced_feature<PostDomInfo> POSTDOMINANCE_FEATURE("otawa::POSTDOMINANCE_FEATURE", new Maker<PostDominance>());
 
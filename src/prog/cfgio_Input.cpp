@@ -29,6 +29,7 @@
 #include <otawa/cfg/features.h>
 #include <otawa/cfgio/features.h>
 #include <otawa/cfgio/Input.h>
+#include <otawa/cfgio/Snapshot.h>
 #include <otawa/proc/Processor.h>
 #include <otawa/prog/Process.h>
 #include <otawa/prog/TextDecoder.h>
@@ -172,6 +173,8 @@ public:
  * @endcode
  *
  * otawa::cfgio::FROM can be used to specified the PATH of the XML file to be read (the defualt is main.xml).
+ * If this file is a binary snapshot produced by cfgio::Output with otawa::cfgio::BINARY
+ * configuration (see @ref cfgio::Snapshot), it is loaded directly, without XML parsing.
  * @code
  * your_program --add-prop otawa::cfgio::FROM=PATH_TO_YOUR_XML_FILE
  * @endcode
@@ -209,6 +212,23 @@ void Input::configure(const PropList& props) {
  *
  */
 void Input::processWorkSpace(WorkSpace *ws) {
+
+	// binary snapshot
+	if(Snapshot::isSnapshot(path)) {
+		try {
+			coll = Snapshot::load(ws, path, *this);
+		}
+		catch(io::IOException& e) {
+			throw ProcessorException(*this, _ << "cannot load " << path << ": " << e.message());
+		}
+		catch(sys::SystemException& e) {
+			throw ProcessorException(*this, _ << "cannot load " << path << ": " << e.message());
+		}
+		if(logFor(LOG_DEPS))
+			log << "\tloaded " << coll->count() << " CFGs from snapshot " << path << io::endl;
+		return;
+	}
+
 	CFGFactory factory(ws);
 
 	// open the document
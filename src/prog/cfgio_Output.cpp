@@ -22,6 +22,7 @@
 #include <elm/xom/Serializer.h>
 
 #include <otawa/cfgio/Output.h>
+#include <otawa/cfgio/Snapshot.h>
 #include <otawa/ipet/features.h>
 #include <otawa/proc/ProcessorPlugin.h>
 #include <otawa/prog/Process.h>
@@ -68,6 +69,14 @@ p::id<Path> OUTPUT("otawa::cfgio::OUTPUT");
  */
 p::id<bool> LINE_INFO("otawa::cfgio::LINE_INFO", false);
 
+/**
+ * Used in the configuration of otawa::cfgio::Output to output the CFG collection
+ * as a binary snapshot (see @ref cfgio::Snapshot) instead of XML. Only the properties
+ * selected by otawa::cfgio::INCLUDE are stored in the snapshot.
+ * @ingroup cfgio
+ */
+p::id<bool> BINARY("otawa::cfgio::BINARY", false);
+
 /**
  * @defgroup cfgio	CFG Input / Output
  *
@@ -90,12 +99,13 @@ p::id<bool> LINE_INFO("otawa::cfgio::LINE_INFO", false);
  * @li @ref otawa::cfgio::INCLUDE -- include the identifier whose name is given in the output.
  * @li @ref otawa::cfgio::OUTPUT -- path to output file to (if not defined, output to standard output).
  * @li @ref otawa::cfgio::LINE_INFO -- emit source line information on output.
+ * @li @ref otawa::cfgio::BINARY -- output a binary snapshot instead of XML.
  * @ingroup cfgio
  */
 
 /**
  */
-Output::Output(void): BBProcessor(reg), root(0), cfg_node(0), last_bb(0), all(false), no_insts(false), line_info(false) {
+Output::Output(void): BBProcessor(reg), root(0), cfg_node(0), last_bb(0), all(false), no_insts(false), line_info(false), binary(false) {
 }
 
 
@@ -251,6 +261,7 @@ void Output::configure(const PropList& props) {
 	path = cfgio::OUTPUT(props);
 	no_insts = NO_INSTS(props);
 	line_info = LINE_INFO(props);
+	binary = BINARY(props);
 }
 
 
@@ -264,10 +275,10 @@ void Output::processWorkSpace(WorkSpace *ws) {
 			log << "\tproperty " << id->name() << " include in the output\n";
 
 	// build the root node
-	root = new xom::Element("cfg-collection");
-
-	// normal processing
-	BBProcessor::processWorkSpace(ws);
+	if(!binary) {
+		root = new xom::Element("cfg-collection");
+		BBProcessor::processWorkSpace(ws);
+	}
 
 	// open output
 	io::OutFileStream *file = 0;
@@ -282,11 +293,25 @@ void Output::processWorkSpace(WorkSpace *ws) {
 		out = file;
 	}
 
+	// output the snapshot
+	if(binary) {
+		try {
+			Snapshot::save(*COLLECTED_CFG_FEATURE.get(ws), out, ids);
+		}
+		catch(io::IOException& e) {
+			if(file)
+				delete file;
+			throw ProcessorException(*this, _ << "cannot write snapshot: " << e.message());
+		}
+	}
+
 	// output the XML
-	xom::Document doc(root);
-	xom::Serializer serial(*out);
-	serial.write(&doc);
-	serial.flush();
+	else {
+		xom::Document doc(root);
+		xom::Serializer serial(*out);
+		serial.write(&doc);
+		serial.flush();
+	}
 
 	// close file if needed
 	if(file)
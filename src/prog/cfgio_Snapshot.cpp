@@ -0,0 +1,438 @@
+/*
+ *	cfgio::Snapshot class implementation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <string.h>
+#include <elm/data/HashMap.h>
+#include <elm/io/InStream.h>
+#include <elm/sys/System.h>
+#include <otawa/cfgio/Snapshot.h>
+#include <otawa/proc/ProcessorPlugin.h>
+#include <otawa/prog/WorkSpace.h>
+
+#if defined(__unix) || defined(__APPLE__)
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#	define OTAWA_CFGIO_MMAP
+#endif
+
+namespace otawa { namespace cfgio {
+
+static const char SNAPSHOT_MAGIC[8] = { 'O', 'T', 'C', 'F', 'G', 'S', 'N', 'P' };
+static const t::uint32 SNAPSHOT_BOM = 0x01020304;
+
+static void write(io::OutStream *out, const void *p, int size) {
+	if(size != 0 && out->write(static_cast<const char *>(p), size) != size)
+		throw io::IOException(out->lastErrorMessage());
+}
+
+
+// memory image of a snapshot file
+class Image {
+public:
+
+	Image(const sys::Path& path): _base(nullptr), _size(0), _mapped(false) {
+#		ifdef OTAWA_CFGIO_MMAP
+			int fd = ::open(path.toString().toCString(), O_RDONLY);
+			if(fd >= 0) {
+				struct stat st;
+				if(fstat(fd, &st) == 0 && st.st_size > 0) {
+					void *p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+					if(p != MAP_FAILED) {
+						_base = static_cast<const char *>(p);
+						_size = st.st_size;
+						_mapped = true;
+					}
+				}
+				::close(fd);
+				if(_mapped)
+					return;
+			}
+#		endif
+
+		// fall back: read the whole file
+		io::InStream *in = sys::System::readFile(path);
+		Vector<char> buf;
+		char chunk[4096];
+		while(true) {
+			int n = in->read(chunk, sizeof(chunk));
+			if(n < 0) {
+				delete in;
+				throw io::IOException(_ << "cannot read " << path);
+			}
+			if(n == 0)
+				break;
+			for(int i = 0; i < n; i++)
+				buf.add(chunk[i]);
+		}
+		delete in;
+		char *p = new char[buf.length() + 1];
+		for(int i = 0; i < buf.length(); i++)
+			p[i] = buf[i];
+		_base = p;
+		_size = buf.length();
+	}
+
+	~Image(void) {
+#		ifdef OTAWA_CFGIO_MMAP
+			if(_mapped) {
+				munmap(const_cast<char *>(_base), _size);
+				return;
+			}
+#		endif
+		delete [] _base;
+	}
+
+	inline const char *base(void) const { return _base; }
+	inline size_t size(void) const { return _size; }
+
+private:
+	const char *_base;
+	size_t _size;
+	bool _mapped;
+};
+
+
+/**
+ * @class Snapshot
+ * Binary snapshot of a CFG collection. Unlike the XML format, the snapshot
+ * is made of fixed-size records that are directly used from the memory
+ * image of the file (mapped in memory when the OS supports it) without
+ * any parsing:
+ * @li a header (@ref header_t) giving the number of elements of each table,
+ * @li the CFG table (@ref cfg_t) with entry address and ranges of blocks
+ *     and edges of each CFG,
+ * @li the block table (@ref block_t) with kind, address range of basic blocks
+ *     and index of the called CFG for call blocks,
+ * @li the edge table (@ref edge_t) with source and target given as block
+ *     indexes inside the CFG and edge flags,
+ * @li the property table (@ref prop_t) with owner, identifier and value,
+ * @li the string table referenced by offset from the other tables.
+ *
+ * Addresses are stored as a page number and a 32-bit offset in the page.
+ *
+ * Only the properties whose identifier supports to be printed and re-read
+ * (see @ref AbstractIdentifier::fromString()) should be stored.
+ *
+ * The records are stored in the byte order of the host: a snapshot cannot be
+ * used on a host with a different byte order.
+ *
+ * @ingroup cfgio
+ */
+
+
+/**
+ * Test if the given file is a CFG snapshot.
+ * @param path	Path of the file.
+ * @return		True if it is a snapshot, false else.
+ */
+bool Snapshot::isSnapshot(const sys::Path& path) {
+	if(!path.exists())
+		return false;
+	try {
+		io::InStream *in = sys::System::readFile(path);
+		char magic[sizeof(SNAPSHOT_MAGIC)];
+		int n = in->read(magic, sizeof(magic));
+		delete in;
+		return n == sizeof(magic) && memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) == 0;
+	}
+	catch(sys::SystemException& e) {
+		return false;
+	}
+	catch(io::IOException& e) {
+		return false;
+	}
+}
+
+
+/**
+ * Save a CFG collection in snapshot format.
+ * @param coll	Collection to save.
+ * @param out	Stream to output to.
+ * @param ids	Identifiers of the properties to save.
+ * @throw io::IOException	If there is an output error or the CFGs cannot be saved.
+ */
+void Snapshot::save(const CFGCollection& coll, io::OutStream *out, const avl::Set<const AbstractIdentifier *>& ids) {
+	Vector<cfg_t> cfgs;
+	Vector<block_t> blocks;
+	Vector<edge_t> edges;
+	Vector<prop_t> props;
+	Vector<char> strs;
+	HashMap<string, t::uint32> str_map;
+
+	// string table management
+	auto str = [&strs, &str_map](const string& s) -> t::uint32 {
+		t::uint32 o = str_map.get(s, strs.length());
+		if(o == t::uint32(strs.length())) {
+			str_map.put(s, o);
+			for(int i = 0; i < s.length(); i++)
+				strs.add(s[i]);
+			strs.add('\0');
+		}
+		return o;
+	};
+
+	// property table management
+	auto add_props = [&props, &ids, &str](owner_t kind, t::uint32 owner, const PropList& l) {
+		if(ids.isEmpty())
+			return;
+		for(PropList::Iter prop(l); prop(); prop++)
+			if(ids.contains(prop->id())) {
+				StringBuffer buf;
+				prop->id()->print(buf, *prop);
+				prop_t p;
+				p.owner_kind = kind;
+				p.owner = owner;
+				p.id = str(prop->id()->name());
+				p.value = str(buf.toString());
+				props.add(p);
+			}
+	};
+
+	// build the tables
+	for(auto g: coll) {
+		cfg_t c;
+		c.page = g->address().page();
+		c.address = g->address().offset();
+		c.label = str(g->label());
+		c.block = blocks.length();
+		c.block_count = g->count();
+		c.edge = edges.length();
+		add_props(ON_CFG, cfgs.length(), *g);
+
+		for(auto v: *g) {
+			block_t b;
+			b.page = 0;
+			b.address = 0;
+			b.size = 0;
+			b.callee = -1;
+			if(v->isEntry())
+				b.kind = ENTRY;
+			else if(v->isExit())
+				b.kind = EXIT;
+			else if(v->isUnknown())
+				b.kind = UNKNOWN;
+			else if(v->isBasic()) {
+				b.kind = BASIC;
+				b.page = v->toBasic()->address().page();
+				b.address = v->toBasic()->address().offset();
+				b.size = v->toBasic()->size();
+			}
+			else if(v->isCall()) {
+				b.kind = CALL;
+				if(v->toSynth()->callee() != nullptr)
+					b.callee = v->toSynth()->callee()->index();
+			}
+			else
+				throw io::IOException(_ << "cannot save block " << v << " in a CFG snapshot");
+			add_props(ON_BLOCK, blocks.length(), *v);
+			blocks.add(b);
+
+			for(Block::EdgeIter e = v->outs(); e(); e++) {
+				edge_t d;
+				d.source = e->source()->index();
+				d.target = e->target()->index();
+				d.flags = e->flags();
+				add_props(ON_EDGE, edges.length(), **e);
+				edges.add(d);
+			}
+		}
+
+		c.edge_count = edges.length() - c.edge;
+		cfgs.add(c);
+	}
+	while(strs.length() % 4 != 0)
+		strs.add('\0');
+
+	// write the file
+	header_t h;
+	memcpy(h.magic, SNAPSHOT_MAGIC, sizeof(h.magic));
+	h.version = VERSION;
+	h.bom = SNAPSHOT_BOM;
+	h.cfg_count = cfgs.length();
+	h.block_count = blocks.length();
+	h.edge_count = edges.length();
+	h.prop_count = props.length();
+	h.string_size = strs.length();
+	h.pad = 0;
+	write(out, &h, sizeof(h));
+	if(cfgs)
+		write(out, &cfgs[0], cfgs.length() * sizeof(cfg_t));
+	if(blocks)
+		write(out, &blocks[0], blocks.length() * sizeof(block_t));
+	if(edges)
+		write(out, &edges[0], edges.length() * sizeof(edge_t));
+	if(props)
+		write(out, &props[0], props.length() * sizeof(prop_t));
+	if(strs)
+		write(out, &strs[0], strs.length());
+	out->flush();
+}
+
+
+/**
+ * Load a CFG collection from a snapshot file.
+ * @param ws	Current workspace (instructions must be decoded).
+ * @param path	Path of the snapshot.
+ * @param mon	Monitor to display warnings.
+ * @return		Built collection.
+ * @throw io::IOException	If the snapshot is not valid or does not match the program.
+ * @throw sys::SystemException	If the file cannot be opened.
+ */
+CFGCollection *Snapshot::load(WorkSpace *ws, const sys::Path& path, Monitor& mon) {
+	Image image(path);
+
+	// check the header
+	if(image.size() < sizeof(header_t))
+		throw io::IOException(_ << path << " is not a CFG snapshot");
+	const header_t *h = reinterpret_cast<const header_t *>(image.base());
+	if(memcmp(h->magic, SNAPSHOT_MAGIC, sizeof(h->magic)) != 0)
+		throw io::IOException(_ << path << " is not a CFG snapshot");
+	if(h->bom != SNAPSHOT_BOM)
+		throw io::IOException(_ << path << " is a CFG snapshot of a host with a different byte order");
+	if(h->version != VERSION)
+		throw io::IOException(_ << path << " is a CFG snapshot of unsupported version " << h->version);
+	size_t size = sizeof(header_t)
+		+ size_t(h->cfg_count) * sizeof(cfg_t)
+		+ size_t(h->block_count) * sizeof(block_t)
+		+ size_t(h->edge_count) * sizeof(edge_t)
+		+ size_t(h->prop_count) * sizeof(prop_t)
+		+ h->string_size;
+	if(image.size() < size || (h->string_size != 0 && image.base()[size - 1] != '\0'))
+		throw io::IOException(_ << "truncated CFG snapshot " << path);
+
+	// get the tables
+	const cfg_t *cfgs = reinterpret_cast<const cfg_t *>(h + 1);
+	const block_t *blocks = reinterpret_cast<const block_t *>(cfgs + h->cfg_count);
+	const edge_t *edges = reinterpret_cast<const edge_t *>(blocks + h->block_count);
+	const prop_t *props = reinterpret_cast<const prop_t *>(edges + h->edge_count);
+	const char *strs = reinterpret_cast<const char *>(props + h->prop_count);
+	auto check = [&path](bool cond) {
+		if(!cond)
+			throw io::IOException(_ << "corrupted CFG snapshot " << path);
+	};
+
+	// build the CFG makers
+	Vector<CFGMaker *> makers;
+	Vector<Block *> vs;
+	Vector<Edge *> es;
+	CFGCollection *coll = nullptr;
+	try {
+		for(t::uint32 i = 0; i < h->cfg_count; i++) {
+			Address a(cfgs[i].page, cfgs[i].address);
+			Inst *first = ws->findInstAt(a);
+			if(first == nullptr)
+				throw io::IOException(_ << "no instruction at " << a << " for CFG in " << path);
+			makers.add(new CFGMaker(first));
+		}
+
+		// build the blocks and the edges
+		for(t::uint32 i = 0; i < h->cfg_count; i++) {
+			const cfg_t& c = cfgs[i];
+			CFGMaker *g = makers[i];
+			check(c.block + c.block_count <= h->block_count && c.edge + c.edge_count <= h->edge_count);
+			for(t::uint32 j = c.block; j < c.block + c.block_count; j++) {
+				const block_t& b = blocks[j];
+				switch(b.kind) {
+				case ENTRY:
+					vs.add(g->entry());
+					break;
+				case EXIT:
+					vs.add(g->exit());
+					break;
+				case UNKNOWN:
+					vs.add(g->unknown());
+					break;
+				case BASIC: {
+						Vector<Inst *> is;
+						Address a(b.page, b.address);
+						Address ea = a + b.size;
+						for(auto i = ws->findInstAt(a); i != nullptr && i->address() < ea; i = i->nextInst())
+							is.add(i);
+						check(!is.isEmpty());
+						BasicBlock *bb = new BasicBlock(is.detach());
+						g->add(bb);
+						vs.add(bb);
+					}
+					break;
+				case CALL: {
+						SynthBlock *sb = new SynthBlock();
+						if(b.callee < 0)
+							g->call(sb, static_cast<CFG *>(nullptr));
+						else {
+							check(t::uint32(b.callee) < h->cfg_count);
+							g->call(sb, *makers[b.callee]);
+						}
+						vs.add(sb);
+					}
+					break;
+				default:
+					check(false);
+					break;
+				}
+			}
+			for(t::uint32 j = c.edge; j < c.edge + c.edge_count; j++) {
+				const edge_t& e = edges[j];
+				check(e.source < c.block_count && e.target < c.block_count);
+				Edge *edge = new Edge(e.flags);
+				g->add(vs[c.block + e.source], vs[c.block + e.target], edge);
+				es.add(edge);
+			}
+		}
+
+		// build the collection
+		coll = new CFGCollection();
+		for(auto m: makers)
+			coll->add(m->build());
+
+		// install the properties
+		for(t::uint32 i = 0; i < h->prop_count; i++) {
+			const prop_t& p = props[i];
+			check(p.id < h->string_size && p.value < h->string_size);
+			PropList *l = nullptr;
+			switch(p.owner_kind) {
+			case ON_CFG:	check(p.owner < h->cfg_count); l = coll->get(p.owner); break;
+			case ON_BLOCK:	check(p.owner < h->block_count); l = vs[p.owner]; break;
+			case ON_EDGE:	check(p.owner < h->edge_count); l = es[p.owner]; break;
+			default:		check(false); break;
+			}
+			AbstractIdentifier *id = ProcessorPlugin::getIdentifier(strs + p.id);
+			if(id == nullptr)
+				mon.log << "WARNING: cannot find identifier " << (strs + p.id) << ". Property ignored!\n";
+			else
+				id->fromString(*l, strs + p.value);
+		}
+	}
+	catch(io::IOException& e) {
+		for(auto m: makers)
+			delete m;
+		if(coll != nullptr)
+			delete coll;
+		throw;
+	}
+
+	for(auto m: makers)
+		delete m;
+	return coll;
+}
+
+} }	// otawa::cfgio
@@ -0,0 +1,579 @@
+/*
+ *	AdaptiveBitVector class implementation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <string.h>
+#include <otawa/dfa/AdaptiveBitVector.h>
+
+namespace otawa { namespace dfa {
+
+/**
+ * @class AdaptiveBitVector
+ * Bit vector whose representation changes at run-time according to its
+ * population, in the way of roaring bitmaps:
+ * @li sparse -- sorted array of the indexes of set bits,
+ * @li dense -- usual array of bit words.
+ *
+ * A vector switches to dense as soon as the sparse array would be bigger
+ * than the word array and gets back to sparse when its population falls
+ * under a quarter of the word count (the gap avoids to switch back and forth
+ * around the threshold). Vectors fitting in two words are always dense.
+ *
+ * As the population is maintained, many operations are resolved without
+ * scanning the data (empty or full operands, different counts for equality
+ * and inclusion). The interface is the one of elm::BitVector used by
+ * @ref BitSet.
+ *
+ * @ingroup dfa
+ */
+
+
+/**
+ * Build a vector.
+ * @param size	Bit count.
+ * @param set	Initial value of the bits.
+ */
+AdaptiveBitVector::AdaptiveBitVector(int size, bool set)
+: _size(size), _count(0), _cap(0), _dense(true), _data(nullptr) {
+	if(set)
+		this->set();
+	else
+		clear();
+}
+
+
+/**
+ * Build by copy.
+ * @param v		Copied vector.
+ */
+AdaptiveBitVector::AdaptiveBitVector(const AdaptiveBitVector& v)
+: _size(0), _count(0), _cap(0), _dense(true), _data(nullptr) {
+	*this = v;
+}
+
+
+/**
+ * Assignment.
+ * @param v		Assigned vector.
+ */
+AdaptiveBitVector& AdaptiveBitVector::operator=(const AdaptiveBitVector& v) {
+	if(this == &v)
+		return *this;
+	int n = v._dense ? v.words() : v._count;
+	if(_cap < n || _cap > 2 * n) {
+		delete [] _data;
+		_data = n == 0 ? nullptr : new word_t[n];
+		_cap = n;
+	}
+	if(n != 0)
+		memcpy(_data, v._data, n * sizeof(word_t));
+	_size = v._size;
+	_count = v._count;
+	_dense = v._dense;
+	return *this;
+}
+
+
+/**
+ * @fn int AdaptiveBitVector::__size(void) const;
+ * Get the memory size of the vector in bytes.
+ * @return	Memory size.
+ */
+
+
+/**
+ * @fn bool AdaptiveBitVector::isDense(void) const;
+ * Test if the vector currently uses the dense representation.
+ * @return	True if dense, false if sparse.
+ */
+
+
+/**
+ * @fn int AdaptiveBitVector::size(void) const;
+ * Get the bit count.
+ * @return	Bit count.
+ */
+
+
+/**
+ * @fn int AdaptiveBitVector::countBits(void) const;
+ * Get the number of set bits (constant time).
+ * @return	Set bit count.
+ */
+
+
+/**
+ * Test a bit.
+ * @param i		Bit index.
+ * @return		Bit value.
+ */
+bool AdaptiveBitVector::bit(int i) const {
+	ASSERT(0 <= i && i < _size);
+	if(_dense)
+		return (_data[i >> 5] & (word_t(1) << (i & 31))) != 0;
+	else {
+		int p = find(i);
+		return p < _count && int(_data[p]) == i;
+	}
+}
+
+
+/**
+ * Set a bit.
+ * @param i		Bit index.
+ */
+void AdaptiveBitVector::set(int i) {
+	ASSERT(0 <= i && i < _size);
+	if(_dense) {
+		word_t m = word_t(1) << (i & 31);
+		if(!(_data[i >> 5] & m)) {
+			_data[i >> 5] |= m;
+			_count++;
+		}
+		return;
+	}
+	int p = find(i);
+	if(p < _count && int(_data[p]) == i)
+		return;
+	if(_count == _cap) {
+		int cap = _cap == 0 ? 4 : 2 * _cap;
+		word_t *data = new word_t[cap];
+		if(_data != nullptr) {
+			memcpy(data, _data, p * sizeof(word_t));
+			memcpy(data + p + 1, _data + p, (_count - p) * sizeof(word_t));
+			delete [] _data;
+		}
+		_data = data;
+		_cap = cap;
+	}
+	else
+		memmove(_data + p + 1, _data + p, (_count - p) * sizeof(word_t));
+	_data[p] = i;
+	_count++;
+	adapt();
+}
+
+
+/**
+ * Clear a bit.
+ * @param i		Bit index.
+ */
+void AdaptiveBitVector::clear(int i) {
+	ASSERT(0 <= i && i < _size);
+	if(_dense) {
+		word_t m = word_t(1) << (i & 31);
+		if(_data[i >> 5] & m) {
+			_data[i >> 5] &= ~m;
+			_count--;
+			adapt();
+		}
+	}
+	else {
+		int p = find(i);
+		if(p < _count && int(_data[p]) == i) {
+			memmove(_data + p, _data + p + 1, (_count - p - 1) * sizeof(word_t));
+			_count--;
+		}
+	}
+}
+
+
+/**
+ * Set all bits.
+ */
+void AdaptiveBitVector::set(void) {
+	int n = words();
+	if(_cap < n || _cap > 2 * n) {
+		delete [] _data;
+		_data = n == 0 ? nullptr : new word_t[n];
+		_cap = n;
+	}
+	for(int i = 0; i < n; i++)
+		_data[i] = ~word_t(0);
+	if(n != 0)
+		_data[n - 1] = mask();
+	_dense = true;
+	_count = _size;
+}
+
+
+/**
+ * Clear all bits.
+ */
+void AdaptiveBitVector::clear(void) {
+	int n = words();
+	_count = 0;
+	if(n <= 2) {
+		if(_cap < n) {
+			delete [] _data;
+			_data = new word_t[n];
+			_cap = n;
+		}
+		for(int i = 0; i < n; i++)
+			_data[i] = 0;
+		_dense = true;
+	}
+	else {
+		if(_dense) {
+			delete [] _data;
+			_data = nullptr;
+			_cap = 0;
+		}
+		_dense = false;
+	}
+}
+
+
+/**
+ * Test if both vectors are equal.
+ * @param v		Vector to compare with.
+ * @return		True if they are equal, false else.
+ */
+bool AdaptiveBitVector::equals(const AdaptiveBitVector& v) const {
+	ASSERT(_size == v._size);
+	if(_count != v._count)
+		return false;
+	if(_count == 0 || _count == _size)
+		return true;
+	if(_dense && v._dense)
+		return memcmp(_data, v._data, words() * sizeof(word_t)) == 0;
+	else if(!_dense && !v._dense)
+		return memcmp(_data, v._data, _count * sizeof(word_t)) == 0;
+	else {
+		// same population: the sparse items must all be in the dense one
+		const AdaptiveBitVector& s = _dense ? v : *this, & d = _dense ? *this : v;
+		for(int i = 0; i < s._count; i++)
+			if(!d.bit(s._data[i]))
+				return false;
+		return true;
+	}
+}
+
+
+/**
+ * Test if the current vector includes the given one.
+ * @param v		Vector to test.
+ * @return		True if v is included, false else.
+ */
+bool AdaptiveBitVector::includes(const AdaptiveBitVector& v) const {
+	ASSERT(_size == v._size);
+	if(v._count > _count)
+		return false;
+	if(v._count == 0 || _count == _size)
+		return true;
+	if(_dense && v._dense) {
+		for(int i = 0; i < words(); i++)
+			if(v._data[i] & ~_data[i])
+				return false;
+		return true;
+	}
+	else if(!_dense && !v._dense) {
+		int j = 0;
+		for(int i = 0; i < v._count; i++) {
+			while(j < _count && _data[j] < v._data[i])
+				j++;
+			if(j >= _count || _data[j] != v._data[i])
+				return false;
+		}
+		return true;
+	}
+	else {
+		for(OneIterator i(v); i(); i++)
+			if(!bit(*i))
+				return false;
+		return true;
+	}
+}
+
+
+/**
+ * @fn bool AdaptiveBitVector::includesStrictly(const AdaptiveBitVector& v) const;
+ * Test if the current vector includes strictly the given one.
+ * @param v		Vector to test.
+ * @return		True if v is strictly included, false else.
+ */
+
+
+/**
+ * Test if both vectors have at least one common set bit.
+ * @param v		Vector to test.
+ * @return		True if they meet, false else.
+ */
+bool AdaptiveBitVector::meets(const AdaptiveBitVector& v) const {
+	ASSERT(_size == v._size);
+	if(_count == 0 || v._count == 0)
+		return false;
+	if(_count + v._count > _size)
+		return true;
+	if(_dense && v._dense) {
+		for(int i = 0; i < words(); i++)
+			if(_data[i] & v._data[i])
+				return true;
+		return false;
+	}
+	else {
+		const AdaptiveBitVector& s = _dense ? v : *this, & o = _dense ? *this : v;
+		for(int i = 0; i < s._count; i++)
+			if(o.bit(s._data[i]))
+				return true;
+		return false;
+	}
+}
+
+
+/**
+ * Invert all bits.
+ */
+void AdaptiveBitVector::applyNot(void) {
+	if(_count == 0) {
+		set();
+		return;
+	}
+	if(_count == _size) {
+		clear();
+		return;
+	}
+	if(!_dense)
+		toDense();
+	int n = words();
+	for(int i = 0; i < n; i++)
+		_data[i] = ~_data[i];
+	_data[n - 1] &= mask();
+	_count = _size - _count;
+	adapt();
+}
+
+
+/**
+ * Perform union with the given vector.
+ * @param v		Vector to join with.
+ */
+void AdaptiveBitVector::applyOr(const AdaptiveBitVector& v) {
+	ASSERT(_size == v._size);
+	if(v._count == 0 || _count == _size)
+		return;
+	if(v._count == _size)
+		set();
+	else if(_count == 0)
+		*this = v;
+	else if(v._dense) {
+		if(!_dense)
+			toDense();
+		for(int i = 0; i < words(); i++)
+			_data[i] |= v._data[i];
+		recount();
+	}
+	else if(_dense) {
+		for(int i = 0; i < v._count; i++)
+			set(v._data[i]);
+	}
+	else {
+		word_t *data = new word_t[_count + v._count];
+		int i = 0, j = 0, k = 0;
+		while(i < _count && j < v._count) {
+			if(_data[i] < v._data[j])
+				data[k++] = _data[i++];
+			else if(v._data[j] < _data[i])
+				data[k++] = v._data[j++];
+			else {
+				data[k++] = _data[i++];
+				j++;
+			}
+		}
+		while(i < _count)
+			data[k++] = _data[i++];
+		while(j < v._count)
+			data[k++] = v._data[j++];
+		delete [] _data;
+		_data = data;
+		_cap = _count + v._count;
+		_count = k;
+		adapt();
+	}
+}
+
+
+/**
+ * Perform intersection with the given vector.
+ * @param v		Vector to intersect with.
+ */
+void AdaptiveBitVector::applyAnd(const AdaptiveBitVector& v) {
+	ASSERT(_size == v._size);
+	if(_count == 0 || v._count == _size)
+		return;
+	if(v._count == 0)
+		clear();
+	else if(_count == _size)
+		*this = v;
+	else if(_dense && v._dense) {
+		for(int i = 0; i < words(); i++)
+			_data[i] &= v._data[i];
+		recount();
+		adapt();
+	}
+	else if(!_dense) {
+		int k = 0;
+		for(int i = 0; i < _count; i++)
+			if(v.bit(_data[i]))
+				_data[k++] = _data[i];
+		_count = k;
+	}
+	else {
+		AdaptiveBitVector r(v);
+		int k = 0;
+		for(int i = 0; i < r._count; i++)
+			if(bit(r._data[i]))
+				r._data[k++] = r._data[i];
+		r._count = k;
+		*this = r;
+	}
+}
+
+
+/**
+ * Remove from the current vector the bits set in the given one.
+ * @param v		Vector of bits to reset.
+ */
+void AdaptiveBitVector::applyReset(const AdaptiveBitVector& v) {
+	ASSERT(_size == v._size);
+	if(_count == 0 || v._count == 0)
+		return;
+	if(v._count == _size)
+		clear();
+	else if(_dense && v._dense) {
+		for(int i = 0; i < words(); i++)
+			_data[i] &= ~v._data[i];
+		recount();
+		adapt();
+	}
+	else if(!_dense) {
+		int k = 0;
+		for(int i = 0; i < _count; i++)
+			if(!v.bit(_data[i]))
+				_data[k++] = _data[i];
+		_count = k;
+	}
+	else {
+		for(int i = 0; i < v._count; i++)
+			_data[v._data[i] >> 5] &= ~(word_t(1) << (v._data[i] & 31));
+		recount();
+		adapt();
+	}
+}
+
+
+/**
+ * Find the position of an index in the sparse array.
+ * @param i		Looked index.
+ * @return		Position of i or, if not found, position where it must be inserted.
+ */
+int AdaptiveBitVector::find(int i) const {
+	int l = 0, h = _count;
+	while(l < h) {
+		int m = (l + h) >> 1;
+		if(int(_data[m]) < i)
+			l = m + 1;
+		else
+			h = m;
+	}
+	return l;
+}
+
+
+/**
+ * Switch to the dense representation.
+ */
+void AdaptiveBitVector::toDense(void) {
+	int n = words();
+	word_t *data = new word_t[n];
+	for(int i = 0; i < n; i++)
+		data[i] = 0;
+	for(int i = 0; i < _count; i++)
+		data[_data[i] >> 5] |= word_t(1) << (_data[i] & 31);
+	delete [] _data;
+	_data = data;
+	_cap = n;
+	_dense = true;
+}
+
+
+/**
+ * Switch to the sparse representation.
+ */
+void AdaptiveBitVector::toSparse(void) {
+	word_t *data = _count == 0 ? nullptr : new word_t[_count];
+	int k = 0;
+	for(OneIterator i(*this); i(); i++)
+		data[k++] = *i;
+	delete [] _data;
+	_data = data;
+	_cap = _count;
+	_dense = false;
+}
+
+
+/**
+ * Select the representation according to the population.
+ */
+void AdaptiveBitVector::adapt(void) {
+	int n = words();
+	if(_dense) {
+		if(n > 2 && _count <= n / 4)
+			toSparse();
+	}
+	else if(n <= 2 || _count > n)
+		toDense();
+}
+
+
+/**
+ * Recompute the population of a dense vector.
+ */
+void AdaptiveBitVector::recount(void) {
+	_count = 0;
+	for(int i = 0; i < words(); i++)
+		_count += __builtin_popcount(_data[i]);
+}
+
+
+/**
+ * @class AdaptiveBitVector::OneIterator
+ * Iterator on the indexes of the set bits of an @ref AdaptiveBitVector,
+ * in increasing order.
+ */
+
+
+/**
+ */
+void AdaptiveBitVector::OneIterator::next(void) {
+	_i++;
+	if(!_v._dense)
+		return;
+	while(_i < _v._size) {
+		word_t w = _v._data[_i >> 5] >> (_i & 31);
+		if(w != 0) {
+			_i += __builtin_ctz(w);
+			return;
+		}
+		_i = (_i + 32) & ~31;
+	}
+}
+
+} }	// otawa::dfa
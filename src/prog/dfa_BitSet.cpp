@@ -27,6 +27,13 @@ namespace otawa { namespace dfa {
  * This class implements a set as a bit vector. You must assign each
  * object of the set to an index in the bit vector and use it to process
  * sets containing it.
+ *
+ * By default, the storage is an @ref AdaptiveBitVector that keeps sparse sets
+ * as arrays of indexes and switches to plain bit words when they get
+ * populated. The implementation may be changed at compile time by defining:
+ * @li OTAWA_BITSET_DENSE -- always dense elm::BitVector,
+ * @li OTAWA_BITSET_WAH -- compressed elm::WAHVector,
+ * @li OTAWA_BITSET_BOTH -- elm::BitVector and elm::WAHVector cross-checked (debugging).
  */
 
 
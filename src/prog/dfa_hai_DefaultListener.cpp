@@ -25,8 +25,26 @@ namespace otawa { namespace dfa { namespace hai {
  * This listener gathers in an array the LUB of the in-states for all analyzed basic blocks.
  * At the end of the analysis, you can access result[CFGNUMBER][BBNUMBER] to obtain
  * the in-state of the basic block BBNUMBER of cfg CFGNUMBER.
+ *
+ * The states are stored contiguously in a @ref BlockArrayStore indexed by
+ * @ref Block::id() and can also be accessed with in() and out().
  * 
  */
+
+/**
+ * @fn const typename Problem::Domain& DefaultListener::in(Block *bb) const;
+ * Get the LUB of the in-states of the given block.
+ * @param bb	Looked block.
+ * @return		In-state of bb.
+ */
+
+/**
+ * @fn const typename Problem::Domain& DefaultListener::out(Block *bb) const;
+ * Get the LUB of the out-states of the given block (only available if
+ * the listener has been built to store the out-states).
+ * @param bb	Looked block.
+ * @return		Out-state of bb.
+ */
  
 /**
  * @fn void DefaultListener::blockInterpreted (const DefaultFixPoint< DefaultListener > *fp, BasicBlock *bb, const typename Problem::Domain &in, const typename Problem::Domain &out, CFG *cur_cfg) const
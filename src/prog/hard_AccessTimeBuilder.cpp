@@ -0,0 +1,144 @@
+/*
+ *	AccessTimeBuilder class implementation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ *	02110-1301  USA
+ */
+
+#include <otawa/cfg/BasicBlock.h>
+#include <otawa/hard/Memory.h>
+#include <otawa/proc/BBProcessor.h>
+#include <otawa/prog/Inst.h>
+#include <otawa/stack/AccessedAddress.h>
+#include <otawa/stack/features.h>
+
+namespace otawa { namespace hard {
+
+/**
+ * Default implementation of @ref ACCESS_TIME_FEATURE. For each memory
+ * access found by the address analysis, the bank is looked up once and its
+ * latency is recorded on the instruction:
+ * @li absolute address -- read or write latency of the bank containing it
+ * (worst time of the memory if no bank matches),
+ * @li other addresses -- best and worst read or write time of the memory.
+ *
+ * When an instruction performs several accesses, the recorded range covers
+ * all of them.
+ *
+ * @par Required Features
+ * @li @ref MEMORY_FEATURE
+ * @li @ref stack::ADDRESS_FEATURE
+ *
+ * @par Provided Features
+ * @li @ref ACCESS_TIME_FEATURE
+ *
+ * @ingroup hard
+ */
+class AccessTimeBuilder: public BBProcessor {
+public:
+	static p::declare reg;
+	AccessTimeBuilder(p::declare& r = reg): BBProcessor(r), mem(nullptr) { }
+
+protected:
+
+	void setup(WorkSpace *ws) override {
+		mem = MEMORY_FEATURE.get(ws);
+	}
+
+	void processBB(WorkSpace *ws, CFG *cfg, Block *b) override {
+		if(!b->isBasic())
+			return;
+		AccessedAddresses *addrs = ADDRESSES(b);
+		if(addrs == nullptr)
+			return;
+		for(int i = 0; i < addrs->size(); i++) {
+			AccessedAddress *a = addrs->get(i);
+			Pair<ot::time, ot::time> t = range(a);
+			if(ACCESS_TIME(a->instruction()).exists()) {
+				Pair<ot::time, ot::time> pt = ACCESS_TIME(a->instruction());
+				t = pair(min(t.fst, pt.fst), max(t.snd, pt.snd));
+			}
+			ACCESS_TIME(a->instruction()) = t;
+			if(logFor(LOG_INST))
+				log << "\t\t\t" << a->instruction()->address() << ": ["
+					<< t.fst << ", " << t.snd << "]\n";
+		}
+	}
+
+	void destroyBB(WorkSpace *ws, CFG *cfg, Block *b) override {
+		if(b->isBasic())
+			for(auto i: *b->toBasic())
+				ACCESS_TIME(i).remove();
+	}
+
+private:
+
+	Pair<ot::time, ot::time> range(AccessedAddress *a) {
+		if(a->kind() == AccessedAddress::ABS) {
+			ot::time t = a->isStore()
+				? mem->writeTime(static_cast<AbsAddress *>(a)->address())
+				: mem->readTime(static_cast<AbsAddress *>(a)->address());
+			return pair(t, t);
+		}
+		else if(a->isStore())
+			return pair(mem->bestWriteTime(), mem->worstWriteTime());
+		else
+			return pair(mem->bestReadTime(), mem->worstReadTime());
+	}
+
+	const Memory *mem;
+};
+
+p::declare AccessTimeBuilder::reg = p::init("otawa::hard::AccessTimeBuilder", Version(1, 0, 0))
+	.extend<BBProcessor>()
+	.make<AccessTimeBuilder>()
+	.require(MEMORY_FEATURE)
+	.require(stack::ADDRESS_FEATURE)
+	.provide(ACCESS_TIME_FEATURE);
+
+
+/**
+ * This feature ensures that each instruction accessing the memory is
+ * annotated with the range of latencies of its accesses (@ref ACCESS_TIME).
+ * This avoids to look up again the banks for each timing event.
+ *
+ * @par Properties
+ * @li @ref ACCESS_TIME
+ *
+ * @par Default processor
+ * @li @ref AccessTimeBuilder
+ *
+ * @ingroup hard
+ */
+p::feature ACCESS_TIME_FEATURE("otawa::hard::ACCESS_TIME_FEATURE", p::make<AccessTimeBuilder>());
+
+
+/**
+ * Range (best, worst) of the latency of one memory access of the instruction.
+ *
+ * @par Hooks
+ * @li @ref Inst
+ *
+ * @par Features
+ * @li @ref ACCESS_TIME_FEATURE
+ *
+ * @ingroup hard
+ */
+p::id<Pair<ot::time, ot::time> > ACCESS_TIME("otawa::hard::ACCESS_TIME");
+
+} }	// otawa::hard
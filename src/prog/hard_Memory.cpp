@@ -19,6 +19,8 @@
  *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <elm/data/quicksort.h>
+#include <elm/data/Vector.h>
 #include <otawa/prog/WorkSpace.h>
 #include <otawa/hard/Memory.h>
 #include <elm/serial2/XOMUnserializer.h>
@@ -353,6 +355,10 @@ static Bank full("RAM", 0, 0);
 /**
  * @class Memory
  * Class to represent the whole memory of the platform.
+ *
+ * As the bank index is built lazily under a lock (see get()), a memory
+ * description cannot be copied: it is handled by pointer, as provided
+ * by @ref MEMORY_FEATURE.
  * @author H. Cassé <casse@irit.fr>
  * @ingroup hard
  */
@@ -390,13 +396,106 @@ const Memory Memory::full(true);
  * @return			Found bank or null.
  */
 const Bank *Memory::get(Address address) const {
-	for(int i = 0; i < _banks.count(); i++)
-		if(_banks[i]->contains(address))
-			return _banks[i];
+
+	// build the index at first look-up
+	if(!_indexed.load(std::memory_order_acquire))
+		buildIndex();
+
+	// look up in the index
+	int l = 0, h = _index.count() - 1;
+	while(l <= h) {
+		int m = (l + h) / 2;
+		const segment_t& s = _index[m];
+		if(s.page < address.page() || (s.page == address.page() && s.base <= address.offset()))
+			l = m + 1;
+		else
+			h = m - 1;
+	}
+	if(h >= 0 && _index[h].page == address.page() && address.offset() < _index[h].top)
+		return _index[h].bank;
 	return 0;
 }
 
 
+// comparator of segment boundaries
+class BoundComparator {
+public:
+	typedef Pair<Address::page_t, t::uint64> bound_t;
+	static int compare(const bound_t& b1, const bound_t& b2) {
+		if(b1.fst != b2.fst)
+			return b1.fst < b2.fst ? -1 : 1;
+		else if(b1.snd != b2.snd)
+			return b1.snd < b2.snd ? -1 : 1;
+		else
+			return 0;
+	}
+	inline int doCompare(const bound_t& b1, const bound_t& b2) const { return compare(b1, b2); }
+};
+
+
+/**
+ * Build the index used by get() (and therefore by readTime(), writeTime()
+ * and accessTime()) to find a bank in logarithmic time. The address space
+ * is split in disjoint segments sorted by address, each one tied to the bank
+ * containing it. When banks overlap, the first declared bank wins.
+ *
+ * The index is built lazily at the first look-up, under a lock so that
+ * concurrent look-ups on a shared configuration are safe. As the banks are
+ * only set by the unserialization, they cannot change once looked up.
+ */
+void Memory::buildIndex(void) const {
+	static const t::uint64 top = t::uint64(1) << 32;
+	std::lock_guard<std::mutex> lock(_mutex);
+	if(_indexed.load(std::memory_order_relaxed))
+		return;
+
+	// collect the ranges of the banks and their bounds
+	Vector<segment_t> ranges;
+	Vector<BoundComparator::bound_t> bounds;
+	for(int i = 0; i < _banks.count(); i++) {
+		const Bank *b = _banks[i];
+		t::uint64 base = b->address().offset(), size = t::uint32(b->size());
+		t::uint64 end = (size == 0 && base == 0) ? top : base + size;
+		if(end <= base || end > top)
+			continue;
+		segment_t r = { b->address().page(), base, end, b };
+		ranges.add(r);
+		bounds.add(pair(r.page, base));
+		bounds.add(pair(r.page, end));
+	}
+	quicksort(bounds, BoundComparator());
+
+	// tie each elementary segment to its first bank
+	Vector<segment_t> segs;
+	for(int i = 0; i + 1 < bounds.count(); i++) {
+		if(bounds[i].fst != bounds[i + 1].fst || bounds[i].snd == bounds[i + 1].snd)
+			continue;
+		segment_t s = { bounds[i].fst, bounds[i].snd, bounds[i + 1].snd, 0 };
+		for(const auto& r: ranges)
+			if(r.page == s.page && r.base <= s.base && s.top <= r.top) {
+				s.bank = r.bank;
+				break;
+			}
+		if(s.bank == 0)
+			continue;
+		if(segs) {
+			segment_t& ps = segs[segs.count() - 1];
+			if(ps.bank == s.bank && ps.page == s.page && ps.top == s.base) {
+				ps.top = s.top;
+				continue;
+			}
+		}
+		segs.add(s);
+	}
+
+	// build the index
+	_index = AllocArray<segment_t>(segs.count());
+	for(int i = 0; i < segs.count(); i++)
+		_index[i] = segs[i];
+	_indexed.store(true, std::memory_order_release);
+}
+
+
 /**
  * Load a memory configuration from the given element.
  * @param element	Element to load from.
@@ -441,6 +540,7 @@ Memory *Memory::load(const elm::sys::Path& path) {
  * Memory constructor.
  */
 Memory::Memory(bool full):
+	_indexed(false),
 	_waccess(0),
 	_wread(0),
 	_wwrite(0),
@@ -513,7 +613,7 @@ ot::time Memory::bestReadTime(void) const {
 	if(_bread == 0) {
 		_bread = worstReadTime();
 		for(int i = 0; i < _banks.count(); i++)
-			_wread = min(_bread, _banks[i]->latency());
+			_bread = min(_bread, _banks[i]->latency());
 	}
 	return _bread;
 }
@@ -525,7 +625,7 @@ ot::time Memory::bestReadTime(void) const {
  */
 ot::time Memory::bestWriteTime(void) const {
 	if(_bwrite == 0) {
-		_bwrite = bestWriteTime();
+		_bwrite = worstWriteTime();
 		for(int i = 0; i < _banks.count(); i++)
 			_bwrite = min(_bwrite, _banks[i]->writeLatency());
 	}
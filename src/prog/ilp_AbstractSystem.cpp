@@ -44,6 +44,10 @@ namespace otawa { namespace ilp {
  * Constraint generated by AbstractSystem. Provided publicly to allow
  * extension of AbstractSystem.
  *
+ * The terms of a constraint built by @ref AbstractSystem::addRow() are packed
+ * in the term buffer of the system. They are moved to the constraint expression
+ * only if the constraint is modified.
+ *
  * @ingroup ilp
  */
 
@@ -55,7 +59,7 @@ namespace otawa { namespace ilp {
  * @param cst		Numeric constant put to the right of the constraint.
  */
 AbstractConstraint::AbstractConstraint(string label,  comparator_t comp, double cst)
-: _label(label), _comp(comp), _cst(cst), _idx(0), _sys(0) {
+: _label(label), _comp(comp), _cst(cst), _idx(0), _sys(0), _beg(0), _len(0) {
 }
 
 
@@ -87,10 +91,14 @@ double AbstractConstraint::coefficient(Var *var) const {
 	if(!var)
 		return constant();
 	else {
+		double r = 0;
+		for(int i = 0; i < _len; i++)
+			if(_sys->rows[_beg + i].fst == var)
+				r += _sys->rows[_beg + i].snd;
 		for(Expression::Iter i(&_expr); i(); i++)
 			if((*i).fst == var)
-				return (*i).snd;
-			return 0;
+				r += (*i).snd;
+		return r;
 	}
 }
 
@@ -121,8 +129,10 @@ const string& AbstractConstraint::label(void) const {
 void AbstractConstraint::add(double coef, Var *var) {
 	if(!var)
 		_cst -= coef;
-	else
+	else {
+		unpack();
 		_expr.add(coef, var);
+	}
 }
 
 
@@ -131,15 +141,17 @@ void AbstractConstraint::add(double coef, Var *var) {
 void AbstractConstraint::sub(double coef, Var *var) {
 	if(!var)
 		_cst += coef;
-	else
+	else {
+		unpack();
 		_expr.sub(coef, var);
+	}
 }
 
 
 /**
  */
 dyndata::AbstractIter<Term> *AbstractConstraint::terms(void) {
-	return new datastruct::IteratorMaker<Term, Expression::Iter>(Expression::Iter(&_expr));
+	return new datastruct::IteratorMaker<Term, TermIter>(TermIter(this));
 }
 
 
@@ -147,10 +159,50 @@ dyndata::AbstractIter<Term> *AbstractConstraint::terms(void) {
  */
 void AbstractConstraint::reset(void) {
 	_expr.reset();
+	_len = 0;
 	_cst = 0;
 }
 
 
+/**
+ * Move the terms packed in the term buffer of the system to the constraint
+ * expression in order to modify them.
+ */
+void AbstractConstraint::unpack(void) {
+	for(int i = 0; i < _len; i++)
+		_expr.add(_sys->rows[_beg + i]);
+	_len = 0;
+}
+
+
+/**
+ * Get the terms packed in the term buffer of the system.
+ * @return	Packed terms (null if there is none).
+ */
+const Term *AbstractConstraint::packed(void) const {
+	return _len == 0 ? nullptr : &_sys->rows[_beg];
+}
+
+
+/**
+ * @class AbstractConstraint::TermIter
+ * Iterator on the terms of an abstract constraint, packed or not.
+ *
+ * Since ILP interface 1.5.0, this iterator is no more an Expression::Iter:
+ * code deriving from it or passing it as an Expression::Iter must be adapted.
+ */
+
+/**
+ * Build the iterator.
+ * @param cons	Constraint to iterate on.
+ */
+AbstractConstraint::TermIter::TermIter(AbstractConstraint *cons)
+:	_p(cons->packed()),
+	_e(_p == nullptr ? nullptr : _p + cons->_len),
+	_i(&cons->_expr)
+{ }
+
+
 /**
  * @class AbstractSystem
  * This class provides a convenient way to handle ILP systems in OTAWA.
@@ -159,6 +211,10 @@ void AbstractConstraint::reset(void) {
  * is left to a child class for customization: the child class can now visit the system
  * and built the equivalent one in a particular solver.
  *
+ * AbstractSystem supports the snapshots of the ILP interface 1.4.0 by recording
+ * the old values of the constants and coefficients changed after a call to
+ * snapshot(): they are restored in reverse order by restore().
+ *
  * @ingroup ilp
  */
 
@@ -360,6 +416,98 @@ void AbstractSystem::remove(AbstractVar *var) {
 }
 
 
+/**
+ * Compute the coefficient of a variable in an expression.
+ * @param e		Expression to look in.
+ * @param var	Looked variable.
+ * @return		Variable coefficient.
+ */
+static double coefficientOf(const Expression& e, Var *var) {
+	double r = 0;
+	for(Expression::Iter t(&e); t(); t++)
+		if((*t).fst == var)
+			r += (*t).snd;
+	return r;
+}
+
+
+///
+void AbstractSystem::setConstant(Constraint *c, double cst) {
+	auto ac = static_cast<AbstractConstraint *>(c);
+	if(marks)
+		log.add(Change(CONSTANT, ac, nullptr, ac->_cst));
+	ac->_cst = cst;
+}
+
+
+///
+void AbstractSystem::setCoefficient(Constraint *c, Var *var, double coef) {
+	ASSERTP(var != nullptr, "use setConstant() to change the constant");
+	auto ac = static_cast<AbstractConstraint *>(c);
+	ac->unpack();
+	double old = coefficientOf(ac->_expr, var);
+	if(marks)
+		log.add(Change(COEFFICIENT, ac, var, old));
+	ac->_expr.add(coef - old, var);
+}
+
+
+///
+void AbstractSystem::setObjectCoefficient(Var *var, double coef) {
+	double old = coefficientOf(obj, var);
+	if(marks)
+		log.add(Change(OBJECT, nullptr, var, old));
+	obj.add(coef - old, var);
+}
+
+
+///
+bool AbstractSystem::snapshot() {
+	marks.push(log.length());
+	return true;
+}
+
+
+///
+void AbstractSystem::restore() {
+	ASSERTP(marks, "restore() without snapshot()");
+	int m = marks.pop();
+	while(log.length() > m) {
+		Change c = log.pop();
+		switch(c.kind) {
+		case CONSTANT:
+			c.cons->_cst = c.old;
+			break;
+		case COEFFICIENT:
+			c.cons->_expr.add(c.old - coefficientOf(c.cons->_expr, c.var), c.var);
+			break;
+		case OBJECT:
+			obj.add(c.old - coefficientOf(obj, c.var), c.var);
+			break;
+		}
+	}
+}
+
+
+/**
+ * Bulk construction of a constraint: the terms are packed in a term buffer
+ * shared by all the constraints of the system (avoiding an allocation and the
+ * look up of an already existing variable for each term). If a term has no variable
+ * or if its variable is an alias, the constraint is built in the usual way.
+ */
+Constraint *AbstractSystem::addRow(const Term *terms, int n, Constraint::comparator_t comp, double cst, const string& label) {
+	for(int i = 0; i < n; i++)
+		if(terms[i].fst == nullptr || terms[i].fst->toAlias() != nullptr)
+			return System::addRow(terms, n, comp, cst, label);
+	auto cons = static_cast<AbstractConstraint *>(newConstraint(label, comp, cst));
+	cons->_beg = rows.length();
+	cons->_len = n;
+	for(int i = 0; i < n; i++)
+		rows.add(terms[i]);
+	return cons;
+}
+
+
 /**
  * @class AbstractVar
  * Variable of AbstractSystem.
@@ -89,6 +89,14 @@ namespace otawa { namespace ilp {
  * OTAWA does not provide its own ILP solver but proposes plugin connecting with well-known off-the-shelf
  * solvers like lp_solve or CPlex. The ILP plugins are usual plugins of OTAWA but must implements
  * the class ilp::ILPPlugin.
+ *
+ * The version of the ILP interface is given by OTAWA_ILP_VERSION. Versions 1.4.0
+ * (incremental modification) and 1.5.0 (System::addRow()) add virtual functions
+ * to ilp::System: this breaks the binary compatibility and ILP plugins built
+ * against an older interface must be rebuilt. In 1.5.0, AbstractConstraint::TermIter
+ * is no more an Expression::Iter (packed terms are not stored in the expression):
+ * plugins deriving from it or using it as an Expression::Iter must only use its
+ * ended()/item()/next() interface.
  */
 
 
@@ -164,6 +164,125 @@ string System::lastErrorMessage(void) {
  */
 
 
+/**
+ * Set the constant (right-hand side) of a constraint (interface 1.4.0).
+ * The default implementation adds the difference to the current constant.
+ * @param c		Constraint to change.
+ * @param cst	New constant value.
+ */
+void System::setConstant(Constraint *c, double cst) {
+	c->sub(cst - c->constant());
+}
+
+
+/**
+ * Set the coefficient of a variable in a constraint (interface 1.4.0).
+ * The default implementation adds the difference to the current coefficient.
+ * @param c		Constraint to change.
+ * @param var	Variable of the coefficient (must not be an alias).
+ * @param coef	New coefficient.
+ */
+void System::setCoefficient(Constraint *c, Var *var, double coef) {
+	ASSERTP(var != nullptr, "use setConstant() to change the constant");
+	c->add(coef - c->coefficient(var), var);
+}
+
+
+/**
+ * Set the coefficient of a variable in the object function (interface 1.4.0).
+ * The default implementation adds the difference to the current coefficient.
+ * @param var	Variable of the coefficient (must not be an alias).
+ * @param coef	New coefficient.
+ */
+void System::setObjectCoefficient(Var *var, double coef) {
+	double old = 0;
+	for(ObjTermIterator t(this); t(); t++)
+		if((*t).fst == var)
+			old += (*t).snd;
+	addObjectFunction(coef - old, var);
+}
+
+
+/**
+ * Record the current state of the system (interface 1.4.0). The changes
+ * performed after this call with @ref setConstant(), @ref setCoefficient()
+ * and @ref setObjectCoefficient() can be undone by a call to @ref restore().
+ * Snapshots may be nested. Constraints and variables must neither
+ * be created nor removed while a snapshot is active.
+ *
+ * The default implementation does not support snapshots and returns false:
+ * the caller has then to restore the old values itself.
+ *
+ * @return	True if the snapshot is supported, false else.
+ */
+bool System::snapshot(void) {
+	return false;
+}
+
+
+/**
+ * Undo the changes performed since the last call to @ref snapshot()
+ * and drop this snapshot (interface 1.4.0).
+ */
+void System::restore(void) {
+	ASSERTP(false, "System::restore() not supported by this ILP system");
+}
+
+
+/**
+ * Test if the solver supports incremental resolution, that is, if
+ * @ref resolve() re-uses the previous solution as a warm start
+ * (interface 1.4.0). The default implementation returns false.
+ *
+ * @warning	No ILP plugin overrides this function yet (including AbstractSystem):
+ * for all of them, resolve() performs a full resolution.
+ * @return	True if resolution is incremental, false else.
+ */
+bool System::isIncremental(void) {
+	return false;
+}
+
+
+/**
+ * Solve again the system after modification of constants and coefficients
+ * (interface 1.4.0). Solvers supporting it (see @ref isIncremental())
+ * re-uses the previous solution as a warm start. The default implementation
+ * just calls solve(): as no ILP plugin overrides it yet, modifying a system
+ * and calling resolve() only saves the rebuilding of the system, not the
+ * resolution itself.
+ * @param ws	Current workspace.
+ * @param mon	Monitor to use.
+ * @return		True if the resolution is successful, false else.
+ */
+bool System::resolve(WorkSpace *ws, otawa::Monitor& mon) {
+	return solve(ws, mon);
+}
+
+
+/**
+ * Build a constraint from an array of terms in one call (interface 1.5.0).
+ * This is the fast way to build big systems: solvers may store the terms
+ * directly without allocating a term at a time.
+ * A term without variable is added to the constant. The variables
+ * of the terms should be all different.
+ *
+ * The default implementation builds the constraint with @ref newConstraint()
+ * and adds the terms one by one.
+ * @param terms		Terms of the constraint.
+ * @param n			Number of terms.
+ * @param comp		Comparator.
+ * @param cst		Constant (right part of the constraint).
+ * @param label		Constraint label.
+ * @return			Built constraint.
+ */
+Constraint *System::addRow(const Term *terms, int n, Constraint::comparator_t comp, double cst, const string& label) {
+	Constraint *c = newConstraint(label, comp, cst);
+	for(int i = 0; i < n; i++)
+		c->add(terms[i]);
+	return c;
+}
+
+
 /**
  * Return the owner plugin. As a default, return null.
  * @return	Owner plugin.
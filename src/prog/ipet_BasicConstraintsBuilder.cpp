@@ -121,23 +121,26 @@ void BasicConstraintsBuilder::processBB (WorkSpace *fw, CFG *cfg, Block *bb)
 	ASSERT(bb);
 
 	// Prepare data
-	model m(SYSTEM(fw));
-	var bbv(VAR(bb));
+	ilp::System *sys = SYSTEM(fw);
 
 	// input constraint (call input on entry node are ignored)
 	//		x_i = \sum{(j, i) in E /\ not call (j, i)} x_j,i (a)
 	if(!bb->isEntry()) {
-		cons c = m(input_label) + bbv == 0.;
+		row.clear();
+		row.add(Term(VAR(bb), 1.));
 		for(Block::EdgeIter edge = bb->ins(); edge(); edge++)
-				c += x(VAR(*edge));
+			row.add(Term(VAR(*edge), -1.));
+		sys->addRow(&row[0], row.length(), Constraint::EQ, 0, input_label);
 	}
 
 	// output constraint (why separating call from other and specially many calls?)
 	//		x_i = \sum{(i, j) in E /\ not call (i, j)} x_i,j
 	if(!bb->isExit()) {
-		cons c = m(output_label) + bbv == 0.;
+		row.clear();
+		row.add(Term(VAR(bb), 1.));
 		for(Block::EdgeIter edge = bb->outs(); edge(); edge++)
-			c += x(VAR(*edge));
+			row.add(Term(VAR(*edge), -1.));
+		sys->addRow(&row[0], row.length(), Constraint::EQ, 0, output_label);
 	}
 }
 
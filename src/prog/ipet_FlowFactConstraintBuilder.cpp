@@ -51,6 +51,9 @@ namespace otawa { namespace ipet {
  *
  * @par Provided Features
  * @li @ref ipet::FLOW_FACTS_CONSTRAINTS_FEATURE
+ *
+ * @par Provided Properties
+ * @li @ref ipet::LOOP_MAX_CONSTRAINT
  */
 
 
@@ -147,6 +150,7 @@ void FlowFactConstraintBuilder::processBB(WorkSpace *ws, CFG *cfg, Block *bb) {
 				else
 					cons->addRight((max < 0) ? 0 : max, var);
 			}
+			addRemover(FLOW_FACTS_CONSTRAINTS_FEATURE, LOOP_MAX_CONSTRAINT(bb) = cons);
 
 		}
 
@@ -248,6 +252,24 @@ void FlowFactConstraintBuilder::configure(const PropList& props) {
  */
 p::feature FLOW_FACTS_CONSTRAINTS_FEATURE("otawa::ipet::FLOW_FACTS_CONSTRAINTS_FEATURE", p::make<FlowFactConstraintBuilder>());
 
+
+/**
+ * Hooked to a loop header, records the ILP constraint bounding the maximum
+ * number of iterations of the loop. The bound appears as the negated
+ * coefficient of the entry edge variables and may be changed with
+ * @ref ilp::System::setCoefficient() to re-solve the system for another
+ * bound (see @ref ilp::System::resolve()).
+ *
+ * @par Hooks
+ * @li @ref Block (loop header)
+ *
+ * @par Features
+ * @li @ref ipet::FLOW_FACTS_CONSTRAINTS_FEATURE
+ *
+ * @ingroup ipet
+ */
+Identifier<otawa::ilp::Constraint *> LOOP_MAX_CONSTRAINT("otawa::ipet::LOOP_MAX_CONSTRAINT", nullptr);
+
 }
 
 } // otawa::ipet
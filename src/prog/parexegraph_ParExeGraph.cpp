@@ -133,6 +133,97 @@ int ParExeGraph::analyze() {
 //    }
 //    analyzeContentions();
 
+    return computeCost();
+}
+
+
+/**
+ * Same as analyze() but also prepare the graph for incremental analysis
+ * with reanalyze(): the nodes are ranked in topological order and their
+ * initial delays are recorded.
+ * @return	Cost for the current graph.
+ */
+int ParExeGraph::analyzeIncremental() {
+	clearDelays();
+	initDelays();
+
+	// rank the nodes
+	_order.clear();
+	_rank.setLength(count());
+	for(int i = 0; i < _rank.length(); i++)
+		_rank[i] = -1;
+	for(PreorderIterator node(this); node(); node++) {
+		_rank[node->index()] = _order.length();
+		_order.add(*node);
+	}
+
+	// record the initial delays
+	int rn = _resources.length();
+	_init.setLength(_order.length() * rn);
+	for(int i = 0; i < _order.length(); i++)
+		for(int r = 0; r < rn; r++)
+			_init[i * rn + r] = _order[i]->delay(r);
+
+	propagate();
+	return computeCost();
+}
+
+
+/**
+ * Re-compute the cost of the graph after some latencies of nodes or edges
+ * have been changed. Only the nodes following, in topological order,
+ * the changed nodes are re-computed: this gives the same result as analyze()
+ * but is much faster when the changed nodes are at the end of the graph.
+ * analyzeIncremental() must have been called first.
+ *
+ * If an edge has been added that breaks the topological order,
+ * the analysis is fully performed again with analyzeIncremental().
+ *
+ * @param changed	Nodes whose latency or whose output edges have been changed.
+ * @return			Cost for the current graph.
+ */
+int ParExeGraph::reanalyze(const Vector<ParExeNode *>& changed) {
+
+	// look for the first changed node
+	int first = _order.length();
+	for(int i = 0; i < changed.length(); i++) {
+		int r = rank(changed[i]);
+		if(r < 0)
+			return analyzeIncremental();
+		for(Successor succ(changed[i]); succ(); succ++)
+			if(rank(*succ) <= r)
+				return analyzeIncremental();
+		first = min(first, r);
+	}
+
+	// re-compute delays of following nodes
+	int rn = _resources.length();
+	for(int i = first + 1; i < _order.length(); i++) {
+		ParExeNode *node = _order[i];
+		for(int r = 0; r < rn; r++)
+			node->setDelay(r, _init[i * rn + r]);
+		for(Predecessor pred(node); pred(); pred++) {
+			int latency = 0;
+			if(pred.edge()->type() == ParExeEdge::SOLID)
+				latency = pred->latency() + pred.edge()->latency();
+			for(int r = 0; r < rn; r++)
+				if(pred->delay(r) != -1) {
+					int delay = pred->delay(r) + latency;
+					if(delay > node->delay(r))
+						node->setDelay(r, delay);
+				}
+		}
+	}
+
+	return computeCost();
+}
+
+
+/**
+ * Compute the cost from the delays of the last node.
+ * @return	Cost for the current graph.
+ */
+int ParExeGraph::computeCost() {
     int wcc;
     if (_last_prologue_node)
 		wcc = cost();
@@ -20,7 +20,6 @@
  */
 
 #include "config.h"
-#include <elm/sys/Thread.h>
 #include <otawa/proc/ConcurrentCFGProcessor.h>
 #include <otawa/prog/WorkSpace.h>
 
@@ -29,8 +28,8 @@ namespace otawa {
 /**
  * @class ConcurrentCFGProcessor
  * Implements a concurrent version of @ref CFGProcessor.
- * The CFG are processed in each thread and the thread calls
- * the processCFG() method.
+ * The CFG are dispatched over the worker threads of the workspace
+ * (see WorkSpace::forAll()) that call the processCFG() method.
  *
  * OTAWA is only responsible for maintaining the property list
  * state consistent: a thread processing a CFG is only allowed
@@ -44,19 +43,9 @@ namespace otawa {
  * @ingroup proc
  */
 
-#ifdef OTAWA_CONC
-class CFGRunnable: public sys::Runnable {
-public:
-	CFGRunnable(ConcurrentCFGProcessor& p): proc(p) { }
-	virtual void run(void) { proc.nextCFG(); }
-private:
-	ConcurrentCFGProcessor& proc;
-};
-#endif
-
 /**
  */
-ConcurrentCFGProcessor::ConcurrentCFGProcessor(p::declare& r): CFGProcessor(r), mutex(0) {
+ConcurrentCFGProcessor::ConcurrentCFGProcessor(p::declare& r): CFGProcessor(r) {
 }
 
 /**
@@ -68,40 +57,12 @@ void ConcurrentCFGProcessor::processWorkSpace(WorkSpace *ws) {
 		if(logFor(LOG_CFG))
 			CFGProcessor::processWorkSpace(ws);
 		else {
-			mutex = sys::Mutex::make();
 			const CFGCollection *coll = INVOLVED_CFGS(ws);
-			it = CFGCollection::Iterator(coll);
-			CFGRunnable run(*this);
-			WorkSpace::runAll(run);
-			delete mutex;
+			WorkSpace::forAll(coll->count(), [this, ws, coll](int i) {
+				processCFG(ws, coll->get(i));
+			});
 		}
 #	endif
 }
 
-/**
- * Process the next available CFG.
- */
-void ConcurrentCFGProcessor::nextCFG(void) {
-	WorkSpace *ws = workspace();
-	while(true) {
-
-		// get the next CFG
-		mutex->lock();
-		CFG *cfg = 0;
-		if(it()) {
-			cfg = *it;
-			it++;
-		}
-		mutex->unlock();
-
-		// process it
-		if(!cfg)
-			return;
-		else {
-			//cerr << string(_ << "DEBUG: in " << (void *)sys::Thread::current() << " processing " << cfg << io::endl);
-			processCFG(ws, cfg);
-		}
-	}
-}
-
 }	// otawa
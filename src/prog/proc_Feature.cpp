@@ -57,6 +57,18 @@ AbstractFeature::~AbstractFeature(void) {
 }
 
 
+/**
+ * Build the default processor of the feature without running it. This allows
+ * to examine the requirements of the feature before it is processed
+ * (see @ref PARALLEL_REQUIRE).
+ * @return	Default processor (to be run and released by the caller)
+ * 			or null if the feature can only be obtained with process().
+ */
+Processor *AbstractFeature::make(void) const {
+	return nullptr;
+}
+
+
 /**
  * Null value for features.
  */
@@ -139,6 +151,16 @@ void feature::process(WorkSpace *ws, const PropList& props) const {
 }
 
 
+/**
+ */
+Processor *feature::make(void) const {
+	if(_maker == nullptr)
+		return nullptr;
+	else
+		return _maker->make();
+}
+
+
 /**
  * For internal use only. Work-around the non-definition of WorkSpace
  * at this point.
@@ -0,0 +1,183 @@
+/*
+ *	MemoryProbe class implementation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "config.h"
+#include <otawa/proc/MemoryProbe.h>
+
+#ifdef OTAWA_MEM_STATS
+#	include <malloc.h>
+#	include <new>
+#	include <stdlib.h>
+#endif
+
+namespace otawa {
+
+// account of the running probe of the current thread (null if none)
+static thread_local MemoryProbe::Account *mem_account = nullptr;
+
+#ifdef OTAWA_MEM_STATS
+static inline void *count_alloc(void *p) {
+	if(p == nullptr)
+		throw std::bad_alloc();
+	MemoryProbe::Account *a = mem_account;
+	if(a != nullptr) {
+		t::int64 s = malloc_usable_size(p);
+		a->alloc.fetch_add(s, std::memory_order_relaxed);
+		t::int64 u = a->used.fetch_add(s, std::memory_order_relaxed) + s;
+		t::int64 m = a->peak.load(std::memory_order_relaxed);
+		while(u > m && !a->peak.compare_exchange_weak(m, u, std::memory_order_relaxed))
+			;
+	}
+	return p;
+}
+
+static inline void count_free(void *p) {
+	if(p != nullptr) {
+		MemoryProbe::Account *a = mem_account;
+		if(a != nullptr)
+			a->used.fetch_sub(malloc_usable_size(p), std::memory_order_relaxed);
+		free(p);
+	}
+}
+#endif
+
+
+/**
+ * @class MemoryProbe
+ * Measure the heap allocations performed between calls to start() and
+ * stop(): the allocated bytes (whatever they are released or not) and the
+ * peak growth of the used heap.
+ *
+ * The counters are fed by the replacement of the global C++ allocation
+ * operators, only installed if OTAWA is configured with OTAWA_MEM_STATS
+ * (off by default, requires the GNU C library). Otherwise, probes always
+ * measure 0. Allocations are only accounted while a probe is running.
+ *
+ * A running probe accounts the allocations of its thread and of the workers
+ * of WorkSpace::forAll() and WorkSpace::runAll() called by this thread;
+ * the threads started by WorkSpace::run() are not measured. Probes may be
+ * nested: the figures of a nested probe are added to the enclosing one.
+ * Memory allocated before the probe start, or by another thread, and
+ * released during the measure decreases the used heap: therefore, the peak
+ * is the maximum growth of the heap, never less than 0.
+ *
+ * @ingroup proc
+ */
+
+
+/**
+ * @class MemoryProbe::Account
+ * Allocation counters shared by the threads working for a probe.
+ */
+
+
+/**
+ * Test if memory probing is supported.
+ * @return	True if probes measure allocations, false else.
+ */
+bool MemoryProbe::isAvailable(void) {
+#	ifdef OTAWA_MEM_STATS
+		return true;
+#	else
+		return false;
+#	endif
+}
+
+
+/**
+ * Get the account the current thread allocations are charged to.
+ * @return	Current account (null if no probe is running).
+ */
+MemoryProbe::Account *MemoryProbe::account(void) {
+	return mem_account;
+}
+
+
+/**
+ * Charge the allocations of the current thread to the given account.
+ * Used to account the work performed by worker threads to the probe
+ * of the thread that launched it.
+ * @param account	Account to use (may be null).
+ * @return			Previous account of the thread.
+ */
+MemoryProbe::Account *MemoryProbe::use(Account *account) {
+	Account *old = mem_account;
+	mem_account = account;
+	return old;
+}
+
+
+/**
+ * Start the measure.
+ */
+void MemoryProbe::start(void) {
+	_account.alloc = 0;
+	_account.used = 0;
+	_account.peak = 0;
+	_account.parent = mem_account;
+	mem_account = &_account;
+	_running = true;
+}
+
+
+/**
+ * Stop the measure.
+ */
+void MemoryProbe::stop(void) {
+	mem_account = _account.parent;
+	_alloc = _account.alloc;
+	_peak = _account.peak;
+	Account *p = _account.parent;
+	if(p != nullptr) {
+		p->alloc += _alloc;
+		t::int64 u = p->used + _peak;
+		t::int64 m = p->peak;
+		while(u > m && !p->peak.compare_exchange_weak(m, u))
+			;
+		p->used += _account.used;
+	}
+	_running = false;
+}
+
+
+/**
+ * @fn t::int64 MemoryProbe::allocated(void) const;
+ * Get the bytes allocated during the measure.
+ * @return	Allocated bytes.
+ */
+
+
+/**
+ * @fn t::int64 MemoryProbe::peak(void) const;
+ * Get the maximum growth of the used heap during the measure.
+ * @return	Peak growth in bytes.
+ */
+
+}	// otawa
+
+#ifdef OTAWA_MEM_STATS
+void *operator new(std::size_t size) { return otawa::count_alloc(malloc(size == 0 ? 1 : size)); }
+void *operator new[](std::size_t size) { return otawa::count_alloc(malloc(size == 0 ? 1 : size)); }
+void operator delete(void *p) noexcept { otawa::count_free(p); }
+void operator delete[](void *p) noexcept { otawa::count_free(p); }
+void operator delete(void *p, std::size_t) noexcept { otawa::count_free(p); }
+void operator delete[](void *p, std::size_t) noexcept { otawa::count_free(p); }
+#endif
@@ -26,7 +26,9 @@
 #include <otawa/proc/Registry.h>
 #include <otawa/prog/WorkSpace.h>
 #include <otawa/proc/FeatureDependency.h>
+#include <otawa/proc/MemoryProbe.h>
 #include <otawa/proc/Progress.h>
+#include <otawa/stats/ProcStats.h>
 #include <otawa/stats/StatInfo.h>
 #include <otawa/stats/StatCollector.h>
 using namespace elm;
@@ -271,7 +273,14 @@ p::declare Processor::reg = p::init("otawa::Processor", Version(1, 2, 0))
  *
  * @p Statistics
  * The statistics are recorded in the property list passed by @ref Processor::STATS.
- * @li @ref Processor::RUNTIME.
+ * @li @ref Processor::RUNTIME,
+ * @li @ref Processor::ALLOCATED,
+ * @li @ref Processor::PEAK_MEMORY,
+ * @li @ref Processor::ADDED_PROPS,
+ * @li @ref Processor::ITERATIONS.
+ *
+ * If @ref Processor::COLLECT_STATS is set, the same figures are also
+ * recorded in the @ref ProcStats of the workspace.
  *
  * @p Verbosity
  * OTAWA provides two way to activate verbosity in code processors.
@@ -467,10 +476,21 @@ void Processor::run(WorkSpace *ws) {
 			log << "RUNNING: " << name() << " (" << version() << ')' << io::endl;
 	}
 
-	// record time
+	// record time and memory
 	elm::sys::StopWatch swatch;
-	if(isTimed())
+	bool measured = recordsStats() || isCollectingStats();
+	if(isTimed() || measured)
 		swatch.start();
+	MemoryProbe probe;
+	int props = 0;
+	t::int64 iters = 0;
+	bool census = measured && !PropList::areWritesShared();
+	if(measured) {
+		if(census)
+			props = ProcStats::census(ws);
+		iters = ProcStats::iterations();
+		probe.start();
+	}
 
 	// Launch the work
 	setup(ws);
@@ -486,8 +506,31 @@ void Processor::run(WorkSpace *ws) {
 	// Post-processing actions
 	if(!isQuiet() && logFor(LOG_CFG))
 		log << "Ending " << name();
-	if(isTimed()) {
+	if(isTimed() || measured)
 		swatch.stop();
+	if(measured) {
+		probe.stop();
+		iters = ProcStats::iterations() - iters;
+		census = census && !PropList::areWritesShared();
+		props = census ? ProcStats::census(ws) - props : -1;
+		if(recordsStats()) {
+			ALLOCATED(*stats) = probe.allocated();
+			PEAK_MEMORY(*stats) = probe.peak();
+			ADDED_PROPS(*stats) = props;
+			ITERATIONS(*stats) = iters;
+		}
+		if(isCollectingStats()) {
+			ProcStats::record_t r;
+			r.name = name();
+			r.time = swatch.delay().micros();
+			r.allocated = probe.allocated();
+			r.peak = probe.peak();
+			r.props = props;
+			r.iterations = iters;
+			ProcStats::add(ws, r);
+		}
+	}
+	if(isTimed()) {
 		if(recordsStats())
 			RUNTIME(*stats) = swatch.delay().micros();
 		if(!isQuiet()) {
@@ -693,6 +736,37 @@ p::id<bool> Processor::TIMED("otawa::Processor::TIMED", false);
 p::id<elm::sys::time_t> Processor::RUNTIME("otawa::Processor::RUNTIME", 0);
 
 
+/**
+ * This property identifier is used to store in the statistics of a processor
+ * the bytes allocated during its run (see @ref MemoryProbe).
+ */
+p::id<t::int64> Processor::ALLOCATED("otawa::Processor::ALLOCATED", 0);
+
+
+/**
+ * This property identifier is used to store in the statistics of a processor
+ * the peak growth of the heap, in bytes, during its run (see @ref MemoryProbe).
+ */
+p::id<t::int64> Processor::PEAK_MEMORY("otawa::Processor::PEAK_MEMORY", 0);
+
+
+/**
+ * This property identifier is used to store in the statistics of a processor
+ * the number of properties it has added to the blocks, edges and instructions
+ * of the involved CFGs. It is -1 if the processor ran while property writes
+ * were shared by several threads (parallel requirements or forked workspaces) as the
+ * properties cannot be counted safely.
+ */
+p::id<int> Processor::ADDED_PROPS("otawa::Processor::ADDED_PROPS", 0);
+
+
+/**
+ * This property identifier is used to store in the statistics of a processor
+ * the number of fix-point iterations it has performed (see @ref ProcStats::iterate()).
+ */
+p::id<t::int64> Processor::ITERATIONS("otawa::Processor::ITERATIONS", 0);
+
+
 /**
  * This property activates the verbose mode of the processor: information about
  * the processor work will be displayed.
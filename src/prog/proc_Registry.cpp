@@ -76,7 +76,7 @@ Registry::Registry(void): Initializer<AbstractRegistration>(false) {
 /**
  * Build the registration.
  */
-AbstractRegistration::AbstractRegistration(void): _base(&Processor::reg), cnt(0) {
+AbstractRegistration::AbstractRegistration(void): _base(&Processor::reg), cnt(0), _concurrent(false) {
 }
 
 
@@ -84,7 +84,7 @@ AbstractRegistration::AbstractRegistration(void): _base(&Processor::reg), cnt(0)
  * Build of a custom registration.
  * @param base		Base registration.
  */
-AbstractRegistration::AbstractRegistration(AbstractRegistration *base): cnt(0) {
+AbstractRegistration::AbstractRegistration(AbstractRegistration *base): cnt(0), _concurrent(false) {
 	ASSERT(base);
 	_base = base;
 	_name = base->_name;
@@ -99,7 +99,7 @@ AbstractRegistration::AbstractRegistration(AbstractRegistration *base): cnt(0) {
  * @param base		Base processor.
  */
 AbstractRegistration::AbstractRegistration(string name, Version version, AbstractRegistration *base)
-: _name(name), _version(version), _base(base), cnt(0) {
+: _name(name), _version(version), _base(base), cnt(0), _concurrent(false) {
 	ASSERT(base);
 }
 
@@ -214,6 +214,14 @@ bool AbstractRegistration::invalidates(const AbstractFeature& feature) {
  */
 
 
+/**
+ * @fn bool AbstractRegistration::isConcurrent(void) const;
+ * Test if the processor may run concurrently with other processors
+ * (see p::init::concurrent() and @ref PARALLEL_REQUIRE).
+ * @return	True if the processor is concurrency-safe, false else.
+ */
+
+
 /**
  * @fn Processor *AbstractRegistration::make(void) const;
  * Build the registered processor.
@@ -286,6 +294,17 @@ namespace p {
  * Used internally for processor declaration.
  */
 
+/**
+ * @fn init& init::concurrent(void);
+ * Declare the processor as concurrency-safe: when the required features
+ * are scheduled in parallel (see @ref PARALLEL_REQUIRE), it may run at the
+ * same time as other concurrency-safe processors. This means that it only
+ * modifies the program representation through property lists and does
+ * not modify shared objects (like the ILP system) without synchronization.
+ * This is not inherited by the processors extending this one.
+ * @return	Current initializer.
+ */
+
 /**
  * @class declare
  * Class to declare simple a processor.
@@ -295,7 +314,8 @@ namespace p {
  * @li provided features,
  * @li invalidated features,
  * @li used features,
- * @li maker for the default processor.
+ * @li maker for the default processor,
+ * @li concurrency safety (optional).
  *
  * Below an example of processor registration using declaration:
  * @code
@@ -325,6 +345,7 @@ declare::declare(const otawa::p::init& maker)
 	setConfigs(maker.configs);
 	setRequirements(maker._reqs);
 	_maker = maker._maker;
+	_concurrent = maker._concurrent;
 	record();
 }
 
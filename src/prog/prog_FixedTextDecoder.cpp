@@ -35,7 +35,11 @@ namespace otawa {
 /**
  * @class FixedTextDecoder
  * Decode the text instruction for a simple RISC architecture, requiring
- * fixed size and fixed alignement instructions.
+ * fixed size and fixed alignement instructions. The executable segments
+ * are decoded in one pass (see @ref Segment::decodeAll()).
+ *
+ * @par Configuration
+ * @li @ref TextDecoder::CONCURRENT
  * 
  * @par Provide
  * @ref DECODED_TEXT
@@ -45,7 +49,15 @@ namespace otawa {
 /**
  * Constructor.
  */
-FixedTextDecoder::FixedTextDecoder(void): Processor(reg) {
+FixedTextDecoder::FixedTextDecoder(void): Processor(reg), size(0), concurrent(false) {
+}
+
+
+/**
+ */
+void FixedTextDecoder::configure(const PropList& props) {
+	Processor::configure(props);
+	concurrent = TextDecoder::CONCURRENT(props);
 }
 
 
@@ -63,10 +75,7 @@ void FixedTextDecoder::processWorkSpace(WorkSpace *fw) {
 				if(seg->size() % size != 0)
 					warn(elm::_ << "segment " << seg->name() << " from file "
 						<< file->name() << " does not seems to be well aligned");
-				for(address_t addr = seg->address();
-				addr < seg->topAddress();
-				addr += size)
-					seg->findInstAt(addr);
+				seg->decodeAll(size, concurrent);
 			} 
 	}
 }
@@ -20,8 +20,10 @@
  */
 
 #include <elm/assert.h>
+#include <elm/data/Array.h>
 #include <otawa/program.h>
 #include <otawa/prog/Process.h>
+#include <otawa/prog/WorkSpace.h>
 
 // Configuration of the instruction map
 #define MAP_BITS	6
@@ -39,6 +41,16 @@ namespace otawa {
  * @par Usually, we find a ".text" segment containing program code,
  * ".data" containing initialized data, ".bss" containing uninitialized data,
  * ".rodata" containing read-only data. Yet, more segments may be available.
+ *
+ * @par Instruction map
+ * The items of the segment are retrieved from their address using a map
+ * of 64-bytes buckets, each one pointing to the first item of the bucket
+ * in the item list. For executable segments, a flat map, with one entry
+ * per aligned address, may be added with @ref makeFlat() to retrieve
+ * the instructions in constant time. Finally, @ref decodeAll() allows
+ * to decode a fixed-size instruction segment in one pass, possibly in parallel,
+ * instead of one instruction at a time when they are looked up.
+ *
  * @ingroup prog
  */
 
@@ -60,7 +72,9 @@ Segment::Segment(
 	_name(name),
 	_address(address),
 	_size(size),
-	map(new ProgItem *[MAP_SIZE(size)])
+	map(new ProgItem *[MAP_SIZE(size)]),
+	flat(nullptr),
+	flat_shift(0)
 {
 	// Removed : segment with 0 size seems to be normal
 	// ASSERTP(size, "zero size segment");
@@ -79,6 +93,8 @@ Segment::~Segment(void) {
 		delete item;
 	}
 	delete [] map;
+	if(flat != nullptr)
+		delete [] flat;
 }
 
 
@@ -174,6 +190,8 @@ ProgItem *Segment::findItemAt(const Address& addr) {
 	|| addr < address()
 	|| addr >= topAddress())
 		return nullptr;
+	if(flat != nullptr && ((addr - address()) & ((1 << flat_shift) - 1)) == 0)
+		return flat[(addr - address()) >> flat_shift];
 	int index = MAP_INDEX(addr);
 	ProgItem *item = map[index];
 	if(item) {
@@ -210,7 +228,19 @@ void Segment::insert(ProgItem *item) {
 
 	// compute map entry index
 	int index = MAP_INDEX(item->address()), init = index;
-	
+
+	// record in the flat map
+	if(flat != nullptr && ((item->address() - address()) & ((1 << flat_shift) - 1)) == 0)
+		flat[(item->address() - address()) >> flat_shift] = item;
+
+	// fast path: item after the last one (usual case of sequential decoding)
+	if(!_items.isEmpty() && static_cast<ProgItem *>(_items.last())->address() < item->address()) {
+		_items.addLast(item);
+		if(!map[init])
+			map[init] = item;
+		return;
+	}
+
 	// find first used entry for insertion
 	while(index > 0 && !map[index])
 		index--;
@@ -255,4 +285,68 @@ void Segment::insert(ProgItem *item) {
 
 
 
+
+/**
+ * Add to the segment a flat instruction map with one entry for each
+ * address aligned on the given value. This makes the retrieval of an
+ * instruction by its address a simple table access at the cost of one pointer
+ * for each aligned address. Only executable segments may be flat: for other
+ * segments, this call has no effect.
+ * @param align		Instruction alignment in bytes (must be a power of 2).
+ */
+void Segment::makeFlat(int align) {
+	ASSERTP(align > 0 && (align & (align - 1)) == 0, "alignment must be a power of 2");
+	if(!isExecutable() || flat != nullptr)
+		return;
+	flat_shift = 0;
+	while((1 << flat_shift) < align)
+		flat_shift++;
+	ot::size n = (_size + align - 1) >> flat_shift;
+	flat = new ProgItem *[n];
+	for(ot::size i = 0; i < n; i++)
+		flat[i] = nullptr;
+	for(ItemIter item(this); item(); item++)
+		if(((item->address() - address()) & (align - 1)) == 0)
+			flat[(item->address() - address()) >> flat_shift] = *item;
+}
+
+
+/**
+ * Decode in one pass all instructions of a segment for a fixed-size ISA.
+ * The segment is made flat with an alignment of the instruction size
+ * and the instructions already decoded are kept.
+ *
+ * If concurrent is true, the decoding is shared between the threads of
+ * the work space (see @ref WorkSpace::forAll()): this is only safe
+ * if the @ref decode() function of the ISA is reentrant. The insertion of the
+ * decoded instructions is still performed sequentially.
+ *
+ * @param size			Instruction size (in bytes).
+ * @param concurrent	If true, decode the instructions in parallel.
+ */
+void Segment::decodeAll(int size, bool concurrent) {
+	ASSERTP(size > 0, "decodeAll() only supports fixed-size instructions");
+	if(!isExecutable())
+		return;
+	makeFlat(size);
+	int n = _size / size;
+
+	// sequential decoding
+	if(!concurrent) {
+		for(int i = 0; i < n; i++)
+			findInstAt(address() + t::uint32(i * size));
+		return;
+	}
+
+	// parallel decoding
+	AllocArray<Inst *> insts(n);
+	WorkSpace::forAll(n, [this, &insts, size](int i) {
+		Address a = address() + t::uint32(i * size);
+		insts[i] = findItemAt(a) != nullptr ? nullptr : decode(a);
+	}, 256);
+	for(int i = 0; i < n; i++)
+		if(insts[i] != nullptr)
+			insert(insts[i]);
+}
+
 }; // namespace otawa
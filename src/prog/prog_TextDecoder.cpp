@@ -57,6 +57,8 @@ Feature<TextDecoder> DECODED_TEXT("otawa::DECODED_TEXT");
  *
  * @par Configuration
  * @li @ref FOLLOW_PATHS
+ * @li @ref CONCURRENT
+ * @li @ref FLAT_MAP
  *
  * @par Required Features
  * @li @ref otawa::FLOW_FACTS_FEATURE
@@ -149,4 +151,24 @@ void TextDecoder::configure(const PropList& props) {
 Identifier<bool> TextDecoder::FOLLOW_PATHS("otawa::TextDecoer::FOLLOW_PATHS", false);
 
 
+/**
+ * This identifier is used to configure the @ref TextDecoder. For fixed-size
+ * instruction sets, it informs it to decode the text segments in parallel
+ * (see @ref Segment::decodeAll()). It must only be used if the decoder
+ * of the ISA plugin is reentrant.
+ */
+Identifier<bool> TextDecoder::CONCURRENT("otawa::TextDecoder::CONCURRENT", false);
+
+
+/**
+ * This identifier is used to configure the @ref TextDecoder. When the text
+ * is decoded by following execution paths, it gives the alignment of
+ * instructions used to build flat instruction maps for the executable
+ * segments (see @ref Segment::makeFlat()). A value of 0 (default) keeps
+ * the bucket-based instruction map. The fixed-size instruction decoder
+ * always makes executable segments flat.
+ */
+Identifier<int> TextDecoder::FLAT_MAP("otawa::TextDecoder::FLAT_MAP", 0);
+
+
 } // otawa
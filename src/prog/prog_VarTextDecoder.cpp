@@ -45,6 +45,9 @@ static Identifier<bool> MARKER("", false);
  * length instructions. It proceeds by following all the paths of the
  * programs starting from entry points like declared program start,
  * function labels and so on.
+ *
+ * @par Configuration
+ * @li @ref TextDecoder::FLAT_MAP
  */
 
 
@@ -58,15 +61,29 @@ VarTextDecoder VarTextDecoder::_;
  * Constructor.
  */
 VarTextDecoder::VarTextDecoder(void)
-: Processor("otawa::VarTextDecoder", Version(1, 0, 0)) {
+: Processor("otawa::VarTextDecoder", Version(1, 0, 0)), flat_align(0) {
 	provide(DECODED_TEXT);
 }
 
 
+/**
+ */
+void VarTextDecoder::configure(const PropList& props) {
+	Processor::configure(props);
+	flat_align = TextDecoder::FLAT_MAP(props);
+}
+
+
 /**
  */
 void VarTextDecoder::processWorkSpace(WorkSpace *ws) {
 
+	// Build the flat instruction maps
+	if(flat_align > 0)
+		for(Process::FileIter file(ws->process()); file(); file++)
+			for(File::SegIter seg(*file); seg(); seg++)
+				seg->makeFlat(flat_align);
+
 	// Look the _start
 	Inst *start = ws->start();
 	if(start) {
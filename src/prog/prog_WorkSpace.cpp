@@ -19,15 +19,23 @@
  *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <stdlib.h>
+#include <thread>
 #include <elm/data/List.h>
 #include <elm/deprecated.h>
 #include <elm/serial2/serial.h>
+#include <elm/sys/StopWatch.h>
 #include <elm/sys/System.h>
 #include <elm/xom.h>
 
 #include <config.h>
 #include <otawa/ilp/System.h>
 #include <otawa/manager.h>
+#include <otawa/proc/MemoryProbe.h>
 #include <otawa/proc/ProcessorPlugin.h>
 #include <otawa/proc/FeatureDependency.h>
 #include <otawa/proc/Processor.h>
@@ -277,6 +285,40 @@ WorkSpace::WorkSpace(const WorkSpace *ws): cancelled(false) {
 }
 
 
+/**
+ * Build a new workspace on the same process that shares, in read-only mode,
+ * the features currently provided by this workspace and the properties
+ * hooked to it. This allows to perform several analyses concurrently on
+ * the same program, for example for different tasks, without loading and
+ * decoding it again. The shared features are not destroyed when the new
+ * workspace is deleted and must not be invalidated by its processors;
+ * as the program items (instructions, symbols, etc) are shared too,
+ * the concurrent processors must support shared writes
+ * (see PropList::shareWrites()). Notice that the CFG builders and most
+ * analyses hook their results to the instructions and to the blocks: forks
+ * building or analyzing the same functions concurrently would overwrite
+ * each other's properties.
+ *
+ * @return	Forked workspace (to be deleted by the caller).
+ */
+WorkSpace *WorkSpace::fork(void) const {
+	WorkSpace *ws = new WorkSpace(this);
+	ws->_name = _name;
+	ws->addProps(*this);
+	HashMap<Dependency *, Dependency *> map;
+	for(dep_map_t::Iter i(dep_map); i(); i++)
+		if(!ws->dep_map.hasKey(i.key())) {
+			Dependency *d = map.get(*i, nullptr);
+			if(d == nullptr) {
+				d = new Dependency(i->_proc, false, true);
+				map.put(*i, d);
+			}
+			ws->dep_map.put(i.key(), d);
+		}
+	return ws;
+}
+
+
 /**
  * Delete the workspace and the associated process.
  */
@@ -483,6 +525,301 @@ Processor *WorkSpace::run(cstring name, const PropList& props) {
  */
 
 
+// state of the parallel scheduling
+static std::atomic<int> waving(0);
+static std::recursive_mutex wave_mutex;
+
+// serialize dependency management while a wave of processors is running
+class WaveGuard {
+public:
+	WaveGuard(void): locked(waving != 0) { if(locked) wave_mutex.lock(); }
+	~WaveGuard(void) { if(locked) wave_mutex.unlock(); }
+private:
+	bool locked;
+};
+
+
+#ifdef OTAWA_CONC
+// thread count set by THREAD_COUNT for the current run (0 for the pool count)
+static thread_local int run_thread_count = 0;
+
+class ThreadCountScope {
+public:
+	ThreadCountScope(int n): old(run_thread_count) { if(n > 0) run_thread_count = n; }
+	~ThreadCountScope(void) { run_thread_count = old; }
+private:
+	int old;
+};
+#endif
+
+
+/*
+ * The scheduler builds the graph of the features required by a processor
+ * from the feature usages of the registrations of their default processors.
+ * The processors whose requirements are all provided are then run by
+ * waves: in a wave, the processors declared as concurrency-safe run
+ * concurrently and the other ones in sequence, as they may share objects
+ * (like the ILP system) that are not protected. The other operations (configuration,
+ * invalidation, recording of provided features) are performed sequentially
+ * in the order of the graph building. The features whose processor cannot be
+ * known in advance and the processors invalidating features are required
+ * sequentially after the already built part of the graph has been run.
+ */
+class WorkSpace::Scheduler {
+public:
+
+	class Node {
+	public:
+		Node(Processor *p, const AbstractFeature& f, Processor& u)
+			: proc(p), feature(f), user(u), complete(false), done(false), time(0), path(0), prev(nullptr) { }
+		Processor *proc;
+		const AbstractFeature& feature;
+		Processor& user;
+		Vector<Node *> deps;
+		bool complete, done;
+		t::int64 time, path;
+		Node *prev;
+		string name;
+		std::exception_ptr error;
+	};
+
+	Scheduler(WorkSpace& ws, Processor& root, const PropList& props)
+		: _ws(ws), _root(root), _props(props) { }
+
+	~Scheduler(void) {
+		for(auto n: nodes) {
+			if(n->proc != nullptr)
+				delete n->proc;
+			delete n;
+		}
+	}
+
+	/*
+	 * Plan the requirement of a feature by the given user.
+	 */
+	void require(Processor& user, const AbstractFeature& f) {
+		try {
+			visit(user, f);
+		}
+		catch(NoProcessorException& e) {
+			user.log << "ERROR: no processor to implement " << f.name() << io::endl;
+			throw UnavailableFeatureException(&user, f);
+		}
+	}
+
+	/*
+	 * Run the processors of the graph whose requirements are planned.
+	 */
+	void flush(void) {
+		while(!_ws.isCancelled()) {
+			Vector<Node *> wave;
+			for(auto n: nodes)
+				if(!n->done && n->complete && ready(n))
+					wave.add(n);
+			if(!wave)
+				break;
+			run(wave);
+		}
+	}
+
+	/*
+	 * Report the realized schedule and its critical path.
+	 */
+	void report(void) {
+		if(_root.isQuiet() || !_root.logFor(Processor::LOG_DEPS) || !waves)
+			return;
+		for(int i = 0; i < waves.count(); i++) {
+			_root.log << "SCHEDULED: wave " << i << ":";
+			for(auto n: waves[i])
+				_root.log << ' ' << n->name << " (" << (n->time / 1000.) << "ms)";
+			_root.log << io::endl;
+		}
+		Node *c = nullptr;
+		for(auto n: nodes)
+			if(n->done && (c == nullptr || n->path > c->path))
+				c = n;
+		if(c != nullptr) {
+			_root.log << "CRITICAL PATH: " << (c->path / 1000.) << "ms:";
+			for(; c != nullptr; c = c->prev)
+				_root.log << ' ' << c->name;
+			_root.log << io::endl;
+		}
+	}
+
+private:
+
+	Node *visit(Processor& user, const AbstractFeature& f) {
+
+		// already planned or provided?
+		Node *n = map.get(&f, nullptr);
+		if(n != nullptr) {
+			if(!n->complete)
+				throw otawa::Exception(_ << "feature " << f.name()
+					<< " is required by its own processor: circular dependency.");
+			if(!n->done || _ws.isProvided(f))
+				return n;
+		}
+		if(_ws.isProvided(f))
+			return nullptr;
+
+		// processor known and invalidating nothing?
+		Processor *p = f.make();
+		if(p == nullptr || dynamic_cast<NoProcessor *>(p) != nullptr || invalidates(p)) {
+			flush();
+			if(p == nullptr || dynamic_cast<NoProcessor *>(p) != nullptr) {
+				delete p;
+				_ws.require(f, _props);
+			}
+			else
+				_ws.run(p, _props, true);
+			return nullptr;
+		}
+
+		// build the node
+		n = new Node(p, f, user);
+		nodes.add(n);
+		for(FeatureIter fu(p->registration()); fu(); fu++)
+			if(fu->kind() == FeatureUsage::provide)
+				map.put(&fu->feature(), n);
+		for(FeatureIter fu(p->registration()); !_ws.isCancelled() && fu(); fu++)
+			if(fu->kind() == FeatureUsage::require
+			|| fu->kind() == FeatureUsage::use) {
+				_ws.logRequire(p, *fu);
+				Node *d;
+				try {
+					d = visit(*p, fu->feature());
+				}
+				catch(NoProcessorException& e) {
+					p->log << "ERROR: no processor to implement " << fu->feature().name() << io::endl;
+					throw UnavailableFeatureException(p, fu->feature());
+				}
+				if(d != nullptr && !n->deps.contains(d))
+					n->deps.add(d);
+			}
+		n->complete = true;
+		return n;
+	}
+
+	static bool invalidates(Processor *p) {
+		for(FeatureIter fu(p->registration()); fu(); fu++)
+			if(fu->kind() == FeatureUsage::invalidate)
+				return true;
+		return false;
+	}
+
+	static bool ready(Node *n) {
+		for(auto d: n->deps)
+			if(!d->done)
+				return false;
+		return true;
+	}
+
+	void run(const Vector<Node *>& wave) {
+
+		// prepare the processors
+		Vector<Node *> todo;
+		for(auto n: wave) {
+			n->done = true;
+			n->name = n->proc->name();
+			if(_ws.isProvided(n->feature)) {
+				delete n->proc;
+				n->proc = nullptr;
+				continue;
+			}
+			_ws.prepare(n->proc, _props);
+			_ws.check(n->proc);
+			todo.add(n);
+		}
+		if(!todo)
+			return;
+
+		// run the concurrency-safe ones in parallel, the others in sequence
+		Vector<Node *> conc, seq;
+		for(auto n: todo)
+			if(n->proc->registration().isConcurrent())
+				conc.add(n);
+			else
+				seq.add(n);
+		waving++;
+		if(conc.count() > 1) {
+			PropList::shareWrites(true);
+			WorkSpace::forAll(conc.count(), [&](int i) { perform(conc[i]); });
+			PropList::shareWrites(false);
+		}
+		else
+			seq.addAll(conc);
+		bool failed = false;
+		for(auto n: conc)
+			failed = failed || n->error;
+		for(int i = 0; i < seq.count() && !failed; i++) {
+			perform(seq[i]);
+			failed = bool(seq[i]->error);
+		}
+		waving--;
+		waves.add(todo);
+
+		// record them in order
+		for(auto n: todo) {
+			if(n->error) {
+				discard(todo);
+				try {
+					std::rethrow_exception(n->error);
+				}
+				catch(NoProcessorException& e) {
+					n->user.log << "ERROR: no processor to implement " << n->feature.name() << io::endl;
+					throw UnavailableFeatureException(&n->user, n->feature);
+				}
+			}
+			for(auto d: n->deps)
+				if(n->prev == nullptr || d->path > n->prev->path)
+					n->prev = d;
+			n->path = n->time + (n->prev == nullptr ? 0 : n->prev->path);
+			Processor *p = n->proc;
+			n->proc = nullptr;
+			if(!_ws.commit(p, true))
+				delete p;
+		}
+	}
+
+	/*
+	 * Run the processor of a node and record its time and its error if any.
+	 */
+	void perform(Node *n) {
+		sys::StopWatch sw;
+		sw.start();
+		try {
+			n->proc->run(&_ws);
+		}
+		catch(...) {
+			n->error = std::current_exception();
+		}
+		sw.stop();
+		n->time = sw.delay().micros();
+	}
+
+	/*
+	 * Release the processors of a failed wave that have not been recorded:
+	 * they have run (possibly partially) and their cleaners must be
+	 * activated before deletion.
+	 */
+	void discard(const Vector<Node *>& todo) {
+		for(auto n: todo)
+			if(n->proc != nullptr) {
+				n->proc->destroy(&_ws);
+				delete n->proc;
+				n->proc = nullptr;
+			}
+	}
+
+	WorkSpace& _ws;
+	Processor& _root;
+	const PropList& _props;
+	HashMap<const AbstractFeature *, Node *> map;
+	Vector<Node *> nodes;
+	Vector<Vector<Node *> > waves;
+};
+
+
 /**
  * Run the given in the current workspace.
  *
@@ -496,18 +833,58 @@ Processor *WorkSpace::run(cstring name, const PropList& props) {
 void WorkSpace::run(Processor *proc, const PropList& props, bool del_proc) {
 	if(proc->isDone())
 		return;
+#	ifdef OTAWA_CONC
+		ThreadCountScope threads(THREAD_COUNT(props));
+#	endif
 
 	// run the processor
-	proc->configure(props);
+	prepare(proc, props);
 	AbstractRegistration& reg = proc->registration();
 
-	// build the list of required features
-	Vector<const AbstractFeature *> required;
-	for(FeatureIter fuse(reg); fuse(); fuse++)
-		if(fuse->kind() == FeatureUsage::require && !required.contains(&fuse->feature()))
-			required.add(&fuse->feature());
+	// Get used feature
+	if(PARALLEL_REQUIRE(props) && threadCount() > 1 && waving == 0) {
+		Scheduler sched(*this, *proc, props);
+		for(FeatureIter feature(reg); !isCancelled() && feature(); feature++)
+			if(feature->kind() == FeatureUsage::require
+			|| feature->kind() == FeatureUsage::use) {
+				logRequire(proc, *feature);
+				sched.require(*proc, feature->feature());
+			}
+		sched.flush();
+		sched.report();
+	}
+	else
+		for(FeatureIter feature(reg); !isCancelled() && feature(); feature++)
+			if(feature->kind() == FeatureUsage::require
+			|| feature->kind() == FeatureUsage::use) {
+				logRequire(proc, *feature);
+				try {
+					require(feature->feature(), props);
+				}
+				catch(NoProcessorException& e) {
+					proc->log << "ERROR: no processor to implement " << feature->feature().name() << io::endl;
+					throw UnavailableFeatureException(proc, feature->feature());
+				}
+			}
+	if(isCancelled())
+		return;
 
-	// remove non-used invalidated features
+	// run the analysis
+	check(proc);
+	proc->run(this);
+	commit(proc, del_proc);
+}
+
+
+/**
+ * Configure the processor and invalidate the features it invalidates
+ * but does not use.
+ * @param proc	Processor to prepare.
+ * @param props	Configuration properties.
+ */
+void WorkSpace::prepare(Processor *proc, const PropList& props) {
+	proc->configure(props);
+	AbstractRegistration& reg = proc->registration();
 	for(FeatureIter feature(reg); feature(); feature++)
 		if(feature->kind() == FeatureUsage::invalidate
 		&& !reg.uses(feature->feature())) {
@@ -515,41 +892,51 @@ void WorkSpace::run(Processor *proc, const PropList& props, bool del_proc) {
 				proc->log << "INVALIDATED: " << feature->feature().name()
 					<< " by " << reg.name() << io::endl;
 			invalidate(feature->feature());
-			required.remove(&feature->feature());
 		}
+}
 
-	// Get used feature
-	for(FeatureIter feature(reg); !isCancelled() && feature(); feature++)
-		if(feature->kind() == FeatureUsage::require
-		|| feature->kind() == FeatureUsage::use) {
-			if(!proc->isQuiet() && proc->logFor(Processor::LOG_DEPS)) {
-				cstring kind = "USED";
-				if(feature->kind() == FeatureUsage::require)
-					kind = "REQUIRED";
-				proc->log << kind << ": " << feature->feature().name() << " by " << reg.name() << io::endl;
-			}
-			try {
-				require(feature->feature(), props);
-			}
-			catch(NoProcessorException& e) {
-				proc->log << "ERROR: no processor to implement " << feature->feature().name() << io::endl;
-				throw UnavailableFeatureException(proc, feature->feature());
-			}
-		}
-	if(isCancelled())
-		return;
 
-	// check before starting processor
-	for(FeatureIter feature(reg); feature(); feature++)
+/**
+ * Log the requirement of a feature by a processor.
+ * @param proc	Requiring processor.
+ * @param use	Feature usage.
+ */
+void WorkSpace::logRequire(Processor *proc, const FeatureUsage *use) {
+	if(!proc->isQuiet() && proc->logFor(Processor::LOG_DEPS)) {
+		cstring kind = "USED";
+		if(use->kind() == FeatureUsage::require)
+			kind = "REQUIRED";
+		proc->log << kind << ": " << use->feature().name() << " by " << proc->registration().name() << io::endl;
+	}
+}
+
+
+/**
+ * Check that the features required by a processor are provided.
+ * @param proc	Processor to check.
+ * @throw otawa::Exception	If a feature is missing.
+ */
+void WorkSpace::check(Processor *proc) {
+	for(FeatureIter feature(proc->registration()); feature(); feature++)
 		if((feature->kind() == FeatureUsage::require
 		|| feature->kind() == FeatureUsage::use)
 		&& !isProvided(feature->feature()))
 			throw otawa::Exception(_ << "feature " << feature->feature().name()
 				<< " is not provided after one cycle of requirements:\n"
 				<< "stopping -- this may denotes circular dependencies.");
+}
 
-	// run the analysis
-	proc->run(this);
+
+/**
+ * Record the work of a processor that has been run: invalidate the features
+ * it invalidates and uses and record the features it provides.
+ * @param proc		Run processor.
+ * @param del_proc	True if the processor has to be deleted when no more used.
+ * @return			True if the processor provides features (and is now owned
+ * 					by the workspace), false else.
+ */
+bool WorkSpace::commit(Processor *proc, bool del_proc) {
+	AbstractRegistration& reg = proc->registration();
 	proc->flags |= Processor::IS_DONE;
 
 	// cleanup used invalidated features
@@ -559,7 +946,6 @@ void WorkSpace::run(Processor *proc, const PropList& props, bool del_proc) {
 			if(!proc->isQuiet() && proc->logFor(Processor::LOG_DEPS))
 				proc->log << "INVALIDATED: " << feature->feature().name() << " by " << reg.name() << io::endl;
 			invalidate(feature->feature());
-			required.remove(&feature->feature());
 		}
 
 	// create the dependency
@@ -573,6 +959,7 @@ void WorkSpace::run(Processor *proc, const PropList& props, bool del_proc) {
 		}
 	if(provides)
 		add(proc, del_proc);
+	return provides != 0;
 }
 
 
@@ -624,7 +1011,8 @@ void WorkSpace::remove(Dependency *dep) {
 		i->_users.remove(dep);
 
 	// free the memory
-	dep->_proc->flags &= ~Processor::IS_TIED;
+	if(!dep->_shared)
+		dep->_proc->flags &= ~Processor::IS_TIED;
 	if(dep->_del_proc)
 		delete dep->_proc;
 	delete dep;
@@ -636,6 +1024,7 @@ void WorkSpace::remove(Dependency *dep) {
  * @param feature	Provided feature.
  */
 void WorkSpace::invalidate(const AbstractFeature& feature) {
+	WaveGuard guard;
 	Dependency *d = dep_map.get(&feature, 0);
 	ASSERTP(d, "dependency " << feature.name() << " is not provided!");
 	invalidate(d);
@@ -648,6 +1037,7 @@ void WorkSpace::invalidate(const AbstractFeature& feature) {
  * @return			Found implementor or null pointer.
  */
 Processor *WorkSpace::getImpl(const AbstractFeature& feature) const {
+	WaveGuard guard;
 	Dependency *d = dep_map.get(&feature, nullptr);
 	if(d == nullptr)
 		return nullptr;
@@ -675,7 +1065,8 @@ void WorkSpace::invalidate(Dependency *dep) {
 		// free dependency: delete it!
 		else {
 			stack.pop();
-			d->_proc->destroy(this);
+			if(!d->_shared)
+				d->_proc->destroy(this);
 			remove(d);
 		}
 
@@ -689,6 +1080,7 @@ void WorkSpace::invalidate(Dependency *dep) {
  * @return			True if it is provided, false else.
  */
 bool WorkSpace::provides(const AbstractFeature& feature) {
+	WaveGuard guard;
 	return dep_map.hasKey(&feature);
 }
 
@@ -730,6 +1122,7 @@ bool WorkSpace::provides(cstring name) {
  * @param props		Configuration properties (optional).
  */
 void WorkSpace::require(const AbstractFeature& feature, const PropList& props) {
+	WaveGuard guard;
 	if(!isProvided(feature))
 		feature.process(this, props);
 }
@@ -789,146 +1182,397 @@ void WorkSpace::unserialize(elm::serial2::Unserializer& unserializer) {
 
 #ifdef OTAWA_CONC
 #	define CONC_DEBUG(x)	//cerr << x
-	class RCURunnable: public sys::Runnable {
-		friend class WorkSpace;
+
+/*
+ * Pool of worker threads used to run the concurrent work of the processors.
+ * The workers are created on demand and, between two uses, are parked on
+ * a condition variable. Each call to forAll() or runAll() builds a job
+ * shared by its team (the calling thread and the acquired workers) and
+ * waits for the whole team before returning: the first exception raised by
+ * a member of the team cancels the job and is rethrown to the caller.
+ *
+ * In forAll(), each member of the team owns a lane, a deque of index ranges:
+ * it splits its ranges and takes the work from the back of its lane while
+ * idle members steal ranges from the front of the other lanes. A member
+ * finding nothing to steal waits on the job until new ranges are published
+ * or the job ends.
+ *
+ * The workers of asynchronous runs (run()) are joined and released by the
+ * next asynchronous run once their runnable has finished.
+ *
+ * The properties removed (WorkSpace::remove()) while a job is running are
+ * only deleted when no more job is running. The allocations of the workers
+ * are charged to the memory probe of the caller (see MemoryProbe).
+ */
+class TaskPool {
+public:
+	typedef Pair<int, int> range_t;
+
+	// work of a call shared by its team
+	class Job {
 	public:
+		class Lane {
+		public:
+			std::mutex mutex;
+			Vector<range_t> ranges;		// protected by mutex
+		};
+
+		Job(const std::function<void(int)> *f, sys::Runnable *r, int g)
+			: fun(f), runnable(r), grain(g), remaining(0), lanes(nullptr), size(0), pending(0), failed(false),
+			  published(0), waiting(0), account(MemoryProbe::account()) { }
+		~Job(void) { delete [] lanes; }
+
+		void init(int n) {
+			size = n;
+			lanes = new Lane[n];
+		}
 
-		RCURunnable(void): to_run(0) {
-			sys::Thread::make(*this);
+		const std::function<void(int)> *fun;
+		sys::Runnable *runnable;
+		int grain;
+		std::atomic<int> remaining;
+		Lane *lanes;
+		int size;
+		int pending;				// protected by pool mutex
+		std::atomic<bool> failed;
+		std::exception_ptr error;	// protected by pool mutex
+		std::atomic<int> published, waiting;
+		std::mutex mutex;
+		std::condition_variable wake;	// new ranges or end of the job
+		MemoryProbe::Account *account;
+	};
+
+	// parked worker
+	class Worker {
+	public:
+		Worker(TaskPool& pool): job(nullptr), lane(0), thread([this, &pool] { pool.loop(*this); }) { }
+		Job *job;					// protected by pool mutex
+		int lane;
+		std::condition_variable wake;
+		std::thread thread;
+	};
+
+	// worker of an asynchronous run
+	class AsyncWorker: public sys::Runnable {
+	public:
+		AsyncWorker(sys::Runnable *runnable): _runnable(runnable), _finished(false) { sys::Thread::make(*this); }
+		void run(void) override {
+			busy = true;
+			_runnable->run();
+			busy = false;
+			pool().finish(this);
 		}
+	private:
+		friend class TaskPool;
+		sys::Runnable *_runnable;
+		bool _finished;				// protected by pool mutex
+	};
 
-		inline bool isRoot(void) const { return this == &root; }
+	static TaskPool& pool(void) {
+		static TaskPool pool;
+		return pool;
+	}
 
-		virtual void run(void) {
-			ASSERT(to_run);
-			CONC_DEBUG("DEBUG: running " << (void *)this << " on " << (void *)to_run << io::endl);
+	TaskPool(void): _count(1), _active(0), _async_count(0), _stop(false) {
+		setCount(0);
+	}
 
-			// launch the runnable
-			to_run->run();
+	~TaskPool(void) {
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_stop = true;
+			for(auto w: _workers)
+				w->wake.notify_one();
+		}
+		for(auto w: _workers) {
+			w->thread.join();
+			delete w;
+		}
+		reap();
+	}
+
+	inline int count(void) const { return run_thread_count > 0 ? run_thread_count : _count; }
 
-			// end launching
-			mutex->lock();
-			running.remove(this);
-			avail.add(this);
-			check();
-			mutex->unlock();
+	void setCount(int n) {
+		if(n <= 0) {
+			const char *env = getenv("OTAWA_THREADS");
+			if(env != nullptr)
+				n = atoi(env);
+			if(n <= 0)
+				n = sys::System::coreCount();
 		}
+		_count = max(n, 1);
+	}
 
-		void clean(void) {
-			for(List<Property *>::iter i(to_free); i; i++)
-				delete *i;
-			to_free.clear();
+	sys::Thread *run(sys::Runnable *runnable) {
+		reap();
+		std::unique_lock<std::mutex> lock(_mutex);
+		if(busy || _async_count >= count() - 1) {
+			lock.unlock();
+			runnable->run();
+			return nullptr;
 		}
+		AsyncWorker *w = new AsyncWorker(runnable);
+		_async.add(w);
+		_async_count++;
+		_active++;
+		lock.unlock();
+		w->thread()->start();
+		return w->thread();
+	}
 
-		static void init(void) {
-			static bool initialized = false;
-			if(!initialized) {
-				initialized = true;
-				mutex = sys::Mutex::make();
-				core_count = sys::System::coreCount();
-			}
+	void runAll(sys::Runnable *runnable) {
+		if(busy) {
+			runnable->run();
+			return;
 		}
+		Job job(nullptr, runnable, 1);
+		Vector<Worker *> team;
+		acquire(team, count() - 1);
+		job.init(team.count() + 1);
+		CONC_DEBUG("DEBUG: runAll() on " << job.size << " threads\n");
+		launch(job, team);
+	}
 
-		static void check(void) {
-			if(!running) {
-				for(List<RCURunnable *>::iter i(avail); i; i++)
-					i->clean();
-				root.clean();
-			}
+	void forAll(int n, const std::function<void(int)>& f, int grain) {
+		if(grain < 1)
+			grain = 1;
+
+		// sequential cases
+		int c = min(count(), (n + grain - 1) / grain);
+		if(busy || c <= 1) {
+			for(int i = 0; i < n; i++)
+				f(i);
+			return;
 		}
 
-		static void runInRoot(sys::Runnable *runnable) {
-			runnable->run();
-			mutex->lock();
-			check();
-			mutex->unlock();
+		// distribute the ranges
+		Job job(&f, nullptr, grain);
+		Vector<Worker *> team;
+		acquire(team, c - 1);
+		job.init(team.count() + 1);
+		job.remaining = n;
+		for(int i = 0; i < job.size; i++) {
+			int l = i * n / job.size, h = (i + 1) * n / job.size;
+			if(l < h)
+				job.lanes[i].ranges.add(pair(l, h));
 		}
 
-		static sys::Thread *run(sys::Runnable *runnable) {
-
-			// lock
-			init();
-			mutex->lock();
-
-			// look for a free thread
-			if(avail) {
-				RCURunnable *t = avail.pop();
-				running.add(t);
-				CONC_DEBUG("DEBUG: " << (void *)t << " has to run " << (void *)runnable << io::endl);
-				t->to_run = runnable;
-				t->thread()->start();
-				mutex->unlock();
-				return t->thread();
-			}
+		// run them
+		launch(job, team);
+	}
+
+	void remove(Property *prop) {
+		std::unique_lock<std::mutex> lock(_mutex);
+		if(_active == 0) {
+			lock.unlock();
+			delete prop;
+		}
+		else
+			_to_free.add(prop);
+	}
 
-			// add a new one if any core is remaining
-			else if(running.count() < core_count - 1) {
-				RCURunnable *t = new RCURunnable();
-				CONC_DEBUG(cerr << "DEBUG: created " << (void *)t << io::endl);
-				running.add(t);
-				CONC_DEBUG(cerr << "DEBUG: " << (void *)t << " has to run " << (void *)runnable << io::endl);
-				t->to_run = runnable;
-				t->thread()->start();
-				mutex->unlock();
-				return t->thread();
+private:
+
+	// get up to n parked workers, creating them if needed
+	void acquire(Vector<Worker *>& team, int n) {
+		std::lock_guard<std::mutex> lock(_mutex);
+		while(team.count() < n && _idle)
+			team.add(_idle.pop());
+		while(team.count() < n) {
+			Worker *w = new Worker(*this);
+			_workers.add(w);
+			team.add(w);
+		}
+		_active++;
+	}
+
+	// run the job on the team and the calling thread, wait for the team
+	// and rethrow the first raised exception
+	void launch(Job& job, Vector<Worker *>& team) {
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			job.pending = team.count();
+			for(int i = 0; i < team.count(); i++) {
+				team[i]->job = &job;
+				team[i]->lane = i + 1;
+				team[i]->wake.notify_one();
 			}
+		}
+		busy = true;
+		participate(job, 0);
+		busy = false;
+		std::unique_lock<std::mutex> lock(_mutex);
+		_done.wait(lock, [&job] { return job.pending == 0; });
+		_active--;
+		if(_active == 0)
+			clean();
+		lock.unlock();
+		if(job.error)
+			std::rethrow_exception(job.error);
+	}
 
-			// only main core remains: run in main core
-			else {
-				mutex->unlock();
-				runInRoot(runnable);
-				return 0;
+	// loop of a parked worker
+	void loop(Worker& w) {
+		std::unique_lock<std::mutex> lock(_mutex);
+		while(true) {
+			w.wake.wait(lock, [this, &w] { return w.job != nullptr || _stop; });
+			if(w.job == nullptr)
+				return;
+			Job *job = w.job;
+			lock.unlock();
+			busy = true;
+			MemoryProbe::Account *account = MemoryProbe::use(job->account);
+			participate(*job, w.lane);
+			MemoryProbe::use(account);
+			busy = false;
+			lock.lock();
+			w.job = nullptr;
+			_idle.push(&w);
+			if(--job->pending == 0)
+				_done.notify_all();
+		}
+	}
+
+	// end of an asynchronous run
+	void finish(AsyncWorker *w) {
+		std::lock_guard<std::mutex> lock(_mutex);
+		w->_finished = true;
+		_async_count--;
+		_active--;
+		if(_active == 0)
+			clean();
+	}
+
+	// join and delete the finished asynchronous workers
+	void reap(void) {
+		Vector<AsyncWorker *> finished;
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			for(List<AsyncWorker *>::Iter w(_async); w(); w++)
+				if(w->_finished)
+					finished.add(*w);
+			for(auto w: finished)
+				_async.remove(w);
+		}
+		for(auto w: finished) {
+			w->thread()->join();
+			delete w;
+		}
+	}
+
+	// delete the removed properties (called with the pool mutex locked)
+	void clean(void) {
+		for(auto p: _to_free)
+			delete p;
+		_to_free.clear();
+	}
+
+	// perform the work of a team member and record its exception
+	void participate(Job& job, int lane) {
+		try {
+			if(job.runnable != nullptr)
+				job.runnable->run();
+			else
+				work(job, lane);
+		}
+		catch(...) {
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				if(!job.error)
+					job.error = std::current_exception();
+				job.failed = true;
 			}
+			publish(job);
+		}
+	}
+
+	// signal the waiting members of a job that ranges are available
+	// or that the job has ended
+	void publish(Job& job) {
+		job.published++;
+		if(job.waiting > 0) {
+			{ std::lock_guard<std::mutex> lock(job.mutex); }
+			job.wake.notify_all();
 		}
+	}
 
-		static void runAll(Runnable *runnable) {
-			CONC_DEBUG("DEBUG: RCU::runAll()\n");
-
-			// count available threads
-			init();
-			mutex->lock();
-			int c = RCURunnable::core_count - running.count() - 1;
-			mutex->unlock();
-			CONC_DEBUG("DEBUG: " << c << " threads available (" << core_count << ").\n");
-
-			// run available threads
-			Vector<sys::Thread *> to_wait;
-			for(int i = 0; i < c; i++) {
-				to_wait.add(run(runnable));
-				CONC_DEBUG("DEBUG: launched thread " << (void *)to_wait.top() << io::endl);
+	// work until all ranges are processed or the job fails
+	void work(Job& job, int lane) {
+		range_t r;
+		while(job.remaining > 0 && !job.failed) {
+			int seen = job.published;
+			if(pop(job, lane, r) || steal(job, lane, r))
+				execute(job, lane, r);
+			else {
+				std::unique_lock<std::mutex> lock(job.mutex);
+				job.waiting++;
+				job.wake.wait(lock, [&job, seen]
+					{ return job.published != seen || job.remaining <= 0 || job.failed; });
+				job.waiting--;
 			}
-			runInRoot(runnable);		// root thread
-
-			// wait for end of used threads
-			for(int i = 0; i < to_wait.count(); i++)
-				if(to_wait[i]) {
-					CONC_DEBUG("DEBUG: waiting for thread " << (void *)to_wait[i] << io::endl);
-					to_wait[i]->join();
-					CONC_DEBUG("DEBUG: ended for thread " << (void *)to_wait[i] << io::endl);
-				}
 		}
+	}
 
-		static void remove(Property *prop) {
-			if(!running)
-				delete prop;
-			else
-				static_cast<RCURunnable&>(current()).to_free.add(prop);
+	// process a range, exposing its upper halves to thieves
+	void execute(Job& job, int lane, range_t r) {
+		Job::Lane& l = job.lanes[lane];
+		while(r.snd - r.fst > job.grain) {
+			int m = (r.fst + r.snd) / 2;
+			l.mutex.lock();
+			l.ranges.add(pair(m, r.snd));
+			l.mutex.unlock();
+			publish(job);
+			r.snd = m;
 		}
+		for(int i = r.fst; i < r.snd; i++)
+			(*job.fun)(i);
+		if((job.remaining -= r.snd - r.fst) <= 0)
+			publish(job);
+	}
 
-	private:
-		sys::Runnable *to_run;
-		List<Property *> to_free;
+	// take the last range of the lane
+	bool pop(Job& job, int lane, range_t& r) {
+		Job::Lane& l = job.lanes[lane];
+		bool found = false;
+		l.mutex.lock();
+		if(l.ranges) {
+			r = l.ranges.pop();
+			found = true;
+		}
+		l.mutex.unlock();
+		return found;
+	}
 
-		static RCURunnable root;
-		static sys::Mutex *mutex;
-		static List<RCURunnable *> avail, running;
-		static int core_count;
-	};
+	// take the first range of another lane of the job
+	bool steal(Job& job, int lane, range_t& r) {
+		for(int i = 1; i < job.size; i++) {
+			Job::Lane& l = job.lanes[(lane + i) % job.size];
+			bool found = false;
+			l.mutex.lock();
+			if(l.ranges) {
+				r = l.ranges[0];
+				l.ranges.removeAt(0);
+				found = true;
+			}
+			l.mutex.unlock();
+			if(found)
+				return true;
+		}
+		return false;
+	}
 
-	RCURunnable RCURunnable::root;
-	sys::Mutex *RCURunnable::mutex = 0;
-	List<RCURunnable *> RCURunnable::avail, RCURunnable::running;
-	int RCURunnable::core_count = 0;
+	std::mutex _mutex;
+	std::condition_variable _done;
+	Vector<Worker *> _workers, _idle;
+	List<AsyncWorker *> _async;
+	List<Property *> _to_free;
+	int _count, _active, _async_count;
+	bool _stop;
+	static thread_local bool busy;
+};
+
+thread_local bool TaskPool::busy = false;
 #endif
 
 
@@ -941,12 +1585,14 @@ void WorkSpace::unserialize(elm::serial2::Unserializer& unserializer) {
  * management of property in thread-safe way.
  *
  * @param runnable	Runnable to launch.
- * @return			Started thread or null if the runnable has been launched
- * in the current thread.
+ * @return			Started thread (owned by the workspace) or null if the
+ * runnable has been launched in the current thread. The thread is joined
+ * and released by the workspace once the runnable has finished: it must
+ * not be joined by the caller.
  */
 sys::Thread *WorkSpace::run(sys::Runnable& runnable) {
 #	ifdef OTAWA_CONC
-		return RCURunnable::run(&runnable);
+		return TaskPool::pool().run(&runnable);
 #	else
 		runnable.run();
 		return 0;
@@ -964,35 +1610,117 @@ sys::Thread *WorkSpace::run(sys::Runnable& runnable) {
  */
 void WorkSpace::runAll(sys::Runnable& runnable) {
 #	ifdef OTAWA_CONC
-		RCURunnable::runAll(&runnable);
+		TaskPool::pool().runAll(&runnable);
 #	else
 		runnable.run();
 #	endif
 }
 
+/**
+ * Call the given function for each index in [0, n[, possibly in parallel.
+ * The indexes are split in ranges distributed over the worker threads
+ * and the idle workers steal ranges from the busy ones: this makes
+ * efficient the processing of items of very different costs
+ * (blocks, cache sets, edges, etc). The function must only write
+ * in the data of the processed item.
+ *
+ * When called from a function already run by the workers, or without
+ * concurrency support, the indexes are processed sequentially in order.
+ * If the function raises an exception, the remaining indexes are
+ * cancelled and the exception is rethrown once all workers have stopped.
+ *
+ * @param n		Number of indexes.
+ * @param f		Function to call with each index.
+ * @param grain	Minimal number of consecutive indexes processed by a worker
+ * 				(default to 1).
+ */
+void WorkSpace::forAll(int n, const std::function<void(int)>& f, int grain) {
+#	ifdef OTAWA_CONC
+		TaskPool::pool().forAll(n, f, grain);
+#	else
+		for(int i = 0; i < n; i++)
+			f(i);
+#	endif
+}
+
+/**
+ * Get the number of threads used to run concurrent work (including the calling
+ * thread). It is 1 if OTAWA has been built without concurrency support.
+ * By default, it is the value of the environment variable OTAWA_THREADS or,
+ * if undefined, the number of cores. It may be changed with
+ * setThreadCount() or with the configuration property @ref THREAD_COUNT.
+ * @return	Number of threads.
+ */
+int WorkSpace::threadCount(void) {
+#	ifdef OTAWA_CONC
+		return TaskPool::pool().count();
+#	else
+		return 1;
+#	endif
+}
+
+/**
+ * Set the number of threads used to run concurrent work.
+ * Has no effect if OTAWA has been built without concurrency support.
+ * @param n		Number of threads (0 to get back the default).
+ */
+void WorkSpace::setThreadCount(int n) {
+#	ifdef OTAWA_CONC
+		TaskPool::pool().setCount(n);
+#	endif
+}
+
 /**
  * Remove a property in a thread-safe way.
  * @param prop	Property to remove.
  */
 void WorkSpace::remove(Property *prop) {
 #	ifdef OTAWA_CONC
-		RCURunnable::remove(prop);
+		TaskPool::pool().remove(prop);
 #	else
 		delete prop;
 #	endif
 }
 
 
+/**
+ * Number of threads used to perform concurrent work (0 for the default,
+ * see WorkSpace::threadCount()). Only meaningful if OTAWA has been built
+ * with concurrency support. It only applies to the concurrent work launched
+ * by the thread calling WorkSpace::run() during this run: the global
+ * count (see WorkSpace::setThreadCount()) is not changed.
+ *
+ * @ingroup prog
+ */
+p::id<int> THREAD_COUNT("otawa::THREAD_COUNT", 0);
+
+
+/**
+ * When set to true, the features required by a processor run by
+ * WorkSpace::run() are scheduled as a graph and independent processors
+ * declared as concurrency-safe (see p::init::concurrent()) are run
+ * concurrently (if more than one thread is available, see @ref THREAD_COUNT);
+ * the other independent processors of a same wave are run one after the
+ * other. The processors invalidating features and the features without
+ * default processor are still required sequentially.
+ * With the @ref Processor::LOG_DEPS log level, the realized waves and the
+ * critical path are displayed.
+ *
+ * @ingroup prog
+ */
+p::id<bool> PARALLEL_REQUIRE("otawa::PARALLEL_REQUIRE", false);
+
+
 /**
  */
-WorkSpace::Dependency::Dependency( Processor *proc, bool del_proc)
-: _proc(proc), _del_proc(del_proc) {
+WorkSpace::Dependency::Dependency( Processor *proc, bool del_proc, bool shared)
+: _proc(proc), _del_proc(del_proc), _shared(shared) {
 }
 
 
 /**
  */
-WorkSpace::Dependency::Dependency(void): _proc(&Processor::null), _del_proc(false) {
+WorkSpace::Dependency::Dependency(void): _proc(&Processor::null), _del_proc(false), _shared(false) {
 }
 
 
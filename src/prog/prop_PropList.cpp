@@ -20,6 +20,10 @@
  */
 
 #include "config.h"
+#ifdef OTAWA_CONC
+#	include <atomic>
+#	include <mutex>
+#endif
 #include <elm/io.h>
 #include <elm/util/VarArg.h>
 #include <otawa/prog/WorkSpace.h>
@@ -309,6 +313,12 @@ const AbstractIdentifier END("end");
  * This a list of properties. This may be inherited for binding properties to
  * other classes or used as-is for passing heterogeneous properties to a function
  * call.
+ *
+ * Properties are stored in a linked list. When OTAWA is configured with
+ * OTAWA_PROP_HASH (cmake -DOTAWA_PROP_HASH=ON), the lists longer than a few
+ * properties are also indexed with an open-addressed hash table making
+ * the property retrieval independent of the list length. This does not
+ * change the size of PropList and readers do not need any lock.
  * @ingroup prop
  */
 
@@ -341,12 +351,190 @@ const AbstractIdentifier END("end");
  */
 
 
+#ifdef OTAWA_PROP_HASH
+
+/*
+ * Index of a long property list: it maps each identifier to the first property
+ * of the list with this identifier using an open-addressed table. The list
+ * itself remains the reference storage (for iteration and multiple properties
+ * with the same identifier).
+ *
+ * Only writers, that are already serialized on a property list, modify the
+ * index. Readers perform a single load of the table and the table is never
+ * modified in a way that breaks a concurrent lookup: a slot is filled
+ * value-first, identifiers are never removed (a removed property leaves a null
+ * value) and, when the table is enlarged, the old one is released after the
+ * readers (as removed properties in concurrent mode). The head, the table
+ * and the slots are published by the writers with release stores and read
+ * with acquire loads.
+ */
+class PropList::Index {
+public:
+	static const int threshold = 8;
+
+	std::atomic<Property *> head;
+
+	Index(Property *list): head(list), table(nullptr) { rebuild(); }
+	~Index(void) { delete table.load(std::memory_order_relaxed); }
+
+	inline Property *get(const AbstractIdentifier *id) const {
+		const Table *t = table.load(std::memory_order_acquire);
+		for(int i = hash(id) & t->mask; ; i = (i + 1) & t->mask) {
+			const Slot& s = t->slots[i];
+			const AbstractIdentifier *sid = s.id.load(std::memory_order_acquire);
+			if(sid == id)
+				return s.prop.load(std::memory_order_acquire);
+			if(sid == nullptr)
+				return nullptr;
+		}
+	}
+
+	void set(const AbstractIdentifier *id, Property *prop) {
+		Table *t = table.load(std::memory_order_relaxed);
+		Slot *s = lookup(t, id);
+		if(s->id.load(std::memory_order_relaxed) == id)
+			s->prop.store(prop, std::memory_order_release);
+		else if(prop != nullptr) {
+			if((t->used + 1) * 4 > (t->mask + 1) * 3)
+				rebuild();
+			else {
+				s->prop.store(prop, std::memory_order_relaxed);
+				s->id.store(id, std::memory_order_release);
+				t->used++;
+			}
+		}
+	}
+
+private:
+
+	class Slot {
+	public:
+		Slot(void): id(nullptr), prop(nullptr) { }
+		std::atomic<const AbstractIdentifier *> id;
+		std::atomic<Property *> prop;
+	};
+
+	class Table {
+	public:
+		Table(int size): mask(size - 1), used(0), slots(new Slot[size]) { }
+		~Table(void) { delete [] slots; }
+		int mask, used;
+		Slot *slots;
+	};
+
+	class Retired: public Property {
+	public:
+		Retired(Table *table): Property(static_cast<const AbstractIdentifier *>(nullptr)), _table(table) { }
+		~Retired(void) { delete _table; }
+	private:
+		Table *_table;
+	};
+
+	static inline int hash(const AbstractIdentifier *id) {
+		std::uintptr_t k = std::uintptr_t(id) >> 4;
+		return int(k ^ (k >> 9) ^ (k >> 18));
+	}
+
+	static Slot *lookup(Table *t, const AbstractIdentifier *id) {
+		int i = hash(id) & t->mask;
+		for(const AbstractIdentifier *sid = t->slots[i].id.load(std::memory_order_relaxed);
+		sid != nullptr && sid != id;
+		sid = t->slots[i].id.load(std::memory_order_relaxed))
+			i = (i + 1) & t->mask;
+		return &t->slots[i];
+	}
+
+	void rebuild(void) {
+
+		// build the new table
+		int n = 0;
+		Property *first = head.load(std::memory_order_relaxed);
+		for(Property *cur = first; cur; cur = cur->next())
+			n++;
+		int size = 2 * threshold;
+		while(size < 2 * n)
+			size <<= 1;
+		Table *t = new Table(size);
+		for(Property *cur = first; cur; cur = cur->next()) {
+			Slot *s = lookup(t, cur->id());
+			if(s->id.load(std::memory_order_relaxed) == nullptr) {
+				s->prop.store(cur, std::memory_order_relaxed);
+				s->id.store(cur->id(), std::memory_order_relaxed);
+				t->used++;
+			}
+		}
+
+		// publish it and release the old one
+		Table *old = table.load(std::memory_order_relaxed);
+		table.store(t, std::memory_order_release);
+		if(old != nullptr) {
+#			ifdef OTAWA_CONC
+				WorkSpace::remove(new Retired(old));
+#			else
+				delete old;
+#			endif
+		}
+	}
+
+	std::atomic<Table *> table;
+};
+
+#endif	// OTAWA_PROP_HASH
+
+
+/**
+ * Get the first property of an indexed list (slow path of first()).
+ * @return	First property.
+ */
+Property *PropList::indexedFirst(void) const {
+#	ifdef OTAWA_PROP_HASH
+		return index()->head.load(std::memory_order_acquire);
+#	else
+		return head.load(std::memory_order_acquire);
+#	endif
+}
+
+
+/**
+ * Change the first property of the list.
+ * @param prop	New first property.
+ */
+void PropList::setFirst(Property *prop) {
+#	ifdef OTAWA_PROP_HASH
+		if(isIndexed()) {
+			index()->head.store(prop, std::memory_order_release);
+			return;
+		}
+#	endif
+	head.store(prop, std::memory_order_release);
+}
+
+
+/**
+ * Called after an insertion to build the index of the list if it becomes
+ * long enough (only if OTAWA is configured with OTAWA_PROP_HASH).
+ */
+void PropList::updateIndex(void) {
+#	ifdef OTAWA_PROP_HASH
+		if(isIndexed())
+			return;
+		int n = 0;
+		Property *first = head.load(std::memory_order_relaxed);
+		for(Property *cur = first; cur; cur = cur->next())
+			if(++n >= Index::threshold) {
+				head.store(reinterpret_cast<Property *>(std::uintptr_t(new Index(first)) | INDEXED), std::memory_order_release);
+				return;
+			}
+#	endif
+}
+
+
 /**
  * Add all properties from the given property list, in a reverse order.
  * @param props	Property list to clone.
  */
 void PropList::addProps(const PropList& props) {
-	for(Property *cur = props.head; cur; cur = cur->next()) {
+	for(Property *cur = props.first(); cur; cur = cur->next()) {
 		Property *copy = cur->copy();
 		addProp(copy);
 	}
@@ -359,12 +547,71 @@ void PropList::addProps(const PropList& props) {
  */
 void PropList::takeProps(PropList& props) {
 	clearProps();
-	this->head = props.head;
-	props.head = 0;
+	head.store(props.head.load(std::memory_order_acquire), std::memory_order_release);
+	props.head.store(nullptr, std::memory_order_release);
 }
 
 
 
+#ifdef OTAWA_CONC
+/*
+ * When writes are shared (see PropList::shareWrites()), the writers of a same
+ * property list are serialized by a lock selected from the list address.
+ * Readers never lock.
+ */
+static std::atomic<int> shared_writes(0);
+static std::recursive_mutex write_locks[64];
+
+class WriteGuard {
+public:
+	inline WriteGuard(const PropList *list): _lock(nullptr) {
+		if(shared_writes.load() != 0) {
+			_lock = &write_locks[(std::uintptr_t(list) >> 4) % 64];
+			_lock->lock();
+		}
+	}
+	inline ~WriteGuard(void) { if(_lock != nullptr) _lock->unlock(); }
+private:
+	std::recursive_mutex *_lock;
+};
+#	define WRITE_GUARD		WriteGuard _guard(this)
+#else
+#	define WRITE_GUARD
+#endif
+
+
+/**
+ * Enable or disable the sharing of property list writes between threads.
+ * When enabled, the modifications of a same property list performed by
+ * different threads are serialized. This is used by the workspace when
+ * several processors run concurrently (see @ref PARALLEL_REQUIRE) and has no
+ * effect if OTAWA is built without concurrency support. Calls may be nested.
+ * @param enable	True to enable, false to disable.
+ */
+void PropList::shareWrites(bool enable) {
+#	ifdef OTAWA_CONC
+		if(enable)
+			shared_writes++;
+		else
+			shared_writes--;
+#	endif
+}
+
+
+/**
+ * Test if the writes to property lists are currently shared between threads
+ * (see shareWrites()).
+ * @return	True if writes are shared, false else.
+ */
+bool PropList::areWritesShared(void) {
+#	ifdef OTAWA_CONC
+		return shared_writes.load() != 0;
+#	else
+		return false;
+#	endif
+}
+
+
 /**
  * Find a property by its identifier.
  * @param id	Identifier of the property to find.
@@ -372,19 +619,26 @@ void PropList::takeProps(PropList& props) {
  */
 Property *PropList::getProp(const AbstractIdentifier *id) const {
 
+	/* Look in the index */
+	Property *first = head.load(std::memory_order_acquire);
+#	ifdef OTAWA_PROP_HASH
+		if((std::uintptr_t(first) & INDEXED) != 0)
+			return reinterpret_cast<Index *>(std::uintptr_t(first) & ~INDEXED)->get(id);
+#	endif
+
 	/* Look in this list */
 #	ifndef OTAWA_CONC
-		for(Property *cur = head, *prev = 0; cur; prev = cur, cur = cur->next())
+		for(Property *cur = first, *prev = 0; cur; prev = cur, cur = cur->next())
 			if(cur->id() == id) {
 				if(prev) {
 					prev->_next = cur->next();
-					cur->_next = head;
-					head = cur;
+					cur->_next = first;
+					head.store(cur, std::memory_order_relaxed);
 				}
 				return cur;
 			}
 #	else
-		for(Property *cur = head; cur; cur = cur->next())
+		for(Property *cur = first; cur; cur = cur->next())
 			if(cur->id() == id)
 				return cur;
 #	endif
@@ -399,21 +653,44 @@ Property *PropList::getProp(const AbstractIdentifier *id) const {
  * @param prop	Property to set.
  */
 void PropList::setProp(Property *prop) {
+	Property *dead = nullptr;
+	{
+		WRITE_GUARD;
+		Property *first = this->first();
+
+		// Find the property
+		Property *old = first;
+#		ifdef OTAWA_PROP_HASH
+			if(isIndexed() && !index()->get(prop->id()))
+				old = 0;
+#		endif
+		for(Property *cur = old, *prev = 0; cur; prev = cur, cur = cur->next())
+			if(cur->id() == prop->id()) {
+				if(prev)
+					prev->_next = cur->next();
+				else
+					first = cur->next();
+				dead = cur;
+				break;
+			}
 
-	// Find the property
-	for(Property *cur = head, *prev = 0; cur; prev = cur, cur = cur->next())
-		if(cur->id() == prop->id()) {
-			if(prev)
-				prev->_next = cur->next();
+		// Link the new property
+		prop->_next = first;
+		setFirst(prop);
+#		ifdef OTAWA_PROP_HASH
+			if(isIndexed())
+				index()->set(prop->id(), prop);
 			else
-				head = cur->next();
-			delete cur;
-			break;
-		}
-
-	// Link the new property
-	prop->_next = head;
-	head = prop;
+				updateIndex();
+#		endif
+	}
+	if(dead) {
+#		ifdef OTAWA_CONC
+			WorkSpace::remove(dead);
+#		else
+			delete dead;
+#		endif
+	}
 }
 
 
@@ -429,19 +706,14 @@ void PropList::setProp(Property *prop) {
  * @param id	Identifier of the property to remove.
  */
 void PropList::removeProp(const AbstractIdentifier *id) {
-	for(Property *cur = head, *prev = 0; cur; prev = cur, cur = cur->next())
-		if(cur->id() == id) {
-			if(prev)
-				prev->_next = cur->next();
-			else
-				head = cur->next();
-#			ifdef OTAWA_CONC
-				WorkSpace::remove(cur);
-#			else
-				delete cur;
-#			endif
-			break;
-		}
+	Property *cur = extractProp(id);
+	if(cur) {
+#		ifdef OTAWA_CONC
+			WorkSpace::remove(cur);
+#		else
+			delete cur;
+#		endif
+	}
 }
 
 
@@ -451,14 +723,26 @@ void PropList::removeProp(const AbstractIdentifier *id) {
  * @param id	Identifier of the property to extract.
  */
 Property *PropList::extractProp(const AbstractIdentifier *id) {
-	for(Property *cur = head, *prev = 0; cur; prev = cur, cur = cur->next())
+	WRITE_GUARD;
+#	ifdef OTAWA_PROP_HASH
+		if(isIndexed() && !index()->get(id))
+			return 0;
+#	endif
+	for(Property *cur = first(), *prev = 0; cur; prev = cur, cur = cur->next())
 		if(cur->id() == id) {
 			if(prev)
 				prev->_next = cur->next();
 			else
-				head = cur->next();
+				setFirst(cur->next());
+#			ifdef OTAWA_PROP_HASH
+				if(isIndexed()) {
+					Property *next = cur->next();
+					while(next && next->id() != id)
+						next = next->next();
+					index()->set(id, next);
+				}
+#			endif
 			return cur;
-			break;
 		}
 	return 0;
 }
@@ -476,11 +760,16 @@ Property *PropList::extractProp(const AbstractIdentifier *id) {
  * Remove all properties from the list.
  */
 void PropList::clearProps(void) {
-	for(Property *cur = head, *next; cur; cur = next) {
+	WRITE_GUARD;
+	for(Property *cur = first(), *next; cur; cur = next) {
 		next = cur->next();
 		delete cur;
 	}
-	head = 0;
+#	ifdef OTAWA_PROP_HASH
+		if(isIndexed())
+			delete index();
+#	endif
+	head.store(nullptr, std::memory_order_release);
 }
 
 
@@ -561,8 +850,15 @@ void PropList::clearProps(void) {
  * @param prop	Property to add.
  */
 void PropList::addProp(Property *prop) {
-	prop->_next = head;
-	head = prop;
+	WRITE_GUARD;
+	prop->_next = first();
+	setFirst(prop);
+#	ifdef OTAWA_PROP_HASH
+		if(isIndexed())
+			index()->set(prop->id(), prop);
+		else
+			updateIndex();
+#	endif
 }
 
 
@@ -571,7 +867,15 @@ void PropList::addProp(Property *prop) {
  * @param id	Identifier of properties to remove.
  */
 void PropList::removeAllProp(const AbstractIdentifier *id) {
-	Property *prv = 0, *cur = head;
+	WRITE_GUARD;
+#	ifdef OTAWA_PROP_HASH
+		if(isIndexed()) {
+			if(!index()->get(id))
+				return;
+			index()->set(id, nullptr);
+		}
+#	endif
+	Property *prv = 0, *cur = first();
 	while(cur) {
 		if(cur->id() != id) {
 			prv = cur;
@@ -584,9 +888,9 @@ void PropList::removeAllProp(const AbstractIdentifier *id) {
 				cur = prv->next();
 			}
 			else {
-				head = cur->next();
+				setFirst(cur->next());
 				delete cur;
-				cur = head;
+				cur = first();
 			}
 		}
 	}
@@ -663,7 +967,7 @@ const PropList PropList::EMPTY;
  * @param out	Output to use.
  */
 void PropList::print(elm::io::Output& out) const {
-	if(!head)
+	if(!first())
 		out << "{ }";
 	else {
 		bool first = true;
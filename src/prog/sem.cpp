@@ -24,6 +24,7 @@
 #include <otawa/hard/Platform.h>
 #include <otawa/prog/Process.h>
 #include <otawa/sem/BBIter.h>
+#include <otawa/sem/Cache.h>
 #include <otawa/sem/inst.h>
 #include <otawa/sem/StateIter.h>
 
@@ -811,20 +812,114 @@ io::Output& operator<<(io::Output& out, cond_t cond) {
  * This iterator allows easily to traverse all execution paths of a block
  * of semantic instructions. As it may consume resources, it is delivered
  * to support iteration on multiple blocks sequentially.
+ *
+ * The translation buffer is only allocated when the semantic instructions
+ * are not provided as an array, and the pending paths are stored in a small
+ * fixed-size stack with an overflow vector only allocated for deeply nested
+ * conditionals.
  * @ingroup sem
  */
 
 
+///
+PathIter::PathIter(const PathIter& it): bb(nullptr), code(nullptr), pc(0), top(0), more(nullptr) {
+	*this = it;
+}
+
+
+///
+PathIter& PathIter::operator=(const PathIter& it) {
+	if(this == &it)
+		return *this;
+	if(it.bb != nullptr && it.code == &(*it.bb)[0]) {
+		sem::Block& b = buffer();
+		for(int i = 0; i < it.bb->length(); i++)
+			b.add((*it.bb)[i]);
+		code = &b[0];
+	}
+	else
+		code = it.code;
+	pc = it.pc;
+	top = it.top;
+	for(int i = 0; i < top && i < STACK_SIZE; i++)
+		stack[i] = it.stack[i];
+	if(top > STACK_SIZE) {
+		if(more == nullptr)
+			more = new Vector<int>();
+		*more = *it.more;
+	}
+	else if(more != nullptr)
+		more->clear();
+	return *this;
+}
+
+
+/**
+ * Push a pending path.
+ * @param i	Index of the first instruction of the path.
+ */
+void PathIter::push(int i) {
+	if(top < STACK_SIZE)
+		stack[top] = i;
+	else {
+		if(more == nullptr)
+			more = new Vector<int>();
+		more->push(i);
+	}
+	top++;
+}
+
+
+/**
+ * Pop a pending path.
+ * @return	Index of the first instruction of the path.
+ */
+int PathIter::pop(void) {
+	ASSERT(top > 0);
+	top--;
+	if(top < STACK_SIZE)
+		return stack[top];
+	else
+		return more->pop();
+}
+
+
+/**
+ * Get the buffer used to store translated semantic instructions
+ * (allocated at first use).
+ * @return	Cleared buffer.
+ */
+sem::Block& PathIter::buffer(void) {
+	if(bb == nullptr)
+		bb = new sem::Block();
+	else
+		bb->clear();
+	return *bb;
+}
+
+
+/**
+ * Reset the iteration on the given semantic instructions.
+ * @param code	Semantic instructions ended by a @ref sem::cont().
+ */
+void PathIter::reset(const sem::inst *code) {
+	this->code = code;
+	pc = 0;
+	top = 0;
+	if(more != nullptr)
+		more->clear();
+}
+
+
 /**
  * Start interpretation of an instruction.
  * @param inst	Instruction to interpret.
  */
 void PathIter::start(Inst *inst) {
-	bb.clear();
-	inst->semInsts(bb);
-	todo.clear();
-	pc = 0;
-	bb.add(sem::cont());
+	sem::Block& b = buffer();
+	inst->semInsts(b);
+	b.add(sem::cont());
+	reset(&b[0]);
 }
 
 
@@ -833,11 +928,10 @@ void PathIter::start(Inst *inst) {
  * of a process.
  */
 void PathIter::start(Process *proc) {
-	bb.clear();
-	proc->semInit(bb);
-	todo.clear();
-	pc = 0;
-	bb.add(sem::cont());
+	sem::Block& b = buffer();
+	proc->semInit(b);
+	b.add(sem::cont());
+	reset(&b[0]);
 }
 
 
@@ -846,10 +940,23 @@ void PathIter::start(Process *proc) {
  * @param block		Block to interpret.
  */
 void PathIter::start(const sem::Block& block) {
-	bb = block;
-	todo.clear();
-	pc = 0;
-	bb.add(sem::cont());
+	sem::Block& b = buffer();
+	for(int i = 0; i < block.length(); i++)
+		b.add(block[i]);
+	b.add(sem::cont());
+	reset(&b[0]);
+}
+
+
+/**
+ * Start interpretation of an array of semantic instructions
+ * that must be ended by a @ref sem::cont() instruction (as provided by
+ * @ref Program::code()). The array is not copied and must remain
+ * alive during the iteration.
+ * @param code	Semantic instructions to interpret.
+ */
+void PathIter::start(const sem::inst *code) {
+	reset(code);
 }
 
 
@@ -858,10 +965,10 @@ void PathIter::start(const sem::Block& block) {
  */
 void PathIter::next(void) {
 	if(pathEnd())
-		pc = todo.pop();
+		pc = pop();
 	else {
 		if(isFork())
-			todo.push(pc + bb[pc].jump() + 1); // because the target of the jump is how many semantic instructions to skip, so we need to add 1 to get the one we are interested
+			push(pc + at(pc).jump() + 1); // because the target of the jump is how many semantic instructions to skip, so we need to add 1 to get the one we are interested
 		pc++;
 	}
 }
@@ -899,18 +1006,79 @@ void PathIter::next(void) {
  * @li instEnd() for the end of a particular instruction (all semantic paths),
  * @li pathEnd() for the end of a particular semantic execution path.
  *
+ * When a @ref Cache is passed to start(), the semantic instructions are
+ * taken from the cached @ref Program of the block instead of being
+ * re-translated from the machine instructions.
+ *
  */
 
+///
+BBIter::BBIter(void): _cache(nullptr), _prog(nullptr), _k(0) {
+}
+
+///
+BBIter::BBIter(const BBIter& it): _cache(nullptr), _prog(nullptr), _k(0) {
+	*this = it;
+}
+
+///
+BBIter::~BBIter(void) {
+	release();
+}
+
+///
+BBIter& BBIter::operator=(const BBIter& it) {
+	if(this == &it)
+		return *this;
+	release();
+	b = it.b;
+	si = it.si;
+	i = it.i;
+	_cache = it._cache;
+	_k = it._k;
+	if(it._prog != nullptr)
+		_prog = _cache->use(it._prog->block());
+	return *this;
+}
+
+/**
+ * Release the cached program, if any.
+ */
+void BBIter::release(void) {
+	if(_prog != nullptr) {
+		_cache->release(_prog);
+		_prog = nullptr;
+	}
+}
+
 /**
  * Start the traversal of a different basic block.
  * @param bb	Basic block to start with.
  */
 void BBIter::start(BasicBlock *bb) {
+	release();
+	_cache = nullptr;
 	i = BasicBlock::InstIter(bb);
 	if(*i)
 		si.start(*i);
 }
 
+/**
+ * Start the traversal of a different basic block using the semantic
+ * instructions stored in the given cache.
+ * @param bb		Basic block to start with.
+ * @param cache		Semantic instruction cache.
+ */
+void BBIter::start(BasicBlock *bb, Cache *cache) {
+	release();
+	_cache = cache;
+	_prog = cache->use(bb);
+	_k = 0;
+	i = BasicBlock::InstIter(bb);
+	if(i())
+		si.start(_prog->code(0));
+}
+
 /**
  * @fn bool BBIter::pathEnd(void) const;
  * Test if the iteration point is at the end of an semantic execution path.
@@ -955,10 +1123,12 @@ void BBIter::start(BasicBlock *bb) {
 void BBIter::next(void) {
 	if(si.ended()) {
 		i++;
-		if(i())
-			si.start(*i);
-		else
+		if(!i())
 			return;
+		if(_prog != nullptr)
+			si.start(_prog->code(++_k));
+		else
+			si.start(*i);
 	}
 	else
 		si.next();
@@ -0,0 +1,357 @@
+/*
+ *	sem::Cache class implementation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ *	02110-1301  USA
+ */
+
+#include <otawa/cfg/features.h>
+#include <otawa/proc/Processor.h>
+#include <otawa/prog/WorkSpace.h>
+#include <otawa/sem/Cache.h>
+
+namespace otawa { namespace sem {
+
+/**
+ * @class Program
+ * Semantic instructions of a basic block, translated once and stored
+ * in a contiguous array. The semantic instructions of each machine
+ * instruction are followed by a @ref sem::cont() instruction in order to
+ * be directly iterated by a @ref PathIter.
+ *
+ * Programs are obtained and released from a @ref Cache.
+ *
+ * @ingroup sem
+ */
+
+/**
+ * @fn BasicBlock *Program::block(void) const;
+ * Get the translated basic block.
+ * @return	Basic block.
+ */
+
+/**
+ * @fn int Program::count(void) const;
+ * Get the number of machine instructions of the block.
+ * @return	Machine instruction count.
+ */
+
+/**
+ * @fn const inst *Program::code(int i) const;
+ * Get the semantic instructions of the i-th machine instruction.
+ * They are terminated by a @ref sem::cont() instruction.
+ * @param i		Machine instruction index.
+ * @return		Semantic instructions.
+ */
+
+/**
+ * @fn int Program::length(int i) const;
+ * Get the number of semantic instructions of the i-th machine instruction
+ * (not including the terminating @ref sem::cont()).
+ * @param i		Machine instruction index.
+ * @return		Semantic instruction count.
+ */
+
+/**
+ * @fn int Program::size(void) const;
+ * Get the total number of semantic instructions stored in the program.
+ * @return	Semantic instruction count.
+ */
+
+///
+Program::Program(BasicBlock *bb, const Block& code, const int *offs, int n)
+:	_bb(bb),
+	_code(new inst[code.length()]),
+	_offs(new int[n + 1]),
+	_n(n),
+	_pins(0),
+	_prev(nullptr),
+	_next(nullptr)
+{
+	for(int i = 0; i < code.length(); i++)
+		_code[i] = code[i];
+	for(int i = 0; i <= n; i++)
+		_offs[i] = offs[i];
+}
+
+///
+Program::~Program(void) {
+	delete [] _code;
+	delete [] _offs;
+}
+
+
+/**
+ * @class Cache
+ * Cache of the semantic instructions of basic blocks. Instead of calling
+ * @ref Inst::semInsts() each time a block is interpreted, the analyses
+ * obtains from the cache the @ref Program of a block, translated at first use,
+ * and iterates directly on its contiguous array of semantic instructions.
+ *
+ * The cache size is bounded by a number of semantic instructions:
+ * when the capacity is exceeded, the least recently used programs, that
+ * are not in use, are freed.
+ *
+ * @ref use(), @ref release() and @ref clear() are serialized by a mutex
+ * so that the cache may be shared by analyses running in parallel. The
+ * semantic instructions of a program in use are never modified and can be
+ * read without lock.
+ *
+ * @ingroup sem
+ */
+
+/**
+ * Build a cache.
+ * @param capacity	Maximum number of semantic instructions (0 for no limit).
+ */
+Cache::Cache(int capacity)
+:	_first(nullptr),
+	_last(nullptr),
+	_cap(capacity),
+	_size(0),
+	_hits(0),
+	_misses(0)
+{ }
+
+///
+Cache::~Cache(void) {
+	clear();
+}
+
+/**
+ * Get the program of the given basic block. The program is kept in memory
+ * until it is released by a call to @ref release().
+ * @param bb	Looked basic block.
+ * @return		Matching program.
+ */
+Program *Cache::use(BasicBlock *bb) {
+	std::lock_guard<std::mutex> guard(_mutex);
+	Program *prog = _map.get(bb, nullptr);
+	if(prog != nullptr) {
+		_hits++;
+		unlink(prog);
+	}
+	else {
+		_misses++;
+		prog = translate(bb);
+		_map.put(bb, prog);
+		_size += prog->size();
+	}
+
+	// put first in LRU list
+	prog->_next = _first;
+	if(_first != nullptr)
+		_first->_prev = prog;
+	_first = prog;
+	if(_last == nullptr)
+		_last = prog;
+	prog->_pins++;
+
+	if(_cap != 0 && _size > _cap)
+		evict();
+	return prog;
+}
+
+/**
+ * Release a program obtained by @ref use().
+ * @param prog	Released program.
+ */
+void Cache::release(Program *prog) {
+	std::lock_guard<std::mutex> guard(_mutex);
+	ASSERT(prog->_pins > 0);
+	prog->_pins--;
+	if(_cap != 0 && _size > _cap)
+		evict();
+}
+
+/**
+ * Free all programs of the cache. No program must be in use.
+ */
+void Cache::clear(void) {
+	std::lock_guard<std::mutex> guard(_mutex);
+	for(Program *prog = _first, *next; prog != nullptr; prog = next) {
+		ASSERTP(prog->_pins == 0, "clearing a semantic cache in use");
+		next = prog->_next;
+		delete prog;
+	}
+	_first = _last = nullptr;
+	_map.clear();
+	_size = 0;
+}
+
+/**
+ * @fn int Cache::capacity(void) const;
+ * Get the capacity of the cache.
+ * @return	Capacity in semantic instructions (0 for no limit).
+ */
+
+/**
+ * @fn int Cache::size(void) const;
+ * Get the current size of the cache.
+ * @return	Size in semantic instructions.
+ */
+
+/**
+ * @fn int Cache::count(void) const;
+ * Get the number of programs in the cache.
+ * @return	Program count.
+ */
+
+/**
+ * @fn int Cache::hits(void) const;
+ * Get the number of programs found in the cache.
+ * @return	Hit count.
+ */
+
+/**
+ * @fn int Cache::misses(void) const;
+ * Get the number of programs translated by the cache.
+ * @return	Miss count.
+ */
+
+/**
+ * Translate a basic block into a program.
+ * @param bb	Basic block to translate.
+ * @return		Built program.
+ */
+Program *Cache::translate(BasicBlock *bb) {
+	_buf.clear();
+	_offs.clear();
+	for(BasicBlock::InstIter i(bb); i(); i++) {
+		_offs.add(_buf.length());
+		i->semInsts(_buf);
+		_buf.add(sem::cont());
+	}
+	_offs.add(_buf.length());
+	return new Program(bb, _buf, &_offs[0], _offs.length() - 1);
+}
+
+/**
+ * Remove a program from the LRU list.
+ * @param prog	Program to remove.
+ */
+void Cache::unlink(Program *prog) {
+	if(prog->_prev != nullptr)
+		prog->_prev->_next = prog->_next;
+	else
+		_first = prog->_next;
+	if(prog->_next != nullptr)
+		prog->_next->_prev = prog->_prev;
+	else
+		_last = prog->_prev;
+	prog->_prev = prog->_next = nullptr;
+}
+
+/**
+ * Free the least recently used programs not in use until the size
+ * of the cache is under its capacity.
+ */
+void Cache::evict(void) {
+	for(Program *prog = _last, *prev; prog != nullptr && _size > _cap; prog = prev) {
+		prev = prog->_prev;
+		if(prog->_pins == 0) {
+			unlink(prog);
+			_map.remove(prog->_bb);
+			_size -= prog->size();
+			delete prog;
+		}
+	}
+}
+
+
+/**
+ * Processor building the semantic instruction cache.
+ *
+ * @par Configuration
+ * @li @ref sem::CACHE_SIZE
+ *
+ * @par Provided Features
+ * @li @ref sem::COMPILED_SEM_FEATURE
+ *
+ * @ingroup sem
+ */
+class CacheBuilder: public Processor {
+public:
+	static p::declare reg;
+
+	CacheBuilder(p::declare& r = reg): Processor(r), _cache(nullptr), _cap(0) { }
+
+	void *interfaceFor(const otawa::AbstractFeature &feature) override {
+		if(&feature == &COMPILED_SEM_FEATURE)
+			return _cache;
+		else
+			return nullptr;
+	}
+
+protected:
+
+	void configure(const PropList& props) override {
+		Processor::configure(props);
+		_cap = CACHE_SIZE(props);
+	}
+
+	void processWorkSpace(WorkSpace *ws) override {
+		_cache = new Cache(_cap);
+	}
+
+	void destroy(WorkSpace *ws) override {
+		if(logFor(LOG_PROC))
+			log << "\tsemantic cache: " << _cache->hits() << " hits, " << _cache->misses() << " misses\n";
+		delete _cache;
+		_cache = nullptr;
+	}
+
+private:
+	Cache *_cache;
+	int _cap;
+};
+
+p::declare CacheBuilder::reg = p::init("otawa::sem::CacheBuilder", Version(1, 0, 0))
+	.maker<CacheBuilder>()
+	.use(COLLECTED_CFG_FEATURE)
+	.provide(COMPILED_SEM_FEATURE);
+
+
+/**
+ * This feature provides a cache of the semantic instructions of the basic
+ * blocks (see @ref sem::Cache) shared by the analyses interpreting
+ * the semantic instructions. As the cache is indexed by basic blocks,
+ * it is invalidated with the CFGs.
+ *
+ * @par Configuration
+ * @li @ref sem::CACHE_SIZE
+ *
+ * @par Used Features
+ * @li @ref COLLECTED_CFG_FEATURE
+ *
+ * @ingroup sem
+ */
+p::interfaced_feature<Cache> COMPILED_SEM_FEATURE(
+	"otawa::sem::COMPILED_SEM_FEATURE",
+	new Maker<CacheBuilder>());
+
+
+/**
+ * Configuration of @ref COMPILED_SEM_FEATURE giving the capacity, in semantic
+ * instructions, of the semantic instruction cache (default to 1M, 0 for no limit).
+ *
+ * @ingroup sem
+ */
+p::id<int> CACHE_SIZE("otawa::sem::CACHE_SIZE", 1 << 20);
+
+} }		// otawa::sem
@@ -21,6 +21,7 @@
 
 #include <elm/sys/System.h>
 #include <otawa/prog/features.h>
+#include <otawa/stats/ProcStats.h>
 #include <otawa/stats/StatsDumper.h>
 #include <otawa/stats/StatInfo.h>
 #include <otawa/cfgio/Output.h>
@@ -79,6 +80,9 @@ private:
  * * "ConcatOp" - concatenation aggregation operation (as above).
  * * "ContextOp" - context aggregation operation (as above).
  * 
+ * In addition, the resources consumed by each code processor
+ * (see @ref ProcStats) are saved in JSON in "proc-stats.json".
+ * 
  * @par Provided features
  * * @ref STATS_DUMP_FEATURE
  * 
@@ -140,6 +144,13 @@ void StatsDumper::processWorkSpace(WorkSpace *ws) {
 		delete stream;
 	}
 
+	// generate the processor statistics
+	if(ProcStats::get(ws)) {
+		json::Saver saver(path / "proc-stats.json");
+		saver.setReadable(true);
+		ProcStats::save(ws, saver);
+	}
+
 }
 
 ///
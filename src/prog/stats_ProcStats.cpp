@@ -0,0 +1,206 @@
+/*
+ *	ProcStats class implementation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <mutex>
+#include <elm/json.h>
+#include <otawa/cfg/BasicBlock.h>
+#include <otawa/cfg/features.h>
+#include <otawa/proc/MemoryProbe.h>
+#include <otawa/prop/DeletableProperty.h>
+#include <otawa/prog/WorkSpace.h>
+#include <otawa/stats/ProcStats.h>
+
+namespace otawa {
+
+// processors may run concurrently (see PARALLEL_REQUIRE)
+static std::mutex add_mutex;
+
+// fix-point iterations performed by the current thread
+static thread_local t::int64 iteration_count = 0;
+
+static int count(const PropList& props) {
+	int n = 0;
+	for(PropList::Iter p(props); p(); p++)
+		n++;
+	return n;
+}
+
+
+/**
+ * @class ProcStats
+ * Resources consumed by each code processor run on a workspace, recorded
+ * when @ref Processor::COLLECT_STATS is set:
+ * @li run time (in micro-seconds),
+ * @li allocated bytes,
+ * @li peak growth of the heap,
+ * @li number of properties added to blocks, edges and instructions
+ *	(-1 if not available, see @ref Processor::ADDED_PROPS),
+ * @li number of fix-point iterations (see iterate()).
+ *
+ * Memory figures are only available if @ref MemoryProbe is supported.
+ * The records are kept in the run order and may be displayed with print()
+ * or saved as JSON with save() (done by @ref StatsDumper in file
+ * "proc-stats.json").
+ *
+ * @ingroup proc
+ */
+
+
+/**
+ * Identifier of processor statistics.
+ *
+ * @par Hooks
+ * @li WorkSpace
+ */
+Identifier<ProcStats *> ProcStats::ID("otawa::ProcStats::ID", 0);
+
+
+/**
+ * Add a processor record to the workspace.
+ * @param ws		Current workspace.
+ * @param record	Record to add.
+ */
+void ProcStats::add(WorkSpace *ws, const record_t& record) {
+	std::lock_guard<std::mutex> guard(add_mutex);
+	ProcStats *stats = ID(ws);
+	if(!stats) {
+		stats = new ProcStats();
+		ws->addProp(new DeletableProperty<ProcStats *>(ID, stats));
+	}
+	stats->records.add(record);
+}
+
+
+/**
+ * Get the processor records of a workspace.
+ * @param ws	Current workspace.
+ * @return		Processor records in run order.
+ */
+const Vector<ProcStats::record_t>& ProcStats::get(WorkSpace *ws) {
+	static Vector<record_t> empty;
+	ProcStats *stats = ID(ws);
+	if(!stats)
+		return empty;
+	else
+		return stats->records;
+}
+
+
+/**
+ * Count the properties hooked to the blocks, edges and instructions
+ * of the CFGs involved in the workspace.
+ * @param ws	Current workspace.
+ * @return		Property count.
+ */
+int ProcStats::census(WorkSpace *ws) {
+	const CFGCollection *coll = INVOLVED_CFGS(ws);
+	if(coll == nullptr)
+		return 0;
+	int n = 0;
+	for(auto g: *coll)
+		for(auto v: *g) {
+			n += count(*v);
+			for(auto e: v->outEdges())
+				n += count(*e);
+			if(v->isBasic())
+				for(auto i: *v->toBasic())
+					n += count(*i);
+		}
+	return n;
+}
+
+
+/**
+ * Display the processor records as a table.
+ * @param ws	Current workspace.
+ * @param out	Output stream.
+ */
+void ProcStats::print(WorkSpace *ws, io::Output& out) {
+	out << "processor\ttime (ms)\tallocated (KB)\tpeak (KB)\tproperties\titerations\n";
+	for(const auto& r: get(ws)) {
+		out << r.name << '\t'
+			<< (r.time / 1000.) << '\t'
+			<< (r.allocated >> 10) << '\t'
+			<< (r.peak >> 10) << '\t';
+		if(r.props < 0)
+			out << '-';
+		else
+			out << r.props;
+		out << '\t' << r.iterations << io::endl;
+	}
+	if(!MemoryProbe::isAvailable())
+		out << "(memory probing not supported by this build)\n";
+}
+
+
+/**
+ * Save the processor records as a JSON array of objects with fields
+ * "name", "time" (micro-seconds), "allocated" and "peak" (bytes, -1 if
+ * memory probing is not supported), "properties" (-1 if unavailable) and
+ * "iterations".
+ * @param ws	Current workspace.
+ * @param saver	JSON saver to use.
+ */
+void ProcStats::save(WorkSpace *ws, json::Saver& saver) {
+	bool mem = MemoryProbe::isAvailable();
+	saver.beginArray();
+	for(const auto& r: get(ws)) {
+		saver.beginObject();
+		saver.addField("name");
+		saver.put(r.name);
+		saver.addField("time");
+		saver.put(t::int64(r.time));
+		saver.addField("allocated");
+		saver.put(mem ? r.allocated : t::int64(-1));
+		saver.addField("peak");
+		saver.put(mem ? r.peak : t::int64(-1));
+		saver.addField("properties");
+		saver.put(t::int64(r.props));
+		saver.addField("iterations");
+		saver.put(r.iterations);
+		saver.endObject();
+	}
+	saver.endArray();
+}
+
+
+
+/**
+ * Called by fix-point engines (@ref dfa::IterativeDFA,
+ * @ref dfa::XIterativeDFA, @ref dfa::hai::HalfAbsInt,
+ * @ref ai::WorkListDriver) to count their iterations, that is, the number
+ * of processed vertices. The count is recorded for the running processor.
+ * @param n		Number of iterations to add.
+ */
+void ProcStats::iterate(int n) {
+	iteration_count += n;
+}
+
+
+/**
+ * Get the count of fix-point iterations performed so far by the current thread.
+ * @return	Iteration count.
+ */
+t::int64 ProcStats::iterations(void) {
+	return iteration_count;
+}
+
+}	// otawa
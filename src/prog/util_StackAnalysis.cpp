@@ -25,6 +25,8 @@
 #	define HAI_DEBUG
 #endif
 
+#include <cstdint>
+#include <string.h>
 #include <otawa/dfa/State.h>
 #include <otawa/hard/Platform.h>
 #include <otawa/hard/Register.h>
@@ -32,6 +34,7 @@
 #include <otawa/proc/CFGProcessor.h>
 #include <otawa/prog/File.h>
 #include <otawa/prog/sem.h>
+#include <otawa/sem/Cache.h>
 #include <otawa/stack/AccessedAddress.h>
 #include <otawa/stack/features.h>
 #include <otawa/stack/StackAnalysis.h>
@@ -399,167 +402,198 @@ const Value& Value::none	= bot,	/** undefined value */
 			Value::all 		= top;	/** any value */
 
 
+/*
+ * The states are sorted lists of (address, value) pairs. The list nodes are
+ * immutable, reference-counted and hash-consed in a table: two equal
+ * lists are made of the same nodes. Therefore, copying a state only shares
+ * its list, comparing two states compares the list pointers, and a state
+ * modified by an update re-uses the unmodified suffix of the original list.
+ * The joins are also memoized in a small direct-mapped cache.
+ *
+ * The node table and the join cache are stored in a context created for each
+ * run of the analysis (see State::Session) and kept alive by the states
+ * using it. Therefore, concurrent runs of the analysis do not share any
+ * node but the states of a same run must not be used by different threads.
+ */
 class State {
+	class Context;
 public:
 
 	class Node {
 	public:
 		friend class State;
-		inline Node(void): next(0), addr(Value::none) { }
-		inline Node(const Value& address, const Value& value)
-			: next(0), addr(address), val(value) { }
-		inline Node(const Node *node)
-			: next(0), addr(node->addr), val(node->val) { }
+		inline const Value& address(void) const { return addr; }
+		inline const Value& value(void) const { return val; }
+		inline const Node *tail(void) const { return next; }
 	private:
-		Node *next;
+		inline Node(const Value& address, const Value& value, Node *tail, t::hash hash)
+			: addr(address), val(value), next(tail), rc(1), link(nullptr), h(hash) { }
 		Value addr;
 		Value val;
+		Node *next;
+		int rc;
+		Node *link;
+		t::hash h;
+	};
+
+	/*
+	 * Open a context for the states built during a run of the analysis.
+	 */
+	class Session {
+	public:
+		Session(void): old(current) { current = new Context(); current->users++; }
+		~Session(void) { current->flush(); unuse(current); current = old; }
+	private:
+		Context *old;
 	};
 
-	State(const Value& def = Value::all): first(Value::none, def)
+	State(const Value& def = Value::all): _addr(Value::none), _def(def), _head(nullptr), _ctx(nullptr)
 		{ TRACED(cerr << "State(" << def << ")\n"); }
-	State(const State& state): first(Value::none, Value::all)
+	State(const State& state): _addr(Value::none), _def(Value::all), _head(nullptr), _ctx(nullptr)
 		{ TRACED(cerr << "State("; state.print(cerr); cerr << ")\n"); copy(state); }
-	~State(void) { clear(); }
+	~State(void) { clear(); attach(nullptr); }
 
-	inline bool isBot(void) const { return first.addr == Value::none; }
+	inline bool isBot(void) const { return _addr == Value::none; }
 	inline State& operator=(const State& state) { copy(state); return *this; }
 
 	void copy(const State& state) {
 		TRACED(cerr << "copy("; print(cerr); cerr << ", "; state.print(cerr); cerr << ") = ");
-		clear();
-		first = state.first;
-		for(Node *prev = &first, *cur = state.first.next; cur; cur = cur->next) {
-			prev->next = new Node(cur);
-			prev = prev->next;
-		}
+		Node *head = fix(state._head);
+		if(_ctx != nullptr)
+			_ctx->release(_head);
+		_addr = state._addr;
+		_def = state._def;
+		_head = head;
+		if(state._ctx != nullptr)
+			attach(state._ctx);
 		TRACED(print(cerr); cerr << io::endl);
 	}
 
 	void clear(void) {
-		for(Node *cur = first.next, *next;
-		cur;
-		cur = next) {
-			next = cur->next;
-			delete cur;
-		}
-		first.next = 0;
+		if(_ctx != nullptr)
+			_ctx->release(_head);
+		_head = nullptr;
 	}
 
 	void set(const Value& addr, const Value& val) {
 		TRACED(cerr << "set("; print(cerr); cerr << ", " << addr << ", " << val << ") = ");
-		Node *prev, *cur, *next;
-		if(first.val == Value::none) {
+		if(_def == Value::none) {
 			TRACED(print(cerr); cerr << io::endl);
 			return;
 		}
+		int k = 0;
+		Node *cur, *tail;
+		Context *c = context();
 
 		// consum all memory references
 		if(addr.kind() == ALL) {
-			for(prev = &first, cur = first.next; cur && cur->addr.kind() <= SP; prev = cur, cur = cur->next) ;
-			while(cur) {
-				next = cur->next;
-				delete cur;
-				cur = next;
-			}
-			prev->next = 0;
+			for(cur = _head; cur && cur->addr.kind() <= SP; cur = cur->next)
+				k++;
+			if(cur == nullptr)
+				return;
+			tail = nullptr;
 		}
 
 		// find a value
 		else {
-			for(prev = &first, cur = first.next; cur && cur->addr < addr; prev = cur, cur = cur->next);
+			for(cur = _head; cur && cur->addr < addr; cur = cur->next)
+				k++;
 			if(cur && cur->addr == addr) {
 				if(val.kind() != ALL)
-					cur->val = val;
-				else {
-					prev->next = cur->next;
-					delete cur;
-				}
-			}
-			else if(val.kind() != ALL) {
-				next = new Node(addr, val);
-				prev->next = next;
-				prev->next->next = cur;
+					tail = c->make(addr, val, cur->next);
+				else
+					tail = fix(cur->next);
 			}
+			else if(val.kind() != ALL)
+				tail = c->make(addr, val, cur);
+			else
+				return;
 		}
 
+		// rebuild the modified prefix
+		Node *head = c->rebuild(_head, k, tail);
+		c->release(_head);
+		_head = head;
 		TRACED(print(cerr); cerr << io::endl);
 	}
 
 	bool equals(const State& state) const {
-		if(first.val.kind() != state.first.val.kind())
-			return false;
-		Node *cur = first.next, *cur2 = state.first.next;
-		while(cur && cur2) {
-			if(cur->addr != cur2->addr)
-				return false;
-			if(cur->val != cur->val)
-				return false;
-			cur = cur->next;
-			cur2 = cur2->next;
-		}
-		return cur == cur2;
+		return _def.kind() == state._def.kind() && _head == state._head;
 	}
 
 	void join(const State& state) {
 		TRACED(cerr << "join(\n\t"; print(cerr); cerr << ",\n\t";  state.print(cerr); cerr << "\n\t) = ");
 
 		// test none states
-		if(state.first.val == Value::none)
+		if(state._def == Value::none)
 			return;
-		if(first.val == Value::none) {
+		if(_def == Value::none) {
 			copy(state);
 			TRACED(print(cerr); cerr << io::endl;);
 			return;
 		}
+		if(_head == state._head)
+			return;
+		if(_ctx == nullptr)
+			attach(state._ctx);
+		Context *c = _ctx;
+		ASSERT(state._ctx == nullptr || state._ctx == c);
+
+		// look in the cache
+		JoinEntry& e = c->joins[(hash(_head) ^ (hash(state._head) * 31)) & (join_size - 1)];
+		if(e.a == _head && e.b == state._head) {
+			Node *r = fix(e.r);
+			c->release(_head);
+			_head = r;
+			TRACED(print(cerr); cerr << io::endl;);
+			return;
+		}
 
-		Node *prev = &first, *cur = first.next, *cur2 = state.first.next, *next;
+		// merge the lists, stop at a shared suffix
+		Vector<Pair<Value, Value> > res;
+		Node *cur = _head, *cur2 = state._head, *tail = nullptr;
 		while(cur && cur2) {
-
-			// addr1 < addr2 -> remove cur1
-			if(cur->addr < cur2->addr) {
-				prev->next = cur->next;
-				delete cur;
-				cur = prev->next;
+			if(cur == cur2) {
+				tail = fix(cur);
+				break;
 			}
-
-			// equality ? remove if join result in all
+			else if(cur->addr < cur2->addr)
+				cur = cur->next;
 			else if(cur->addr == cur2->addr) {
-				cur->val.join(cur2->val);
-				if(cur->val.kind() == ALL) {
-					prev->next = cur->next;
-					delete cur;
-					cur = prev->next;
-				}
-				else {
-					prev = cur;
-					cur = cur->next;
-					cur2 = cur2->next;
-				}
+				Value v = cur->val;
+				v.join(cur2->val);
+				if(v.kind() != ALL)
+					res.add(pair(cur->addr, v));
+				cur = cur->next;
+				cur2 = cur2->next;
 			}
-
-			// addr1 > addr2 => remove cur2
 			else
 				cur2 = cur2->next;
 		}
-
-		// remove tail
-		prev->next = 0;
-		while(cur) {
-			next = cur->next;
-			delete cur;
-			cur = next;
+		for(int i = res.length() - 1; i >= 0; i--) {
+			Node *n = c->make(res[i].fst, res[i].snd, tail);
+			c->release(tail);
+			tail = n;
 		}
+
+		// record in the cache
+		c->release(e.a);
+		c->release(e.b);
+		c->release(e.r);
+		e.a = _head;
+		e.b = fix(state._head);
+		e.r = fix(tail);
+		_head = tail;
 		TRACED(print(cerr); cerr << io::endl;);
 	}
 
 	void print(io::Output& out) const {
-		if(first.val == Value::none)
+		if(_def == Value::none)
 			out << '_';
 		else {
 			bool f =  true;
 			out << "{ ";
-			for(Node *cur = first.next; cur; cur = cur->next) {
+			for(Node *cur = _head; cur; cur = cur->next) {
 				if(f)
 					f = false;
 				else
@@ -576,12 +610,12 @@ public:
 		case 2: { t::uint16 v; proc->get(addr, v); return Value(CST, v); }
 		case 4: { t::uint32 v; proc->get(addr, v); return Value(CST, v); }
 		}
-		return first.val;
+		return _def;
 	}
 
 	Value get(const Value& addr, Process *proc, int size) const {
 		Node * cur;
-		for(cur = first.next; cur && cur->addr < addr; cur = cur->next) ;
+		for(cur = _head; cur && cur->addr < addr; cur = cur->next) ;
 		if(cur && cur->addr == addr)
 			return cur->val;
 		if(addr.kind() == CST)
@@ -589,14 +623,182 @@ public:
 				for(File::SegIter seg(*file); seg(); seg++)
 					if(seg->contains(addr.value()))
 						return fromImage(addr.value(), proc, size);
-		return first.val;
+		return _def;
 	}
 
 	static const State EMPTY, FULL;
 
 private:
-	Node first;
+
+	class JoinEntry {
+	public:
+		Node *a, *b, *r;
+	};
+	static const int join_size = 1024;
+
+	class Context {
+	public:
+
+		Context(void): table_size(1024), node_count(0), users(0) {
+			table = new Node *[table_size]();
+			for(int i = 0; i < join_size; i++)
+				joins[i].a = joins[i].b = joins[i].r = nullptr;
+		}
+
+		/**
+		 * The context is deleted when no more state uses it: the nodes still
+		 * alive are only referenced by the join cache.
+		 */
+		~Context(void) { flush(); delete [] table; }
+
+		/**
+		 * Get the node (address, value) followed by the given tail,
+		 * creating it if it does not exist.
+		 * @param addr	Node address.
+		 * @param val	Node value.
+		 * @param tail	Following node (reference borrowed).
+		 * @return		New reference on the node.
+		 */
+		Node *make(const Value& addr, const Value& val, Node *tail) {
+			t::hash h = (hash(addr) * 31 + hash(val)) * 31 + hash(tail);
+			for(Node *n = table[h & (table_size - 1)]; n; n = n->link)
+				if(n->h == h && n->next == tail && n->addr == addr && n->val == val)
+					return fix(n);
+
+			// build the node
+			Node *n = new Node(addr, val, fix(tail), h);
+			n->link = table[h & (table_size - 1)];
+			table[h & (table_size - 1)] = n;
+			node_count++;
+
+			// grow the table if needed
+			if(node_count > 2 * table_size) {
+				int size = table_size * 2;
+				Node **ntable = new Node *[size]();
+				for(int i = 0; i < table_size; i++)
+					for(Node *m = table[i], *next; m; m = next) {
+						next = m->link;
+						m->link = ntable[m->h & (size - 1)];
+						ntable[m->h & (size - 1)] = m;
+					}
+				delete [] table;
+				table = ntable;
+				table_size = size;
+			}
+			return n;
+		}
+
+		/**
+		 * Release a reference on a node and free the nodes that are
+		 * no more referenced.
+		 * @param n		Node to release (may be null).
+		 */
+		void release(Node *n) {
+			while(n != nullptr && --n->rc == 0) {
+				Node **p = &table[n->h & (table_size - 1)];
+				while(*p != n)
+					p = &(*p)->link;
+				*p = n->link;
+				node_count--;
+				Node *next = n->next;
+				delete n;
+				n = next;
+			}
+		}
+
+		/**
+		 * Build a list made of the k first nodes of the given list
+		 * followed by the given tail.
+		 * @param list	List to take the prefix from.
+		 * @param k		Prefix length.
+		 * @param tail	Tail of the list (reference consumed).
+		 * @return		New reference on the built list.
+		 */
+		Node *rebuild(Node *list, int k, Node *tail) {
+			if(k == 0)
+				return tail;
+			Vector<Node *> pref(k);
+			for(int i = 0; i < k; i++, list = list->next)
+				pref.add(list);
+			for(int i = k - 1; i >= 0; i--) {
+				Node *n = make(pref[i]->addr, pref[i]->val, tail);
+				release(tail);
+				tail = n;
+			}
+			return tail;
+		}
+
+		/**
+		 * Release the lists kept alive by the join cache.
+		 */
+		void flush(void) {
+			for(int i = 0; i < join_size; i++) {
+				release(joins[i].a);
+				release(joins[i].b);
+				release(joins[i].r);
+				joins[i].a = joins[i].b = joins[i].r = nullptr;
+			}
+		}
+
+		JoinEntry joins[join_size];
+		Node **table;
+		int table_size, node_count;
+		int users;
+	};
+
+	static inline t::hash hash(const Node *n)
+		{ return t::hash(reinterpret_cast<std::uintptr_t>(n) >> 4); }
+
+	static inline t::hash hash(const Value& v) {
+		t::uint32 w[2];
+		memcpy(w, &v, sizeof(w));
+		return w[0] * 0x9E3779B1 ^ w[1];
+	}
+
+	static inline Node *fix(Node *n) {
+		if(n != nullptr)
+			n->rc++;
+		return n;
+	}
+
+	static inline void unuse(Context *ctx) {
+		if(ctx != nullptr && --ctx->users == 0)
+			delete ctx;
+	}
+
+	/**
+	 * Change the context of the state (its list must already be released).
+	 * @param ctx	New context (may be null).
+	 */
+	inline void attach(Context *ctx) {
+		if(ctx == _ctx)
+			return;
+		if(ctx != nullptr)
+			ctx->users++;
+		unuse(_ctx);
+		_ctx = ctx;
+	}
+
+	/**
+	 * Get the context to build the list of the state. Out of a session
+	 * (for instance when the results are used), a state without context
+	 * gets its own one.
+	 * @return	State context.
+	 */
+	inline Context *context(void) {
+		if(_ctx == nullptr)
+			attach(current != nullptr ? current : new Context());
+		return _ctx;
+	}
+
+	static thread_local Context *current;
+
+	Value _addr;
+	Value _def;
+	Node *_head;
+	Context *_ctx;
 };
+thread_local State::Context *State::current = nullptr;
 const State State::EMPTY(Value::none), State::FULL(Value::all);
 io::Output& operator<<(io::Output& out, const State& state) { state.print(out); return out; }
 
@@ -611,7 +813,7 @@ public:
 	typedef StackProblem Problem;
 	Problem& getProb(void) { return *this; }
 
-	StackProblem(WorkSpace *ws): proc(ws->process()) {
+	StackProblem(WorkSpace *ws): proc(ws->process()), cache(sem::COMPILED_SEM_FEATURE.get(ws)) {
 
 		// execute process initialization
 		sem::PathIter i;
@@ -793,24 +995,26 @@ public:
 	}
 
 	void update(Domain& is, Inst *i) {
-		int pc;
 		TRACEU(cerr << '\t' << i->address() << ": "; i->dump(cerr); cerr << io::endl);
-
-		// get instructions
 		b.clear();
 		i->semInsts(b);
-		pc = 0;
+		b.add(sem::cont());
+		update(is, &b[0], b.length());
+	}
+
+	void update(Domain& is, const sem::inst *code, int n) {
+		int pc = 0;
 		Domain *state = &is;
 
 		// perform interpretation
 		while(true) {
 
 			// interpret current
-			while(pc < b.length()) {
-				sem::inst& i = b[pc];
+			while(pc < n) {
+				const sem::inst& i = code[pc];
 				switch(i.op) {
 				case sem::CONT:
-					pc = b.length();
+					pc = n;
 					TRACES(cerr << "\t\tcut\n");
 					break;
 				case sem::IF:
@@ -843,8 +1047,10 @@ public:
 		if(bb->isBasic()) {
 			out.copy(in);
 			TRACEU(cerr << "update(BB" << bb->number() << ", " << in << ")\n");
-			for(BasicBlock::InstIter inst = bb->toBasic()->insts(); inst(); inst++)
-				update(out, *inst);
+			sem::Program *prog = cache->use(bb->toBasic());
+			for(int i = 0; i < prog->count(); i++)
+				update(out, prog->code(i), prog->length(i));
+			cache->release(prog);
 			TRACEU(cerr << "\tout = " << out << io::endl);
 		}
 		else
@@ -859,6 +1065,7 @@ private:
 	sem::Block b;
 	Vector<Pair<int, Domain *> > todo;
 	Process *proc;
+	sem::Cache *cache;
 };
 
 
@@ -882,6 +1089,7 @@ private:
  * @par Required Features
  * @li @ref otawa::VIRTUALIZED_CFG_FEATURE
  * @li @ref otawa::LOOP_INFO_FEATURE
+ * @li @ref otawa::sem::COMPILED_SEM_FEATURE
  *
  * @ingroup stack
  */
@@ -893,6 +1101,7 @@ p::declare StackAnalysis::reg = p::init("otawa::StackAnalysis", Version(1, 0, 0)
 	.maker<StackAnalysis>()
 	.require(LOOP_INFO_FEATURE)
 	.require(dfa::INITIAL_STATE_FEATURE)
+	.require(sem::COMPILED_SEM_FEATURE)
 	.provide(STACK_ANALYSIS_FEATURE);
 
 
@@ -911,6 +1120,7 @@ void StackAnalysis::processWorkSpace(WorkSpace *ws) {
 	// perform the analysis
 	if(logFor(LOG_CFG))
 		log << "FUNCTION " << cfg->label() << io::endl;
+	stack::State::Session session;
 	StackProblem prob(ws);
 	const hard::Register *sp = ws->process()->platform()->getSP();
 	if(sp)
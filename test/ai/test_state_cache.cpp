@@ -0,0 +1,185 @@
+/*
+ *	Test file for the fix-point state cache of ai::CFGAnalyzer
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/data/List.h>
+#include <otawa/ai/CFGAnalyzer.h>
+#include <otawa/app/Application.h>
+#include <otawa/cfg/features.h>
+#include <otawa/prog/Inst.h>
+#include <otawa/prog/WorkSpace.h>
+
+using namespace elm;
+using namespace otawa;
+
+// set of reached rows (height 32)
+class RowState: public ai::State {
+public:
+	RowState(t::uint32 r): rows(r) { }
+	t::uint32 rows;
+};
+
+class RowDomain: public ai::Domain {
+public:
+	RowDomain(void): _bot(make(0)), _top(make(0xffffffff)), _entry(make(0)), _discarded(0) { }
+	~RowDomain(void) { for(auto s: _states) delete s; }
+
+	inline int discarded(void) const { return _discarded; }
+	inline bool isBot(ai::State *s) const { return s == _bot; }
+	inline t::uint32 rows(ai::State *s) const { return static_cast<RowState *>(s)->rows; }
+
+	ai::State *bot() override { return _bot; }
+	ai::State *top() override { return _top; }
+	ai::State *entry() override { return _entry; }
+
+	bool equals(ai::State *s1, ai::State *s2) override
+		{ return s1 == s2 || (s1 != _bot && s2 != _bot && rows(s1) == rows(s2)); }
+
+	ai::State *join(ai::State *s1, ai::State *s2) override {
+		if(s1 == _bot)
+			return s2;
+		else if(s2 == _bot)
+			return s1;
+		else
+			return make(rows(s1) | rows(s2));
+	}
+
+	ai::State *update(Edge *e, ai::State *s) override { return s; }
+
+	ai::State *update(Block *v, ai::State *s) override {
+		if(s == _bot || !v->isBasic())
+			return s;
+		t::uint32 r = rows(s);
+		for(auto i: *v->toBasic())
+			r |= 1 << ((i->address().offset() >> 4) & 0x1f);
+		return make(r);
+	}
+
+	bool implementsIO() override { return true; }
+
+	void save(ai::State *s, io::OutStream *out) override {
+		t::uint8 b = s == _bot;
+		t::uint32 r = rows(s);
+		if(out->write(reinterpret_cast<const char *>(&b), sizeof(b)) != sizeof(b)
+		|| out->write(reinterpret_cast<const char *>(&r), sizeof(r)) != sizeof(r))
+			throw io::IOException(out->lastErrorMessage());
+	}
+
+	ai::State *load(io::InStream *in) override {
+		t::uint8 b;
+		t::uint32 r;
+		if(in->read(&b, sizeof(b)) != sizeof(b) || in->read(&r, sizeof(r)) != sizeof(r))
+			throw io::IOException("truncated state");
+		return b ? _bot : make(r);
+	}
+
+	void discard(ai::State *s) override {
+		if(s == _bot || s == _top || s == _entry)
+			return;
+		_states.remove(static_cast<RowState *>(s));
+		delete static_cast<RowState *>(s);
+		_discarded++;
+	}
+
+private:
+	RowState *make(t::uint32 r) {
+		RowState *s = new RowState(r);
+		_states.add(s);
+		return s;
+	}
+
+	List<RowState *> _states;
+	RowState *_bot, *_top, *_entry;
+	int _discarded;
+};
+
+
+/*
+ * Compute the fix-point of a simple domain without cache, then with the state
+ * cache (the first analysis may miss or hit the cache depending on previous
+ * runs, the second one must hit it) and check that the three fix-points are
+ * identical. An analysis with another signature must not use the cache.
+ */
+class StateCacheTest: public Application {
+public:
+	StateCacheTest(void): Application(Make("test_state_cache")) { }
+
+protected:
+
+	void work(const string& entry, PropList &props) override {
+		require(COLLECTED_CFG_FEATURE);
+		require(CFG_CHECKSUM_FEATURE);
+		const CFGCollection *coll = COLLECTED_CFG_FEATURE.get(workspace());
+		sys::Path dir = _ << "test_state_cache-"
+			<< sys::Path(workspace()->process()->program()->name()).basePart().namePart() << ".d";
+
+		// reference without cache
+		RowDomain rdom;
+		ai::CFGAnalyzer ref(*this, rdom);
+		ref.process();
+
+		// first and second analyses with cache
+		PropList conf;
+		ai::CFGAnalyzer::STATE_CACHE(conf) = dir;
+		ai::CFGAnalyzer::STATE_SIGN(conf) = "rows-32";
+		RowDomain dom1;
+		ai::CFGAnalyzer ana1(*this, dom1);
+		ana1.configure(conf);
+		ana1.process();
+		cout << "first analysis " << (ana1.isCached() ? "loaded from" : "saved to") << " the cache" << io::endl;
+		RowDomain dom2;
+		ai::CFGAnalyzer ana2(*this, dom2);
+		ana2.configure(conf);
+		ana2.process();
+		if(!ana2.isCached())
+			throw otawa::Exception("second analysis not loaded from the cache");
+		if(dom2.discarded() != 1)
+			throw otawa::Exception(_ << dom2.discarded() << " states discarded instead of the entry state");
+
+		// compare the fix-points
+		int n = 0;
+		for(auto g: *coll)
+			for(auto v: *g) {
+				compare(rdom, ref, dom1, ana1, v);
+				compare(rdom, ref, dom2, ana2, v);
+				n++;
+			}
+		cout << n << " blocks: cached fix-points are identical" << io::endl;
+
+		// another signature does not use the cache
+		ai::CFGAnalyzer::STATE_SIGN(conf) = "rows-32-other";
+		RowDomain dom3;
+		ai::CFGAnalyzer ana3(*this, dom3);
+		ana3.configure(conf);
+		ana3.process();
+		cout << "other signature " << (ana3.isCached() ? "loaded from" : "saved to") << " the cache" << io::endl;
+	}
+
+private:
+
+	void compare(RowDomain& rdom, ai::CFGAnalyzer& ref, RowDomain& dom, ai::CFGAnalyzer& ana, Block *v) {
+		ai::State *s = ref.after(v), *t = ana.after(v);
+		if(rdom.isBot(s) != dom.isBot(t) || (!rdom.isBot(s) && rdom.rows(s) != dom.rows(t)))
+			throw otawa::Exception(_ << "state after " << v << " differs");
+	}
+
+};
+
+OTAWA_RUN(StateCacheTest)
@@ -0,0 +1,136 @@
+/*
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/io/Output.h>
+#include <elm/sys/System.h>
+#include <elm/util/Version.h>
+
+#include <otawa/ai/ArrayStore.h>
+#include <otawa/ai/CFGGraph.h>
+#include <otawa/ai/RankingAI.h>
+#include <otawa/ai/SimpleAI.h>
+#include <otawa/ai/WTO.h>
+#include <otawa/app/Test.h>
+#include <otawa/cfg/features.h>
+#include <otawa/prog/Inst.h>
+
+using namespace elm;
+using namespace otawa;
+
+// set of reached rows (height 32)
+class RowDomain {
+public:
+	typedef t::uint32 t;
+	inline t init(void) const { return 0; }
+	inline t bot(void) const { return 0; }
+	inline t join(t x1, t x2) const { return x1 | x2; }
+	inline bool equals(t x1, t x2) const { return x1 == x2; }
+	inline void copy(t& x, t y) const { x = y; }
+	t update(Block *v, t x) const {
+		if(v->isBasic())
+			for(auto i: *v->toBasic())
+				x |= 1 << ((i->address().offset() >> 4) & 0x1f);
+		return x;
+	}
+};
+
+class RowAdapter {
+public:
+	typedef RowDomain domain_t;
+	typedef ai::CFGGraph graph_t;
+	typedef ai::ArrayStore<RowDomain, ai::CFGGraph> store_t;
+
+	RowAdapter(CFG *cfg): _graph(cfg), _store(_dom, _graph) { }
+
+	void update(Block *v, RowDomain::t& x) {
+		x = _dom.bot();
+		for(auto e = _graph.preds(v); e(); e++)
+			x = _dom.join(x, _store.get(*e));
+		x = _dom.update(v, x);
+	}
+
+	inline RowDomain& domain(void) { return _dom; }
+	inline ai::CFGGraph& graph(void) { return _graph; }
+	inline store_t& store(void) { return _store; }
+
+private:
+	RowDomain _dom;
+	ai::CFGGraph _graph;
+	store_t _store;
+};
+
+
+class TestWTO: public Test {
+public:
+	TestWTO(void): Test("test_wto") { }
+
+protected:
+
+	void generate(io::Output& out) override {
+		require(ai::RANKING_FEATURE);
+		int simple_total = 0, ranking_total = 0, wto_total = 0, errors = 0;
+		for(auto g: *COLLECTED_CFG_FEATURE.get(workspace())) {
+
+			RowAdapter sa(g);
+			ai::SimpleAI<RowAdapter> simple(sa);
+			simple.run();
+
+			RowAdapter ra(g);
+			ai::RankingAI<RowAdapter> ranking(ra);
+			ranking.run();
+
+			RowAdapter wa(g);
+			ai::WTOAI<RowAdapter> wto(wa);
+			wto.run();
+
+			// all strategies must reach the same fix-point
+			for(auto v: *g)
+				if(v->isBasic()) {
+					if(sa.store().get(v) != wa.store().get(v)) {
+						out << "ERROR: WTO/simple mismatch at " << v << io::endl;
+						errors++;
+					}
+					if(ra.store().get(v) != wa.store().get(v)) {
+						out << "ERROR: WTO/ranking mismatch at " << v << io::endl;
+						errors++;
+					}
+				}
+
+			out << g << ": simple=" << simple.updates()
+				<< ", ranking=" << ranking.updates()
+				<< ", wto=" << wto.updates() << io::endl;
+			simple_total += simple.updates();
+			ranking_total += ranking.updates();
+			wto_total += wto.updates();
+		}
+		out << "total: simple=" << simple_total
+			<< ", ranking=" << ranking_total
+			<< ", wto=" << wto_total << io::endl;
+
+		// a mismatch fails the test, even without reference
+		if(errors != 0) {
+			out.flush();
+			cerr << "Test failed: " << errors << " fix-point mismatch(es)!\n";
+			sys::System::exit(1);
+		}
+	}
+
+};
+
+OTAWA_RUN(TestWTO);
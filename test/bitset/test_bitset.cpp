@@ -0,0 +1,275 @@
+/*
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <random>
+#include <elm/data/Array.h>
+#include <elm/sys/StopWatch.h>
+#include <elm/util/BitVector.h>
+#include <otawa/app/Application.h>
+#include <otawa/cfg/features.h>
+#include <otawa/dfa/AdaptiveBitVector.h>
+
+using namespace elm;
+using namespace otawa;
+
+/*
+ * Compare elm::BitVector and dfa::AdaptiveBitVector on the CFGs of a program
+ * with two fix-point computations over sets of blocks: dominance (dense sets)
+ * and forward reachability (mostly sparse sets in the program-wide index
+ * space). Both implementations must give the same results; time and memory
+ * are displayed for each of them.
+ *
+ * Before, every operation of dfa::AdaptiveBitVector is checked against
+ * elm::BitVector on random vectors of various sizes and populations, including
+ * the switches between dense and sparse representations.
+ */
+class BitSetBench: public Application {
+public:
+	BitSetBench(void): Application(Make("test_bitset")) { }
+
+protected:
+
+	void work(const string& entry, PropList &props) override {
+		differential();
+		require(COLLECTED_CFG_FEATURE);
+		const CFGCollection *coll = COLLECTED_CFG_FEATURE.get(workspace());
+		int n = coll->countBlocks();
+		cout << "blocks: " << n << io::endl;
+
+		AllocArray<BitVector> bdom(n), breach(n);
+		AllocArray<dfa::AdaptiveBitVector> adom(n), areach(n);
+		measure("elm::BitVector", *coll, bdom, breach);
+		measure("dfa::AdaptiveBitVector", *coll, adom, areach);
+
+		for(int i = 0; i < n; i++)
+			for(int j = 0; j < n; j++)
+				if(bdom[i].bit(j) != adom[i].bit(j) || breach[i].bit(j) != areach[i].bit(j))
+					throw otawa::Exception(_ << "results differ for block " << i << " and " << j);
+		cout << "results are identical" << io::endl;
+	}
+
+private:
+
+	void fail(cstring op, int size, int k) {
+		throw otawa::Exception(_ << op << " differs for size " << size << " at iteration " << k);
+	}
+
+	// check the content and the representation invariants of a vector
+	void check(cstring op, int size, int k, const dfa::AdaptiveBitVector& a, const BitVector& r) {
+		if(a.size() != r.size() || a.countBits() != r.countBits()
+		|| a.isEmpty() != (r.countBits() == 0) || a.isFull() != (r.countBits() == r.size()))
+			fail(op, size, k);
+		for(int i = 0; i < r.size(); i++)
+			if(a.bit(i) != r.bit(i))
+				fail(op, size, k);
+		BitVector::OneIterator j(r);
+		for(dfa::AdaptiveBitVector::OneIterator i(a); i(); i++, j++)
+			if(!j() || *i != *j)
+				fail(op, size, k);
+		if(j())
+			fail(op, size, k);
+		int words = (size + 31) >> 5;
+		if((words <= 2 && !a.isDense()) || (!a.isDense() && a.countBits() > words))
+			fail(op, size, k);
+	}
+
+	void fill(std::mt19937& rand, int size, double p, dfa::AdaptiveBitVector& a, BitVector& r) {
+		std::uniform_real_distribution<> d(0, 1);
+		for(int i = 0; i < size; i++)
+			if(d(rand) < p) {
+				a.set(i);
+				r.set(i);
+			}
+	}
+
+	// check every operation of AdaptiveBitVector against elm::BitVector
+	void differential(void) {
+		static const int sizes[] = { 1, 31, 32, 33, 64, 65, 95, 96, 97, 200, 1000, 4099 };
+		static const double pops[] = { 0, .005, .02, .1, .3, .7, .95, 1 };
+		std::mt19937 rand(2026);
+		int count = 0;
+		for(auto size: sizes)
+			for(int k = 0; k < 200; k++) {
+				double pa = pops[rand() % 8], pb = pops[rand() % 8];
+				dfa::AdaptiveBitVector a(size, pa == 1), b(size);
+				BitVector ra(size, pa == 1), rb(size);
+				fill(rand, size, pa, a, ra);
+				fill(rand, size, pb, b, rb);
+				check("set", size, k, a, ra);
+				check("set", size, k, b, rb);
+
+				// predicates
+				if(a.equals(b) != ra.equals(rb))
+					fail("equals", size, k);
+				if(a.includes(b) != ra.includes(rb) || b.includes(a) != rb.includes(ra))
+					fail("includes", size, k);
+				if(a.includesStrictly(b) != ra.includesStrictly(rb) || b.includesStrictly(a) != rb.includesStrictly(ra))
+					fail("includesStrictly", size, k);
+				if(a.meets(b) != ra.meets(rb) || b.meets(a) != rb.meets(ra))
+					fail("meets", size, k);
+
+				// operations
+				dfa::AdaptiveBitVector c;
+				BitVector rc;
+				c = a; c.applyOr(b); rc = ra; rc.applyOr(rb);
+				check("applyOr", size, k, c, rc);
+				c = a; c.applyAnd(b); rc = ra; rc.applyAnd(rb);
+				check("applyAnd", size, k, c, rc);
+				c = a; c.applyReset(b); rc = ra; rc.applyReset(rb);
+				check("applyReset", size, k, c, rc);
+				c = b; c.applyReset(a); rc = rb; rc.applyReset(ra);
+				check("applyReset", size, k, c, rc);
+				c = a; c.applyNot(); rc = ra; rc.applyNot();
+				check("applyNot", size, k, c, rc);
+				check("makeOr", size, k, a.makeOr(b), ra.makeOr(rb));
+				check("makeAnd", size, k, a.makeAnd(b), ra.makeAnd(rb));
+				check("makeReset", size, k, a.makeReset(b), ra.makeReset(rb));
+				check("makeNot", size, k, b.makeNot(), rb.makeNot());
+				c = a; c.applyOr(a);
+				check("applyOr", size, k, c, ra);
+				c = a; c.applyAnd(a);
+				check("applyAnd", size, k, c, ra);
+				c = a; c.applyReset(a);
+				check("applyReset", size, k, c, BitVector(size));
+
+				// random set and clear
+				for(int i = 0; i < 2 * size; i++) {
+					int j = rand() % size;
+					if(rand() % 2) {
+						a.set(j);
+						ra.set(j);
+					}
+					else {
+						a.clear(j);
+						ra.clear(j);
+					}
+				}
+				check("set/clear", size, k, a, ra);
+
+				// all bits
+				c = a; c.clear(); rc = ra; rc.clear();
+				check("clear", size, k, c, rc);
+				c.set(); rc.set();
+				check("set", size, k, c, rc);
+				count++;
+			}
+
+		// dense to sparse and back
+		for(auto size: sizes) {
+			int words = (size + 31) >> 5;
+			dfa::AdaptiveBitVector a(size, true);
+			BitVector ra(size, true);
+			Vector<int> order;
+			for(int i = 0; i < size; i++)
+				order.add(i);
+			for(int i = size - 1; i > 0; i--) {
+				int j = rand() % (i + 1), t = order[i];
+				order[i] = order[j];
+				order[j] = t;
+			}
+			for(int i = 0; i < size; i++) {
+				a.clear(order[i]);
+				ra.clear(order[i]);
+				check("clear", size, i, a, ra);
+				if(words > 2 && a.isDense() && a.countBits() <= words / 4)
+					fail("switch to sparse", size, i);
+			}
+			for(int i = 0; i < size; i++) {
+				a.set(order[i]);
+				ra.set(order[i]);
+				check("set", size, i, a, ra);
+				if(words > 2 && a.countBits() > words && !a.isDense())
+					fail("switch to dense", size, i);
+			}
+			count++;
+		}
+		cout << count << " differential checks passed" << io::endl;
+	}
+
+	template <class V>
+	void measure(cstring name, const CFGCollection& coll, AllocArray<V>& dom, AllocArray<V>& reach) {
+		sys::StopWatch sw;
+		sw.start();
+		int iters = computeDom(coll, dom) + computeReach(coll, reach);
+		sw.stop();
+		int size = 0;
+		for(int i = 0; i < dom.count(); i++)
+			size += dom[i].__size() + reach[i].__size();
+		cout << name << ": " << sw.delay().micros() << "us, "
+			 << size << " bytes, " << iters << " iterations" << io::endl;
+	}
+
+	template <class V>
+	int computeDom(const CFGCollection& coll, AllocArray<V>& dom) {
+		int n = dom.count(), iters = 0;
+		for(auto g: coll)
+			for(auto v: *g) {
+				dom[v->id()] = V(n, v != g->entry());
+				dom[v->id()].set(v->id());
+			}
+		bool changed = true;
+		while(changed) {
+			changed = false;
+			iters++;
+			for(auto g: coll)
+				for(auto v: *g) {
+					if(v == g->entry())
+						continue;
+					V d(n, true);
+					for(auto e: v->inEdges())
+						d.applyAnd(dom[e->source()->id()]);
+					d.set(v->id());
+					if(!d.equals(dom[v->id()])) {
+						dom[v->id()] = d;
+						changed = true;
+					}
+				}
+		}
+		return iters;
+	}
+
+	template <class V>
+	int computeReach(const CFGCollection& coll, AllocArray<V>& reach) {
+		int n = reach.count(), iters = 0;
+		for(auto g: coll)
+			for(auto v: *g) {
+				reach[v->id()] = V(n);
+				reach[v->id()].set(v->id());
+			}
+		bool changed = true;
+		while(changed) {
+			changed = false;
+			iters++;
+			for(auto g: coll)
+				for(auto v: *g)
+					for(auto e: v->outEdges()) {
+						V& r = reach[v->id()];
+						const V& s = reach[e->sink()->id()];
+						if(!r.includes(s)) {
+							r.applyOr(s);
+							changed = true;
+						}
+					}
+		}
+		return iters;
+	}
+
+};
+
+OTAWA_RUN(BitSetBench)
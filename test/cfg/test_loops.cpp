@@ -0,0 +1,233 @@
+/*
+ *	Test file for the loop-nesting forest of LOOP_INFO_FEATURE
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/data/Array.h>
+#include <elm/util/BitVector.h>
+#include <otawa/app/Application.h>
+#include <otawa/cfg.h>
+#include <otawa/cfg/features.h>
+
+using namespace elm;
+using namespace otawa;
+
+/*
+ * Check the loop information built by the loop-nesting forest against
+ * the semantics of the former data-flow builder: the body of a loop is
+ * made of the blocks reaching, without passing by the header, the source
+ * of an edge to the header that the header dominates (natural loop).
+ *
+ * For each block outside irreducible loops, the enclosing header, the depth
+ * and the exited loop of the output edges must match. For all loops,
+ * irreducible ones included, the headers must match LOOP_HEADER, the
+ * depths must follow the enclosing headers and EXIT_LIST must contain
+ * exactly the edges leaving the loop body.
+ */
+class LoopTest: public Application {
+public:
+	LoopTest(void): Application(Make("test_loops")), _headers(0), _nested(0), _irreducible(0) { }
+
+protected:
+
+	void work(const string& entry, PropList &props) override {
+		require(LOOP_INFO_FEATURE);
+		require(DOMINANCE_FEATURE);
+		DomInfo *dom = DOMINANCE_FEATURE.get(workspace());
+		for(auto g: *COLLECTED_CFG_FEATURE.get(workspace()))
+			check(g, dom);
+		cout << _headers << " loops, " << _nested << " nested, " << _irreducible << " irreducible" << io::endl;
+		cout << "loop information is consistent" << io::endl;
+	}
+
+private:
+
+	void fail(CFG *g, const string& msg) {
+		throw otawa::Exception(_ << g << ": " << msg);
+	}
+
+	void check(CFG *g, DomInfo *dom) {
+		int n = g->count();
+
+		// reachable blocks
+		BitVector reach(n);
+		Vector<Block *> todo;
+		reach.set(g->entry()->index());
+		todo.push(g->entry());
+		while(todo) {
+			Block *v = todo.pop();
+			for(auto e: v->outEdges())
+				if(!reach.bit(e->sink()->index())) {
+					reach.set(e->sink()->index());
+					todo.push(e->sink());
+				}
+		}
+
+		// headers
+		Vector<Block *> hdrs;
+		for(auto v: *g)
+			if(reach.bit(v->index())) {
+				bool header = LOOP_HEADER(v) && !v->isEntry();
+				if(header != (EXIT_LIST(v) != nullptr))
+					fail(g, _ << v << (header ? " is a header without " : " is not a header but has ") << "exit list");
+				if(header)
+					hdrs.add(v);
+			}
+		_headers += hdrs.count();
+		if(!hdrs)
+			return;
+
+		// loop bodies: reference (natural loops) and built ones
+		AllocArray<int> num(n);
+		for(int i = 0; i < n; i++)
+			num[i] = -1;
+		for(int i = 0; i < hdrs.count(); i++)
+			num[hdrs[i]->index()] = i;
+		AllocArray<BitVector> ref(hdrs.count()), body(hdrs.count());
+		BitVector irred(hdrs.count());
+		for(int i = 0; i < hdrs.count(); i++) {
+			Block *h = hdrs[i];
+			ref[i] = BitVector(n);
+			body[i] = BitVector(n);
+			ref[i].set(h->index());
+			for(auto e: h->inEdges()) {
+				Block *u = e->source();
+				if(!reach.bit(u->index()))
+					continue;
+				if(BACK_EDGE(e) && !dom->dom(h, u))
+					irred.set(i);
+				if(u != h && dom->dom(h, u) && !ref[i].bit(u->index())) {
+					ref[i].set(u->index());
+					todo.push(u);
+				}
+			}
+			while(todo) {
+				Block *v = todo.pop();
+				for(auto e: v->inEdges())
+					if(reach.bit(e->source()->index()) && !ref[i].bit(e->source()->index())) {
+						ref[i].set(e->source()->index());
+						todo.push(e->source());
+					}
+			}
+		}
+		for(auto v: *g)
+			if(reach.bit(v->index()))
+				for(Block *h = LOOP_HEADER(v) && !v->isEntry() ? v : ENCLOSING_LOOP_HEADER(v); h != nullptr; h = ENCLOSING_LOOP_HEADER(h)) {
+					if(num[h->index()] < 0)
+						fail(g, _ << v << " is enclosed by " << h << " that is not a header");
+					body[num[h->index()]].set(v->index());
+				}
+
+		// irreducible loops: entered elsewhere than by the header
+		for(int i = 0; i < hdrs.count(); i++) {
+			for(auto v: *g)
+				if(v != hdrs[i] && body[i].bit(v->index()))
+					for(auto e: v->inEdges())
+						if(reach.bit(e->source()->index()) && !body[i].bit(e->source()->index()))
+							irred.set(i);
+			if(irred.bit(i))
+				_irreducible++;
+		}
+		BitVector tainted(n);
+		for(int i = 0; i < hdrs.count(); i++)
+			if(irred.bit(i))
+				for(int j = 0; j < n; j++)
+					if(body[i].bit(j) || ref[i].bit(j))
+						tainted.set(j);
+
+		// depths follow the enclosing headers
+		for(int i = 0; i < hdrs.count(); i++) {
+			int d = depth(body, hdrs[i]);
+			Block *p = ENCLOSING_LOOP_HEADER(hdrs[i]);
+			if(d != (p == nullptr ? 1 : depth(body, p) + 1))
+				fail(g, _ << "bad depth " << d << " for " << hdrs[i]);
+			if(d > 1)
+				_nested++;
+		}
+
+		// compare with the natural loops out of irreducible loops
+		for(auto v: *g) {
+			if(!reach.bit(v->index()) || tainted.bit(v->index()))
+				continue;
+			Block *rp = nullptr;
+			int rd = 0, rs = n + 1;
+			for(int i = 0; i < hdrs.count(); i++)
+				if(ref[i].bit(v->index())) {
+					rd++;
+					if(hdrs[i] != v && ref[i].countBits() < rs) {
+						rp = hdrs[i];
+						rs = ref[i].countBits();
+					}
+				}
+			if(ENCLOSING_LOOP_HEADER(v) != rp)
+				fail(g, _ << "enclosing header of " << v << " is " << ENCLOSING_LOOP_HEADER(v) << " instead of " << rp);
+			if(depth(body, v) != rd)
+				fail(g, _ << "depth of " << v << " is " << depth(body, v) << " instead of " << rd);
+			for(auto e: v->outEdges())
+				if(!tainted.bit(e->sink()->index()) && LOOP_EXIT(e) != exited(ref, hdrs, e))
+					fail(g, _ << "exit of " << e << " is " << LOOP_EXIT(e) << " instead of " << exited(ref, hdrs, e));
+		}
+
+		// exit edges match the built loop bodies
+		AllocArray<int> exits(hdrs.count());
+		for(int i = 0; i < hdrs.count(); i++)
+			exits[i] = 0;
+		for(auto v: *g)
+			if(reach.bit(v->index()))
+				for(auto e: v->outEdges()) {
+					Block *h = exited(body, hdrs, e);
+					if(LOOP_EXIT(e) != h)
+						fail(g, _ << "exit of " << e << " is " << LOOP_EXIT(e) << " instead of " << h);
+					if(h != nullptr)
+						exits[num[h->index()]]++;
+				}
+		for(int i = 0; i < hdrs.count(); i++) {
+			Vector<Edge *> *l = EXIT_LIST(hdrs[i]);
+			if(l->count() != exits[i])
+				fail(g, _ << "exit list of " << hdrs[i] << " has " << l->count() << " edges instead of " << exits[i]);
+			for(auto e: *l)
+				if(LOOP_EXIT(e) != hdrs[i])
+					fail(g, _ << e << " in exit list of " << hdrs[i] << " does not exit it");
+		}
+	}
+
+	int depth(AllocArray<BitVector>& bodies, Block *v) {
+		int d = 0;
+		for(int i = 0; i < bodies.count(); i++)
+			if(bodies[i].bit(v->index()))
+				d++;
+		return d;
+	}
+
+	Block *exited(AllocArray<BitVector>& bodies, Vector<Block *>& hdrs, Edge *e) {
+		Block *h = nullptr;
+		int s = -1;
+		for(int i = 0; i < bodies.count(); i++)
+			if(bodies[i].bit(e->source()->index()) && !bodies[i].bit(e->sink()->index())
+			&& bodies[i].countBits() > s) {
+				h = hdrs[i];
+				s = bodies[i].countBits();
+			}
+		return h;
+	}
+
+	int _headers, _nested, _irreducible;
+};
+
+OTAWA_RUN(LoopTest)
@@ -0,0 +1,195 @@
+/*
+ *	Test file for CFGPatcher
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/avl/Set.h>
+#include <elm/data/HashMap.h>
+#include <otawa/app/Application.h>
+#include <otawa/cfg.h>
+#include <otawa/cfg/CFGPatcher.h>
+#include <otawa/cfg/features.h>
+#include <otawa/flowfact/features.h>
+#include <otawa/prog/WorkSpace.h>
+
+using namespace elm;
+using namespace otawa;
+
+/*
+ * Add a target to the first indirect branch (or, if there is none, to the
+ * first indirect call) of the CFG collection, patch the collection with
+ * CFGPatcher and check that:
+ * @li the kept CFGs are the same objects and their blocks and edges keep
+ *		their identifiers,
+ * @li the calls are linked to the CFGs of the new collection and
+ *		the callers of these CFGs belong to the new collection,
+ * @li the patched collection has the same structure as the one rebuilt
+ *		from scratch by CFGCollector.
+ */
+class PatchTest: public Application {
+public:
+	PatchTest(void): Application(Make("test_patch")) { }
+
+protected:
+
+	void work(const string& entry, PropList &props) override {
+		require(COLLECTED_CFG_FEATURE);
+		const CFGCollection *coll = COLLECTED_CFG_FEATURE.get(workspace());
+
+		// look for an indirect control
+		BasicBlock *bb = findIndirect(*coll, false);
+		if(bb == nullptr)
+			bb = findIndirect(*coll, true);
+		if(bb == nullptr)
+			throw otawa::Exception("no indirect control to patch");
+		Inst *control = bb->control();
+		if(!control->isCall()) {
+			BRANCH_TARGET(control).add(bb->cfg()->address());
+			cout << "branch target " << bb->cfg()->address() << " added to " << control->address() << io::endl;
+		}
+		else {
+			CFG *callee = coll->get(coll->count() - 1);
+			CALL_TARGET(control).add(callee->address());
+			cout << "call target " << callee->address() << " added to " << control->address() << io::endl;
+		}
+
+		// record the identifiers of the kept CFGs
+		HashMap<CFG *, string> kept;
+		for(auto g: *coll)
+			if(!CFGPatcher::isStale(workspace(), g))
+				kept.put(g, ids(g));
+		if(kept.count() == coll->count())
+			throw otawa::Exception("the patched CFG is not detected as stale");
+
+		// patch the collection
+		workspace()->run<CFGPatcher>(props);
+		coll = COLLECTED_CFG_FEATURE.get(workspace());
+		cout << kept.count() << " CFG(s) kept, " << (coll->count() - kept.count()) << " rebuilt or added" << io::endl;
+
+		// check the kept CFGs
+		for(HashMap<CFG *, string>::PairIter p(kept); p(); p++) {
+			CFG *g = (*p).fst;
+			if(g->index() >= coll->count() || coll->get(g->index()) != g)
+				throw otawa::Exception(_ << "kept CFG " << g << " not in the patched collection");
+			if(ids(g) != (*p).snd)
+				throw otawa::Exception(_ << "identifiers of " << g << " changed");
+		}
+
+		// check the links between callers and callees
+		for(auto g: *coll) {
+			for(auto v: *g)
+				if(v->isCall() && v->toSynth()->callee() != nullptr) {
+					CFG *c = v->toSynth()->callee();
+					if(c->index() >= coll->count() || coll->get(c->index()) != c)
+						throw otawa::Exception(_ << v << " in " << g << " calls a CFG out of the collection");
+					bool found = false;
+					for(auto caller: c->callers())
+						if(caller == v) {
+							found = true;
+							break;
+						}
+					if(!found)
+						throw otawa::Exception(_ << v << " in " << g << " not recorded as caller of " << c);
+				}
+			for(auto caller: g->callers()) {
+				CFG *c = caller->cfg();
+				if(c->index() >= coll->count() || coll->get(c->index()) != c || caller->callee() != g)
+					throw otawa::Exception(_ << "caller " << caller << " of " << g << " out of the collection");
+			}
+		}
+
+		// compare with a full rebuild
+		avl::Set<string> patched;
+		dump(*coll, patched);
+		workspace()->invalidate(COLLECTED_CFG_FEATURE);
+		require(COLLECTED_CFG_FEATURE);
+		avl::Set<string> rebuilt;
+		dump(*COLLECTED_CFG_FEATURE.get(workspace()), rebuilt);
+		if(patched.count() != rebuilt.count())
+			throw otawa::Exception(_ << "patched collection has " << patched.count()
+				<< " items while rebuilt one has " << rebuilt.count());
+		for(avl::Set<string>::Iter s(patched); s(); s++)
+			if(!rebuilt.contains(*s))
+				throw otawa::Exception(_ << "patched collection differs from rebuilt one at " << *s);
+		cout << "patched collection is identical to rebuilt one" << io::endl;
+	}
+
+private:
+
+	BasicBlock *findIndirect(const CFGCollection& coll, bool call) {
+		for(auto g: coll)
+			for(auto v: *g) {
+				if(!v->isBasic())
+					continue;
+				Inst *i = v->toBasic()->control();
+				if(i != nullptr && i->target() == nullptr && i->isCall() == call
+				&& !i->isReturn() && !IS_RETURN(i) && !IGNORE_CONTROL(i))
+					return v->toBasic();
+			}
+		return nullptr;
+	}
+
+	string ids(CFG *g) {
+		StringBuffer buf;
+		for(auto v: *g) {
+			buf << v->id() << ':' << v << '\n';
+			for(auto e: v->outEdges())
+				buf << '\t' << e->id() << ':' << e->sink() << '\n';
+		}
+		return buf.toString();
+	}
+
+	string name(Block *v) {
+		if(v->isEntry())
+			return "entry";
+		else if(v->isExit())
+			return "exit";
+		else if(v->isUnknown())
+			return "unknown";
+		else if(v->isPhony())
+			return "phony";
+		else if(v->isCall()) {
+			CFG *c = v->toSynth()->callee();
+			return _ << "call " << v->toSynth()->address() << " to " << (c == nullptr ? string("?") : string(_ << c->address()));
+		}
+		else
+			return _ << "bb " << v->address() << "-" << v->toBasic()->topAddress();
+	}
+
+	void add(avl::Set<string>& set, const string& s) {
+		string r = s;
+		for(int i = 2; set.contains(r); i++)
+			r = _ << s << " #" << i;
+		set.add(r);
+	}
+
+	void dump(const CFGCollection& coll, avl::Set<string>& set) {
+		for(auto g: coll) {
+			add(set, _ << g->address() << " cfg " << g->count() << " blocks, " << g->callCount() << " callers");
+			for(auto v: *g) {
+				add(set, _ << g->address() << " " << name(v));
+				for(auto e: v->outEdges())
+					add(set, _ << g->address() << " " << name(v) << " -> " << name(e->sink()) << " " << e->flags());
+			}
+		}
+	}
+
+};
+
+OTAWA_RUN(PatchTest)
@@ -0,0 +1,116 @@
+/*
+ *	Test file for CFG snapshots
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/avl/Set.h>
+#include <elm/sys/System.h>
+#include <otawa/app/Application.h>
+#include <otawa/cfg.h>
+#include <otawa/cfg/features.h>
+#include <otawa/cfgio/Snapshot.h>
+#include <otawa/prog/WorkSpace.h>
+
+using namespace elm;
+using namespace otawa;
+
+/*
+ * Save the CFG collection of a program as a snapshot, load it back and
+ * check that the loaded CFGs have the same blocks, edges and calls as
+ * the saved ones, in the same order.
+ */
+class SnapshotTest: public Application {
+public:
+	SnapshotTest(void): Application(Make("test_snapshot")) { }
+
+protected:
+
+	void work(const string& entry, PropList &props) override {
+		require(COLLECTED_CFG_FEATURE);
+		const CFGCollection *coll = COLLECTED_CFG_FEATURE.get(workspace());
+
+		// save the snapshot
+		sys::Path path = _ << "test_snapshot-" << sys::Path(workspace()->process()->program()->name()).namePart() << ".cfgs";
+		io::OutStream *out = sys::System::createFile(path);
+		cfgio::Snapshot::save(*coll, out, avl::Set<const AbstractIdentifier *>());
+		delete out;
+		if(!cfgio::Snapshot::isSnapshot(path))
+			throw otawa::Exception(_ << path << " not recognized as a snapshot");
+
+		// load it back
+		CFGCollection *loaded = cfgio::Snapshot::load(workspace(), path, *this);
+		path.remove();
+		cout << coll->count() << " CFG(s), " << coll->countBlocks() << " blocks, "
+			 << coll->countEdges() << " edges saved" << io::endl;
+
+		// compare
+		if(loaded->count() != coll->count())
+			throw otawa::Exception(_ << loaded->count() << " CFG(s) loaded instead of " << coll->count());
+		for(int i = 0; i < coll->count(); i++) {
+			CFG *g = coll->get(i), *h = loaded->get(i);
+			if(g->address() != h->address())
+				throw otawa::Exception(_ << "CFG " << i << " at " << h->address() << " instead of " << g->address());
+			if(g->count() != h->count() || g->countEdges() != h->countEdges())
+				throw otawa::Exception(_ << "CFG " << g << " has " << h->count() << " blocks and " << h->countEdges()
+					<< " edges instead of " << g->count() << " and " << g->countEdges());
+			avl::Set<string> saved, reloaded;
+			dump(g, saved);
+			dump(h, reloaded);
+			if(saved.count() != reloaded.count())
+				throw otawa::Exception(_ << "CFG " << g << " differs after reload");
+			for(avl::Set<string>::Iter s(saved); s(); s++)
+				if(!reloaded.contains(*s))
+					throw otawa::Exception(_ << "CFG " << g << " differs after reload at " << *s);
+		}
+		cout << "loaded snapshot is identical" << io::endl;
+
+		for(auto g: *loaded)
+			delete g;
+		delete loaded;
+	}
+
+private:
+
+	string name(Block *v) {
+		if(v->isEntry())
+			return "entry";
+		else if(v->isExit())
+			return "exit";
+		else if(v->isUnknown())
+			return "unknown";
+		else if(v->isCall()) {
+			CFG *c = v->toSynth()->callee();
+			return _ << v->index() << ": call " << (c == nullptr ? string("?") : string(_ << c->index() << "@" << c->address()));
+		}
+		else
+			return _ << v->index() << ": bb " << v->address() << "-" << v->toBasic()->topAddress()
+				<< " (" << v->toBasic()->count() << " instructions)";
+	}
+
+	void dump(CFG *g, avl::Set<string>& set) {
+		for(auto v: *g) {
+			set.add(name(v));
+			for(auto e: v->outEdges())
+				set.add(_ << name(v) << " -> " << name(e->sink()) << " " << e->flags());
+		}
+	}
+
+};
+
+OTAWA_RUN(SnapshotTest)
@@ -0,0 +1,168 @@
+/*
+ *	Test of the incremental interface of ilp::AbstractSystem
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/data/HashMap.h>
+#include <elm/test.h>
+#include <otawa/ilp/AbstractSystem.h>
+#include <otawa/proc/Monitor.h>
+
+using namespace elm;
+using namespace otawa;
+
+// maximizing system solved by enumeration of the variables in [0, MAX]
+class TestSystem: public ilp::AbstractSystem {
+public:
+	static const int MAX = 10;
+
+	TestSystem(void): _val(0), _solves(0) { }
+	inline int solves(void) const { return _solves; }
+
+	bool solve(WorkSpace *ws) override {
+		_solves++;
+		Vector<ilp::Var *> vs;
+		for(VarIter v(this); v(); v++)
+			vs.add(*v);
+		Vector<int> cur(vs.length());
+		for(int i = 0; i < vs.length(); i++)
+			cur.add(0);
+		bool found = false;
+		while(true) {
+			for(int i = 0; i < vs.length(); i++)
+				vals.put(vs[i], cur[i]);
+			if(satisfied()) {
+				double v = objective();
+				if(!found || v > _val) {
+					found = true;
+					_val = v;
+					for(int i = 0; i < vs.length(); i++)
+						sol.put(vs[i], cur[i]);
+				}
+			}
+			int i = 0;
+			while(i < vs.length() && cur[i] == MAX)
+				cur[i++] = 0;
+			if(i == vs.length())
+				break;
+			cur[i]++;
+		}
+		return found;
+	}
+
+	double valueOf(ilp::Var *var) override { return sol.get(var, 0); }
+	double value(void) override { return _val; }
+
+private:
+
+	double eval(ilp::Constraint *c) {
+		double r = 0;
+		for(ilp::Constraint::TermIterator t(c); t(); t++)
+			r += (*t).snd * vals.get((*t).fst, 0);
+		return r;
+	}
+
+	double objective(void) {
+		double r = 0;
+		for(ObjTermIterator t(this); t(); t++)
+			r += (*t).snd * ((*t).fst == nullptr ? 1 : vals.get((*t).fst, 0));
+		return r;
+	}
+
+	bool satisfied(void) {
+		for(ConstIterator c(this); c(); c++) {
+			double l = eval(*c), r = (*c)->constant();
+			switch((*c)->comparator()) {
+			case ilp::Constraint::LT:	if(!(l < r)) return false; break;
+			case ilp::Constraint::LE:	if(!(l <= r)) return false; break;
+			case ilp::Constraint::EQ:	if(!(l == r)) return false; break;
+			case ilp::Constraint::GE:	if(!(l >= r)) return false; break;
+			case ilp::Constraint::GT:	if(!(l > r)) return false; break;
+			default:					return false;
+			}
+		}
+		return true;
+	}
+
+	HashMap<ilp::Var *, double> vals, sol;
+	double _val;
+	int _solves;
+};
+
+int main(void) {
+
+CHECK_BEGIN("otawa_ilp")
+
+	// max 2x + 3y with x + y <= 4, x <= 3, y <= 3
+	TestSystem sys;
+	ilp::Var *x = sys.newVar("x"), *y = sys.newVar("y");
+	sys.addObjectFunction(2, x);
+	sys.addObjectFunction(3, y);
+	ilp::Constraint *c1 = sys.newConstraint("c1", ilp::Constraint::LE, 4);
+	c1->add(1, x);
+	c1->add(1, y);
+	ilp::Term tx(x), ty(y);
+	ilp::Constraint *c2 = sys.addRow(&tx, 1, ilp::Constraint::LE, 3, "c2");
+	ilp::Constraint *c3 = sys.addRow(&ty, 1, ilp::Constraint::LE, 3, "c3");
+	CHECK(sys.solve(nullptr));
+	CHECK_EQUAL(sys.value(), 11.);
+	CHECK_EQUAL(sys.valueOf(x), 1.);
+	CHECK_EQUAL(sys.valueOf(y), 3.);
+
+	// no incremental solver: resolve() is a full solve
+	CHECK(!sys.isIncremental());
+	CHECK(sys.resolve(nullptr, Monitor::null));
+	CHECK_EQUAL(sys.solves(), 2);
+	CHECK_EQUAL(sys.value(), 11.);
+
+	// modify and resolve
+	CHECK(sys.snapshot());
+	sys.setConstant(c1, 6);
+	CHECK(sys.resolve(nullptr, Monitor::null));
+	CHECK_EQUAL(sys.value(), 15.);
+	CHECK(sys.snapshot());
+	sys.setCoefficient(c3, y, 2);
+	sys.setCoefficient(c1, x, 3);
+	sys.setObjectCoefficient(x, 5);
+	CHECK_EQUAL(c3->coefficient(y), 2.);
+	CHECK_EQUAL(c1->coefficient(x), 3.);
+	CHECK(sys.resolve(nullptr, Monitor::null));
+	CHECK_EQUAL(sys.valueOf(x), 2.);
+	CHECK_EQUAL(sys.valueOf(y), 0.);
+	CHECK_EQUAL(sys.value(), 10.);
+
+	// restore the nested snapshot
+	sys.restore();
+	CHECK_EQUAL(c3->coefficient(y), 1.);
+	CHECK_EQUAL(c1->coefficient(x), 1.);
+	CHECK_EQUAL(c1->constant(), 6.);
+	CHECK(sys.resolve(nullptr, Monitor::null));
+	CHECK_EQUAL(sys.value(), 15.);
+
+	// restore the original system
+	sys.restore();
+	CHECK_EQUAL(c1->constant(), 4.);
+	CHECK_EQUAL(c2->coefficient(x), 1.);
+	CHECK(sys.resolve(nullptr, Monitor::null));
+	CHECK_EQUAL(sys.value(), 11.);
+	CHECK_EQUAL(sys.valueOf(x), 1.);
+	CHECK_EQUAL(sys.valueOf(y), 3.);
+
+CHECK_RETURN
+}
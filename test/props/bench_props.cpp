@@ -0,0 +1,122 @@
+/*
+ *	PropList lookup benchmark
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/data/Vector.h>
+#include <elm/io.h>
+#include <elm/sys/StopWatch.h>
+#include <otawa/app/Application.h>
+#include <otawa/cfg/features.h>
+#include <otawa/prog/Inst.h>
+#include <otawa/prog/WorkSpace.h>
+#include "../../include/otawa/prop.h"
+
+using namespace elm;
+using namespace otawa;
+
+/*
+ * Measure the time of property retrieval, first according to the length of
+ * synthetic property lists, then on the property lists of the blocks, edges
+ * and instructions of the given program after the loop analyses.
+ * To compare the list and the hashed version of property lists, run it on
+ * OTAWA built with and without OTAWA_PROP_HASH.
+ */
+
+const int MAX = 64, LOOKUPS = 10000000;
+
+class BenchProps: public Application {
+public:
+	BenchProps(void): Application(Make("bench_props")) { }
+
+protected:
+
+	void work(const string& entry, PropList &props) override {
+		synthetic();
+		program();
+	}
+
+private:
+
+	void synthetic(void) {
+		Identifier<int> *ids[MAX];
+		for(int i = 0; i < MAX; i++)
+			ids[i] = new Identifier<int>("", i);
+
+		for(int n = 1; n <= MAX; n *= 2) {
+			PropList props;
+			for(int i = 0; i < n; i++)
+				(*ids[i])(props) = i;
+
+			// lookup with a stride to defeat the move-to-front of the list version
+			sys::StopWatch sw;
+			int sum = 0;
+			sw.start();
+			for(int i = 0, j = 0; i < LOOKUPS; i++, j = (j + 7) % n)
+				sum += (*ids[j])(props);
+			sw.stop();
+			cout << "length " << n << ": "
+				 << (double(sw.delay().micros()) * 1000 / LOOKUPS) << "ns/lookup"
+				 << " (" << sum << ")" << io::endl;
+		}
+
+		for(int i = 0; i < MAX; i++)
+			delete ids[i];
+	}
+
+	void program(void) {
+		require(LOOP_INFO_FEATURE);
+
+		// collect the (list, identifier) pairs of the program
+		Vector<Pair<const PropList *, const AbstractIdentifier *> > looks;
+		for(auto g: *COLLECTED_CFG_FEATURE.get(workspace()))
+			for(auto v: *g) {
+				collect(*v, looks);
+				for(auto e: v->outEdges())
+					collect(*e, looks);
+				if(v->isBasic())
+					for(auto i: *v->toBasic())
+						collect(*i, looks);
+			}
+		if(!looks) {
+			cout << "program: no property" << io::endl;
+			return;
+		}
+
+		// lookup all pairs in turn
+		sys::StopWatch sw;
+		int found = 0;
+		sw.start();
+		for(int i = 0, j = 0; i < LOOKUPS; i++, j = (j + 1) % looks.length())
+			if(looks[j].fst->getProp(looks[j].snd) != nullptr)
+				found++;
+		sw.stop();
+		cout << "program: " << looks.length() << " properties: "
+			 << (double(sw.delay().micros()) * 1000 / LOOKUPS) << "ns/lookup"
+			 << " (" << found << ")" << io::endl;
+	}
+
+	static void collect(const PropList& props, Vector<Pair<const PropList *, const AbstractIdentifier *> >& looks) {
+		for(PropList::Iter p(props); p(); p++)
+			looks.add(pair(&props, p->id()));
+	}
+
+};
+
+OTAWA_RUN(BenchProps)
@@ -229,5 +229,67 @@ CHECK_BEGIN("otawa_props")
 		CHECK(set.isFull());
 	}
 
+	// long lists (indexed if OTAWA_PROP_HASH is enabled)
+	{
+		const int N = 32;
+		Identifier<int> *ids[N];
+		for(int i = 0; i < N; i++)
+			ids[i] = new Identifier<int>("", -1);
+		PropList props;
+
+		// set and get
+		for(int i = 0; i < N; i++)
+			(*ids[i])(props) = i;
+		bool ok = true;
+		for(int i = 0; i < N; i++)
+			if((*ids[i])(props) != i)
+				ok = false;
+		CHECK(ok);
+
+		// set again
+		for(int i = 0; i < N; i += 2)
+			props.setProp(GenericProperty<int>::make(ids[i], 2 * i));
+		ok = true;
+		for(int i = 0; i < N; i++)
+			if((*ids[i])(props) != (i % 2 == 0 ? 2 * i : i))
+				ok = false;
+		CHECK(ok);
+		int cnt = 0;
+		for(PropList::Iter prop(props); prop(); prop++)
+			cnt++;
+		CHECK_EQUAL(cnt, N);
+
+		// multiple values
+		ids[1]->add(props, 100);
+		ids[1]->add(props, 101);
+		CHECK_EQUAL(int((*ids[1])(props)), 101);
+		props.removeProp(ids[1]);
+		CHECK_EQUAL(int((*ids[1])(props)), 100);
+		Property *prop = props.extractProp(ids[1]);
+		CHECK(prop != nullptr);
+		CHECK_EQUAL(int((*ids[1])(props)), 1);
+		props.addProp(prop);
+		CHECK_EQUAL(int((*ids[1])(props)), 100);
+		ids[3]->add(props, 300);
+		props.removeAllProp(ids[3]);
+		CHECK(!props.hasProp(*ids[3]));
+		ids[3]->add(props, 3);
+		CHECK_EQUAL(int((*ids[3])(props)), 3);
+
+		// copy and move
+		PropList copy(props);
+		CHECK_EQUAL(int((*ids[N - 1])(copy)), N - 1);
+		PropList moved;
+		moved.takeProps(copy);
+		CHECK(!copy.hasProp(*ids[0]));
+		CHECK_EQUAL(int((*ids[N - 1])(moved)), N - 1);
+		moved.clearProps();
+		CHECK(!moved.hasProp(*ids[N - 1]));
+
+		props.clearProps();
+		for(int i = 0; i < N; i++)
+			delete ids[i];
+	}
+
 CHECK_RETURN
 }